@@ -0,0 +1,57 @@
+/**
+ * @file bench_adjacency.cpp
+ * @brief Benchmark of the face adjacency, boundary surface and vertex-to-cell
+ * index construction against thread count
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_adjacency [grid size]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "benchutil.h"
+#include "model.h"
+#include "parallel.h"
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 100;
+    std::string filename = "bench_adjacency.mod";
+    writeHexGridModel(filename, gridSize);
+    Model mod(filename, 0);
+    std::printf("Model: %d cells\n", mod.getCellCount());
+
+    long long bytes = 9LL * sizeof(int) * mod.getCellCount();
+    long long checksum = 0;
+    for (int threadCount = 1; threadCount <= resolveThreadCount(0); threadCount *= 2)
+    {
+        BenchTimer timer;
+        FaceAdjacency adjacency = mod.getFaceAdjacency(threadCount);
+        printThroughput(std::to_string(threadCount) + " threads", timer.seconds(), bytes);
+        std::printf("  %d faces, %d on the boundary\n", adjacency.getFaceCount(), adjacency.getBoundaryFaceCount());
+        checksum += adjacency.getBoundaryFaceCount();
+
+        // Includes a second adjacency build
+        timer.reset();
+        BoundarySurface surface = mod.getBoundarySurface(threadCount);
+        printThroughput(std::to_string(threadCount) + " threads, surface", timer.seconds(), bytes);
+        std::printf("  %d faces, area %g\n", surface.getFaceCount(), surface.getArea());
+        checksum += surface.getFaceCount();
+    }
+    for (int threadCount = 1; threadCount <= resolveThreadCount(0); threadCount *= 2)
+    {
+        // The index is cached, so each run needs a model of its own
+        Model fresh(filename, 0);
+        BenchTimer timer;
+        const VertexCellIndex &index = fresh.getVertexCellIndex(threadCount);
+        printThroughput(std::to_string(threadCount) + " threads, vertex index", timer.seconds(), bytes);
+        checksum += index.getEntryCount();
+    }
+    std::printf("checksum %lld\n", checksum);
+
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bench_arena.cpp
+ * @brief Benchmark of loading a model with the original loader, and with the
+ * current loader on heap and arena storage
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_arena [grid size] [thread count]
+ *
+ * The baseline is the original getline/stoi loader (referenceparser.h),
+ * which builds a std::vector<Cell>. The current loader runs with heap
+ * storage (no arena) and with a caller-owned arena. Each variant runs in
+ * its own child process so that its peak resident set size is measured on
+ * its own (POSIX only). The reference loader is single-threaded, so the
+ * thread count only applies to the other two.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "benchutil.h"
+#include "model.h"
+#include "referenceparser.h"
+
+// Count every operator new call of the program. Every scalar and array
+// form is replaced, so that each pointer is freed by the same pair of
+// functions that allocated it. The functions are kept out of line so
+// that the compiler does not match a malloc inlined on one side against
+// a free on the other.
+static std::atomic<long> allocationCount(0);
+
+__attribute__((noinline)) static void *countedAllocate(std::size_t size)
+{
+    allocationCount++;
+    void *pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+__attribute__((noinline)) static void countedFree(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void *operator new(std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    countedFree(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    countedFree(pointer);
+}
+
+// Loaders compared, in the order they are run
+enum Variant
+{
+    REFERENCE,
+    HEAP,
+    ARENA
+};
+
+static const char *VARIANT_NAMES[] = {"reference", "heap", "arena"};
+
+// Load the model once with variant, and print one result line
+static void runVariant(const std::string &filename, int threadCount, Variant variant)
+{
+    Arena arena;
+    long allocationsBefore = allocationCount;
+    BenchTimer timer;
+
+    ReferenceParser *reference = nullptr;
+    Model *model = nullptr;
+    int cellCount;
+    if (variant == REFERENCE)
+    {
+        reference = new ReferenceParser();
+        reference->parse(filename);
+        cellCount = reference->cells.size();
+    }
+    else
+    {
+        model = new Model(filename, threadCount, variant == ARENA ? &arena : nullptr);
+        cellCount = model->getCellCount();
+    }
+    double loadSeconds = timer.seconds();
+    long allocations = allocationCount - allocationsBefore;
+
+    // Free the model, for the arena variant in one shot
+    timer.reset();
+    delete reference;
+    delete model;
+    arena.release();
+    double freeSeconds = timer.seconds();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("%-10s %8d cells %10.3f s load %10.4f s free %10ld allocations %10.1f MB peak RSS\n",
+                VARIANT_NAMES[variant], cellCount, loadSeconds, freeSeconds, allocations, usage.ru_maxrss / 1024.0);
+}
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 60;
+    int threadCount = argc > 2 ? std::atoi(argv[2]) : 1;
+    std::string filename = "bench_arena.mod";
+
+    long long bytes = writeHexGridModel(filename, gridSize);
+    std::printf("Model: %d cells (%.1f MB as text), %d thread(s)\n", gridSize * gridSize * gridSize, bytes / 1e6, threadCount);
+
+    for (int variant = REFERENCE; variant <= ARENA; variant++)
+    {
+        std::fflush(stdout);
+        pid_t child = fork();
+        if (child == 0)
+        {
+            runVariant(filename, threadCount, (Variant)variant);
+            std::fflush(stdout);
+            _exit(0);
+        }
+        waitpid(child, nullptr, 0);
+    }
+
+    std::remove(filename.c_str());
+    return 0;
+}
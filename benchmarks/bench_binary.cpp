@@ -0,0 +1,47 @@
+/**
+ * @file bench_binary.cpp
+ * @brief Benchmark of opening a model as ASCII .mod against binary .modb
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_binary [grid size]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "benchutil.h"
+#include "modbinary.h"
+#include "model.h"
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 60;
+    std::string textFilename = "bench_binary.mod";
+    std::string binaryFilename = "bench_binary.modb";
+
+    long long bytes = writeHexGridModel(textFilename, gridSize);
+    std::printf("Model: %d cells (%.1f MB as text)\n", gridSize * gridSize * gridSize, bytes / 1e6);
+
+    BenchTimer timer;
+    Model text(textFilename);
+    std::printf("%-28s %10.3f s\n", "Model, ASCII .mod", timer.seconds());
+
+    timer.reset();
+    convertModToBinary(textFilename, binaryFilename, 1);
+    std::printf("%-28s %10.3f s\n", "convert to .modb", timer.seconds());
+
+    timer.reset();
+    ModBinaryFile view(binaryFilename);
+    double viewSeconds = timer.seconds();
+    std::printf("%-28s %10.6f s (%zu cells)\n", "ModBinaryFile (mmap view)", viewSeconds, view.getCellCount());
+
+    timer.reset();
+    Model binary(binaryFilename);
+    std::printf("%-28s %10.3f s\n", "Model, binary .modb", timer.seconds());
+
+    std::remove(textFilename.c_str());
+    std::remove(binaryFilename.c_str());
+    return binary.getCellCount() == text.getCellCount() ? 0 : 1;
+}
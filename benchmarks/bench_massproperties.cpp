@@ -0,0 +1,41 @@
+/**
+ * @file bench_massproperties.cpp
+ * @brief Benchmark of the whole-model mass properties and inertia against thread count
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_massproperties [grid size]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "benchutil.h"
+#include "model.h"
+#include "parallel.h"
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 100;
+    std::string filename = "bench_massproperties.mod";
+    writeHexGridModel(filename, gridSize);
+    Model mod(filename, 0);
+    std::printf("Model: %d cells\n", mod.getCellCount());
+
+    long long bytes = mod.getVertexStore().getMemorySize() + 9LL * sizeof(int) * mod.getCellCount();
+    double checksum = 0;
+    for (int threadCount = 1; threadCount <= resolveThreadCount(0); threadCount *= 2)
+    {
+        BenchTimer timer;
+        MassProperties properties = mod.getMassProperties(threadCount);
+        printThroughput(std::to_string(threadCount) + " threads", timer.seconds(), bytes);
+        std::printf("  mass %.17g, centre of gravity x %.17g, largest principal moment %.17g\n", properties.mass,
+                    properties.centreOfGravity.getX(), properties.principalMoments.getZ());
+        checksum += properties.volume;
+    }
+    std::printf("checksum %g\n", checksum);
+
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file bench_parse.cpp
+ * @brief Benchmark of .mod parsing throughput: getline/stoi reference
+ * parser against the memory-mapped Model loader, serial and parallel
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_parse [grid size] [model file]
+ * Without a model file, a synthetic hexahedral grid is generated.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "benchutil.h"
+#include "model.h"
+#include "referenceparser.h"
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 60;
+    std::string filename = argc > 2 ? argv[2] : "bench_parse.mod";
+    bool generated = argc <= 2;
+
+    if (generated)
+    {
+        writeHexGridModel(filename, gridSize);
+    }
+
+    std::ifstream sizeProbe(filename, std::ios::binary | std::ios::ate);
+    long long bytes = (long long)sizeProbe.tellg();
+    std::printf("Model: %s (%.1f MB)\n", filename.c_str(), bytes / 1e6);
+
+    BenchTimer timer;
+    ReferenceParser reference;
+    reference.parse(filename);
+    printThroughput("getline/stoi (reference)", timer.seconds(), bytes);
+
+    timer.reset();
+    Model model(filename);
+    printThroughput("mmap/in-place (Model)", timer.seconds(), bytes);
+
+    if (model.getCellCount() != reference.cells.size() || model.getVertexCount() != reference.vertices.size())
+    {
+        std::printf("Mismatch: %d/%d cells, %d/%d vertices\n", model.getCellCount(), (int)reference.cells.size(),
+                    model.getVertexCount(), (int)reference.vertices.size());
+        return 1;
+    }
+
+    // Parallel loads, doubling the thread count up to the hardware limit
+    int maxThreads = std::thread::hardware_concurrency();
+    for (int threads = 2; threads <= std::max(maxThreads, 2); threads *= 2)
+    {
+        timer.reset();
+        Model parallelModel(filename, threads);
+        printThroughput("mmap/in-place, " + std::to_string(threads) + " threads", timer.seconds(), bytes);
+    }
+
+    if (generated)
+    {
+        std::remove(filename.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file bench_precision.cpp
+ * @brief Benchmark of memory use and throughput of double against single-precision models
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_precision [grid size]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchutil.h"
+#include "model.h"
+
+// Time the whole-model passes of one model and return a checksum
+static double runPasses(const char *name, Model &mod)
+{
+    std::string label(name);
+    std::printf("%-28s %10.1f MB of coordinates\n", label.c_str(), mod.getVertexStore().getMemorySize() / 1e6);
+    long long bytes = mod.getVertexStore().getMemorySize();
+
+    Vector3D min, max;
+    BenchTimer timer;
+    mod.getBounds(min, max);
+    printThroughput(label + ", bounds", timer.seconds(), bytes);
+
+    timer.reset();
+    Vector3D centre = mod.getCentre();
+    printThroughput(label + ", centroid", timer.seconds(), bytes);
+
+    timer.reset();
+    std::vector<double> volumes = mod.getCellVolumes();
+    printThroughput(label + ", cell volumes", timer.seconds(), bytes);
+
+    timer.reset();
+    std::vector<Vector3D> centres = mod.getCellCentres();
+    printThroughput(label + ", cell centres", timer.seconds(), bytes);
+
+    return max.getX() + centre.getX() + volumes[0] + centres[0].getX();
+}
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 80;
+    std::string filename = "bench_precision.mod";
+    writeHexGridModel(filename, gridSize);
+    std::printf("Model: %d cells\n", gridSize * gridSize * gridSize);
+
+    Model doubles(filename, 0, nullptr, Precision::Double);
+    Model singles(filename, 0, nullptr, Precision::Single);
+    double doubleSum = runPasses("double", doubles);
+    double singleSum = runPasses("single", singles);
+    std::printf("checksum %g/%g\n", doubleSum, singleSum);
+
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bench_stl.cpp
+ * @brief Benchmark of STL loading: per-triangle stream reads into a
+ * triangle soup, and vtkSTLReader when built with VTK, against the
+ * memory-mapped, welding Model loader
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_stl [grid size] [STL file]
+ * Without a STL file, a binary STL of a tessellated n x n height field is
+ * generated (2 * n * n triangles, every interior vertex shared by six).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchutil.h"
+#include "model.h"
+#include "vector3d.h"
+
+#ifdef BENCH_WITH_VTK
+#include <vtkPolyData.h>
+#include <vtkSTLReader.h>
+#include <vtkSmartPointer.h>
+#endif
+
+/**
+ * Write a binary STL height field, returns the size of the file in bytes
+ */
+static long long writeHeightFieldStl(const std::string &filename, int n)
+{
+    std::ofstream out(filename, std::ios::binary);
+    char header[80] = "bench_stl height field";
+    std::uint32_t count = 2 * n * n;
+    out.write(header, sizeof(header));
+    out.write((const char *)&count, sizeof(count));
+
+    std::vector<char> record(50, 0);
+    for (int j = 0; j < n; j++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            float corners[4][3];
+            for (int c = 0; c < 4; c++)
+            {
+                float x = (float)(i + (c & 1));
+                float y = (float)(j + (c >> 1));
+                corners[c][0] = x;
+                corners[c][1] = y;
+                corners[c][2] = std::sin(x * 0.05f) * std::cos(y * 0.05f);
+            }
+            const int split[2][3] = {{0, 1, 3}, {0, 3, 2}};
+            for (int t = 0; t < 2; t++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    std::copy((const char *)corners[split[t][c]], (const char *)corners[split[t][c]] + 12,
+                              &record[12 + 12 * c]);
+                }
+                out.write(record.data(), record.size());
+            }
+        }
+    }
+    return (long long)out.tellp();
+}
+
+/**
+ * Straightforward reader: one stream read per triangle, no welding
+ */
+static std::vector<Vector3D> readSoup(const std::string &filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    char header[80];
+    std::uint32_t count = 0;
+    in.read(header, sizeof(header));
+    in.read((char *)&count, sizeof(count));
+
+    std::vector<Vector3D> soup;
+    float record[12];
+    std::uint16_t attribute;
+    for (std::uint32_t t = 0; t < count && in.read((char *)record, sizeof(record)); t++)
+    {
+        in.read((char *)&attribute, sizeof(attribute));
+        for (int c = 0; c < 3; c++)
+        {
+            soup.push_back(Vector3D(record[3 + 3 * c], record[4 + 3 * c], record[5 + 3 * c]));
+        }
+    }
+    return soup;
+}
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 1000;
+    std::string filename = argc > 2 ? argv[2] : "bench_stl.stl";
+    bool generated = argc <= 2;
+
+    long long bytes = 0;
+    if (generated)
+    {
+        bytes = writeHeightFieldStl(filename, gridSize);
+    }
+    else
+    {
+        std::ifstream sizeProbe(filename, std::ios::binary | std::ios::ate);
+        bytes = (long long)sizeProbe.tellg();
+    }
+    std::printf("Model: %s (%.1f MB)\n", filename.c_str(), bytes / 1e6);
+
+    BenchTimer timer;
+    std::vector<Vector3D> soup = readSoup(filename);
+    printThroughput("stream read, soup", timer.seconds(), bytes);
+
+#ifdef BENCH_WITH_VTK
+    // The reader the GUI used before STL files were loaded by Model, which
+    // also merges coincident points
+    timer.reset();
+    vtkSmartPointer<vtkSTLReader> reader = vtkSmartPointer<vtkSTLReader>::New();
+    reader->SetFileName(filename.c_str());
+    reader->Update();
+    printThroughput("vtkSTLReader", timer.seconds(), bytes);
+    std::printf("vtkSTLReader points: %lld\n", (long long)reader->GetOutput()->GetNumberOfPoints());
+#endif
+
+    timer.reset();
+    Model model(filename);
+    printThroughput("mmap/welded (Model)", timer.seconds(), bytes);
+
+    int maxThreads = std::thread::hardware_concurrency();
+    for (int threads = 2; threads <= std::max(maxThreads, 2); threads *= 2)
+    {
+        timer.reset();
+        Model parallelModel(filename, threads);
+        printThroughput("mmap/welded, " + std::to_string(threads) + " threads", timer.seconds(), bytes);
+    }
+
+    double soupBytes = (double)soup.size() * sizeof(Vector3D);
+    double weldedBytes = (double)model.getVertexCount() * sizeof(Vector3D) + 3.0 * model.getTriangleCount() * sizeof(int);
+    std::printf("Triangles: %d, corners: %d, welded vertices: %d\n", model.getTriangleCount(), (int)soup.size(),
+                model.getVertexCount());
+    std::printf("Memory: soup %.1f MB, indexed %.1f MB (%.2fx)\n", soupBytes / 1e6, weldedBytes / 1e6,
+                weldedBytes / soupBytes);
+
+    if (generated)
+    {
+        std::remove(filename.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file bench_stream.cpp
+ * @brief Benchmark of streamed .mod loads: time until the first batch of
+ * cells can be drawn against the time of the whole load, and the cost of
+ * streaming to the load itself
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ *
+ * Usage: bench_stream [grid size] [threads] [stream limit]
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "benchutil.h"
+#include "cellstream.h"
+#include "model.h"
+
+int main(int argc, char **argv)
+{
+    int gridSize = argc > 1 ? std::atoi(argv[1]) : 80;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 0;
+    long long limit = argc > 3 ? std::atoll(argv[3]) : 1000000;
+    std::string filename = "bench_stream.mod";
+    long long bytes = writeHexGridModel(filename, gridSize);
+    std::printf("Model: %d^3 hexahedra (%.1f MB), stream limit %lld cells\n", gridSize, bytes / 1e6, limit);
+
+    BenchTimer timer;
+    {
+        Model model(filename, threads);
+    }
+    printThroughput("load without stream", timer.seconds(), bytes);
+
+    // Poll the stream from another thread, as the window does
+    CellStream stream(limit);
+    std::atomic<bool> done(false);
+    double firstBatch = -1;
+    long long streamed = 0;
+    timer.reset();
+    std::thread poller([&]() {
+        while (!done.load())
+        {
+            for (const CellBatch &batch : stream.take())
+            {
+                firstBatch = firstBatch < 0 ? timer.seconds() : firstBatch;
+                streamed += batch.size();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    {
+        Model model(filename, threads, nullptr, Precision::Double, nullptr, &stream);
+        done.store(true);
+        printThroughput("load with stream", timer.seconds(), bytes);
+    }
+    poller.join();
+    for (const CellBatch &batch : stream.take())
+    {
+        firstBatch = firstBatch < 0 ? timer.seconds() : firstBatch;
+        streamed += batch.size();
+    }
+    std::printf("%-28s %10.3f s (%lld cells streamed)\n", "first batch", firstBatch, streamed);
+
+    std::remove(filename.c_str());
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file bench_vector.cpp
+ * @brief Micro-benchmarks of Cell::getCentre and Tetrahedron volumes against out-of-line vector operations
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_vector [cell count in thousands]
+ *
+ * The cells are evaluated repeatedly so that they stay in cache and the
+ * cost of the calls, not of memory, is measured.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "benchutil.h"
+#include "cell.h"
+#include "material.h"
+#include "vector3d.h"
+
+#define OUT_OF_LINE __attribute__((noinline))
+
+// Vector with the interface Vector3D used to have: operations defined out
+// of line (here, never inlined), arguments by value, user-provided
+// destructor. It stands in for the old vector3d.cpp across translation units.
+class OutOfLineVector
+{
+  private:
+    double x, y, z;
+
+  public:
+    OUT_OF_LINE OutOfLineVector() : x(0), y(0), z(0) {}
+    OUT_OF_LINE OutOfLineVector(double x, double y, double z) : x(x), y(y), z(z) {}
+    OUT_OF_LINE ~OutOfLineVector() {}
+
+    OUT_OF_LINE double getX() { return x; }
+    OUT_OF_LINE double getY() { return y; }
+    OUT_OF_LINE double getZ() { return z; }
+
+    OUT_OF_LINE OutOfLineVector operator-(OutOfLineVector rhs) { return OutOfLineVector(x - rhs.x, y - rhs.y, z - rhs.z); }
+    OUT_OF_LINE double dot(OutOfLineVector rhs) { return x * rhs.x + y * rhs.y + z * rhs.z; }
+    OUT_OF_LINE OutOfLineVector cross(OutOfLineVector rhs)
+    {
+        return OutOfLineVector(y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x);
+    }
+};
+
+// Cell::getCentre as written against the out-of-line vector
+static OutOfLineVector outOfLineCentre(std::vector<OutOfLineVector> &vertices, const int *vertexIds, int count)
+{
+    double x_sum = 0, y_sum = 0, z_sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        OutOfLineVector vertex = vertices[vertexIds[i]];
+        x_sum += vertex.getX();
+        y_sum += vertex.getY();
+        z_sum += vertex.getZ();
+    }
+    return OutOfLineVector(x_sum / count, y_sum / count, z_sum / count);
+}
+
+// Tetrahedron::computeVolume as written against the out-of-line vector
+static double outOfLineVolume(OutOfLineVector *vertices)
+{
+    OutOfLineVector va = vertices[1] - vertices[0];
+    OutOfLineVector vb = vertices[2] - vertices[0];
+    OutOfLineVector vc = vertices[3] - vertices[0];
+    return va.dot(vb.cross(vc)) / 6;
+}
+
+// Call function(i) for every cell, repeats times, and print the rate
+template <class Function>
+static void timeCells(const char *label, int count, int repeats, Function function)
+{
+    BenchTimer timer;
+    for (int r = 0; r < repeats; r++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            function(i);
+        }
+    }
+    double seconds = timer.seconds();
+    std::printf("%-28s %10.3f s %10.1f M cells/s\n", label, seconds, (double)count * repeats / seconds / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    int count = (argc > 1 ? std::atoi(argv[1]) : 16) * 1000;
+    int repeats = 32000000 / count + 1;
+    std::printf("Tetrahedra: %d, evaluated %d times\n", count, repeats);
+
+    std::srand(1);
+    std::vector<Vector3D> vertices;
+    std::vector<OutOfLineVector> oldVertices;
+    for (int i = 0; i < 4 * count; i++)
+    {
+        double x = std::rand() / (double)RAND_MAX;
+        double y = std::rand() / (double)RAND_MAX;
+        double z = std::rand() / (double)RAND_MAX;
+        vertices.push_back(Vector3D(x, y, z));
+        oldVertices.push_back(OutOfLineVector(x, y, z));
+    }
+
+    // Cells in a vertex pool, as a Model builds them
+    VertexStore store;
+    store.reserve(vertices.size());
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        store.push_back(vertices[i].getX(), vertices[i].getY(), vertices[i].getZ());
+    }
+    Material material(0, 1000, "ffffff", "test");
+    MaterialTable materials;
+    materials.set(0, material);
+    std::vector<Tetrahedron> cells;
+    cells.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        int vertexIds[4] = {4 * i, 4 * i + 1, 4 * i + 2, 4 * i + 3};
+        cells.push_back(Tetrahedron(vertexIds, &store, 0, &materials));
+    }
+
+    double sum = 0;
+    timeCells("centre, out-of-line", count, repeats, [&](int i) {
+        int vertexIds[4] = {4 * i, 4 * i + 1, 4 * i + 2, 4 * i + 3};
+        sum += outOfLineCentre(oldVertices, vertexIds, 4).getX();
+    });
+    timeCells("Cell::getCentre", count, repeats, [&](int i) {
+        sum -= cells[i].getCentre().getX();
+    });
+    timeCells("volume, out-of-line", count, repeats, [&](int i) {
+        sum += outOfLineVolume(&oldVertices[4 * i]);
+    });
+    timeCells("Tetrahedron::computeVolume", count, repeats, [&](int i) {
+        sum -= Tetrahedron::computeVolume(&vertices[4 * i]);
+    });
+    timeCells("Tetrahedron::getVolume", count, repeats, [&](int i) {
+        sum -= cells[i].getVolume();
+    });
+
+    std::printf("checksum %g\n", sum);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file bench_vectorkernels.cpp
+ * @brief Benchmark of the batch vector kernels at each SIMD level
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_vectorkernels [vertex count]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchutil.h"
+#include "matrix.h"
+#include "simd.h"
+#include "vectorkernels.h"
+
+// Time every kernel on every level for one column type and return a checksum
+template <class Scalar>
+static double runLevels(const char *name, std::vector<Scalar> &x, std::vector<Scalar> &y, std::vector<Scalar> &z)
+{
+    int count = x.size();
+    long long columnBytes = (long long)count * sizeof(Scalar);
+    long long resultBytes = (long long)count * sizeof(double);
+    std::vector<double> rx(count), ry(count), rz(count);
+    Matrix3x3 rotation(std::cos(0.1), -std::sin(0.1), 0, std::sin(0.1), std::cos(0.1), 0, 0, 0, 1);
+    Matrix3x3 inverse = rotation.transpose();
+    double checksum = 0;
+
+    SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (SimdLevel level : levels)
+    {
+        if (resolveSimdLevel(level) != level)
+        {
+            continue;
+        }
+        std::string label = std::string(name) + ", " + getSimdLevelName(level);
+
+        BenchTimer timer;
+        computeDots(x.data(), y.data(), z.data(), z.data(), x.data(), y.data(), count, rx.data(), level);
+        printThroughput(label + ", dot", timer.seconds(), 3 * columnBytes + resultBytes);
+        checksum += rx[count / 2];
+
+        timer.reset();
+        computeCrosses(x.data(), y.data(), z.data(), z.data(), x.data(), y.data(), count, rx.data(), ry.data(),
+                       rz.data(), level);
+        printThroughput(label + ", cross", timer.seconds(), 3 * columnBytes + 3 * resultBytes);
+        checksum += ry[count / 2];
+
+        timer.reset();
+        computeDistances(x.data(), y.data(), z.data(), count, Vector3D(1, 2, 3), rx.data(), level);
+        printThroughput(label + ", distance", timer.seconds(), 3 * columnBytes + resultBytes);
+        checksum += rx[count / 2];
+
+        // Rotate forth and back in place, so that every level starts alike
+        timer.reset();
+        transformVectors(x.data(), y.data(), z.data(), count, rotation, Vector3D(1, 0, 0), x.data(), y.data(),
+                         z.data(), level);
+        transformVectors(x.data(), y.data(), z.data(), count, inverse, inverse * Vector3D(-1, 0, 0), x.data(),
+                         y.data(), z.data(), level);
+        printThroughput(label + ", transform", timer.seconds(), 12 * columnBytes);
+
+        timer.reset();
+        Vector3D min, max;
+        computeBounds(x.data(), y.data(), z.data(), count, min, max, level);
+        printThroughput(label + ", bounds", timer.seconds(), 3 * columnBytes);
+        checksum += max.getX() - min.getX();
+    }
+    return checksum;
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    std::printf("Vertices: %d, detected %s\n", count, getSimdLevelName(getSimdLevel()));
+
+    std::srand(1);
+    std::vector<double> x(count), y(count), z(count);
+    for (int i = 0; i < count; i++)
+    {
+        x[i] = 100.0 * std::rand() / RAND_MAX;
+        y[i] = 100.0 * std::rand() / RAND_MAX;
+        z[i] = 100.0 * std::rand() / RAND_MAX;
+    }
+    std::vector<float> xf(x.begin(), x.end());
+    std::vector<float> yf(y.begin(), y.end());
+    std::vector<float> zf(z.begin(), z.end());
+
+    double doubleSum = runLevels("double", x, y, z);
+    double singleSum = runLevels("single", xf, yf, zf);
+    std::printf("checksum %g/%g\n", doubleSum, singleSum);
+    return 0;
+}
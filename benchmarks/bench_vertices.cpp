@@ -0,0 +1,108 @@
+/**
+ * @file bench_vertices.cpp
+ * @brief Benchmark of whole-model vertex passes on Vector3D arrays against VertexArray columns
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_vertices [vertex count in millions]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "benchutil.h"
+#include "vector3d.h"
+#include "vertexarray.h"
+
+// Bounding box through the Vector3D getters, as Model used to compute it
+static void vectorBounds(std::vector<Vector3D> &vertices, Vector3D &min, Vector3D &max)
+{
+    min = max = vertices[0];
+    for (int i = 1; i < vertices.size(); i++)
+    {
+        Vector3D &v = vertices[i];
+        if (v.getX() < min.getX()) min.setX(v.getX());
+        if (v.getY() < min.getY()) min.setY(v.getY());
+        if (v.getZ() < min.getZ()) min.setZ(v.getZ());
+        if (v.getX() > max.getX()) max.setX(v.getX());
+        if (v.getY() > max.getY()) max.setY(v.getY());
+        if (v.getZ() > max.getZ()) max.setZ(v.getZ());
+    }
+}
+
+// Centroid through the Vector3D getters, as Model::getCentre used to compute it
+static Vector3D vectorCentroid(std::vector<Vector3D> &vertices)
+{
+    double x = 0, y = 0, z = 0;
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        x += vertices[i].getX();
+        y += vertices[i].getY();
+        z += vertices[i].getZ();
+    }
+    return Vector3D(x / vertices.size(), y / vertices.size(), z / vertices.size());
+}
+
+// Translation through the Vector3D operators
+static void vectorTranslate(std::vector<Vector3D> &vertices, Vector3D offset)
+{
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        vertices[i] = vertices[i] + offset;
+    }
+}
+
+// Print one result line, bandwidth counting one read of every coordinate
+static void printPass(const char *label, double seconds, int count)
+{
+    printThroughput(label, seconds, (long long)count * 3 * sizeof(double));
+}
+
+int main(int argc, char **argv)
+{
+    int count = (argc > 1 ? std::atoi(argv[1]) : 20) * 1000000;
+    std::printf("Vertices: %d (%.1f MB)\n", count, count * 3.0 * sizeof(double) / 1e6);
+
+    std::vector<Vector3D> vectors(count);
+    VertexArray columns;
+    columns.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        double x = (i % 1000) * 0.1;
+        double y = (i / 1000 % 1000) * 0.1;
+        double z = (i / 1000000) * 0.1;
+        vectors[i] = Vector3D(x, y, z);
+        columns.push_back(x, y, z);
+    }
+
+    Vector3D min, max;
+    BenchTimer timer;
+    vectorBounds(vectors, min, max);
+    printPass("bounds, Vector3D", timer.seconds(), count);
+    timer.reset();
+    columns.getBounds(min, max);
+    printPass("bounds, VertexArray", timer.seconds(), count);
+
+    timer.reset();
+    Vector3D centre = vectorCentroid(vectors);
+    printPass("centroid, Vector3D", timer.seconds(), count);
+    timer.reset();
+    Vector3D columnCentre = columns.getCentroid();
+    printPass("centroid, VertexArray", timer.seconds(), count);
+
+    timer.reset();
+    vectorTranslate(vectors, Vector3D(1, 2, 3));
+    printPass("translate, Vector3D", timer.seconds(), count);
+    timer.reset();
+    columns.translate(Vector3D(1, 2, 3));
+    printPass("translate, VertexArray", timer.seconds(), count);
+
+    double rotation[9] = {0, -1, 0, 1, 0, 0, 0, 0, 1};
+    timer.reset();
+    columns.transform(rotation, Vector3D(0, 0, 1));
+    printPass("transform, VertexArray", timer.seconds(), count);
+
+    std::printf("centroid %g/%g\n", centre.getX(), columnCentre.getX());
+    return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file bench_volumes.cpp
+ * @brief Benchmark of the batch hexahedron volume kernel at each SIMD level
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Usage: bench_volumes [grid size]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchutil.h"
+#include "simd.h"
+#include "volumekernels.h"
+
+// Time the kernel on every level for one column type and return a checksum
+template <class Scalar>
+static double runLevels(const char *name, const std::vector<int> &vertexIds, const std::vector<Scalar> &x,
+                        const std::vector<Scalar> &y, const std::vector<Scalar> &z)
+{
+    int count = vertexIds.size() / 8;
+    std::vector<double> volumes(count);
+    long long bytes = vertexIds.size() * sizeof(int) + 24LL * count * sizeof(Scalar);
+    double checksum = 0;
+
+    SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (SimdLevel level : levels)
+    {
+        if (resolveSimdLevel(level) != level)
+        {
+            continue;
+        }
+        BenchTimer timer;
+        computeHexahedronVolumes(vertexIds.data(), count, x.data(), y.data(), z.data(), volumes.data(), level);
+        double seconds = timer.seconds();
+        printThroughput(std::string(name) + ", " + getSimdLevelName(level), seconds, bytes);
+        std::printf("%-28s %10.1f M cells/s\n", "", count / seconds / 1e6);
+        checksum += volumes[count / 2];
+    }
+    return checksum;
+}
+
+int main(int argc, char **argv)
+{
+    int n = argc > 1 ? std::atoi(argv[1]) : 120;
+    int side = n + 1;
+    std::printf("Grid: %d hexahedra, detected %s\n", n * n * n, getSimdLevelName(getSimdLevel()));
+
+    // Slightly distorted grid so that no volume is trivial
+    std::srand(1);
+    std::vector<double> x, y, z;
+    for (int k = 0; k < side; k++)
+    {
+        for (int j = 0; j < side; j++)
+        {
+            for (int i = 0; i < side; i++)
+            {
+                x.push_back(i + 0.2 * std::rand() / RAND_MAX);
+                y.push_back(j + 0.2 * std::rand() / RAND_MAX);
+                z.push_back(k + 0.2 * std::rand() / RAND_MAX);
+            }
+        }
+    }
+    std::vector<float> xf(x.begin(), x.end());
+    std::vector<float> yf(y.begin(), y.end());
+    std::vector<float> zf(z.begin(), z.end());
+
+    std::vector<int> vertexIds;
+    for (int k = 0; k < n; k++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                int v0 = (k * side + j) * side + i;
+                int v3 = v0 + side;
+                int v4 = v0 + side * side;
+                int v7 = v3 + side * side;
+                int cell[8] = {v0, v0 + 1, v3 + 1, v3, v4, v4 + 1, v7 + 1, v7};
+                vertexIds.insert(vertexIds.end(), cell, cell + 8);
+            }
+        }
+    }
+
+    double doubleSum = runLevels("double", vertexIds, x, y, z);
+    double singleSum = runLevels("single", vertexIds, xf, yf, zf);
+    std::printf("checksum %g/%g\n", doubleSum, singleSum);
+    return 0;
+}
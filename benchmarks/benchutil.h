@@ -0,0 +1,98 @@
+/**
+ * @file benchutil.h
+ * @brief Shared helpers for the benchmark programs
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/**
+ * Wall-clock stopwatch, started on construction.
+ */
+class BenchTimer
+{
+  private:
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    BenchTimer() : start(std::chrono::steady_clock::now()) {}
+
+    /**
+    * Restart the stopwatch
+    */
+    void reset() { start = std::chrono::steady_clock::now(); }
+
+    /**
+    * Return seconds elapsed since construction or the last reset
+    */
+    double seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+/**
+ * Write a synthetic .mod file: an n x n x n grid of unit hexahedra made of
+ * two alternating materials. Returns the size of the file in bytes.
+ */
+inline long long writeHexGridModel(const std::string &filename, int n)
+{
+    std::ofstream out(filename, std::ios::binary);
+    char line[256];
+
+    out << "m 0 8940 b87333 cu\n";
+    out << "m 1 2700 d0d5db al\n\n";
+
+    int side = n + 1;
+    for (int k = 0; k < side; k++)
+    {
+        for (int j = 0; j < side; j++)
+        {
+            for (int i = 0; i < side; i++)
+            {
+                int id = (k * side + j) * side + i;
+                std::snprintf(line, sizeof(line), "v %d %g %g %g\n", id, i * 0.1, j * 0.1 - 0.35, k * 0.1 + 0.025);
+                out << line;
+            }
+        }
+    }
+    out << "\n";
+
+    int cellId = 0;
+    for (int k = 0; k < n; k++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                int v0 = (k * side + j) * side + i;
+                int v3 = v0 + side;
+                int v4 = v0 + side * side;
+                int v7 = v3 + side * side;
+                std::snprintf(line, sizeof(line), "c %d h %d %d %d %d %d %d %d %d %d\n", cellId, cellId % 2,
+                              v0, v0 + 1, v3 + 1, v3, v4, v4 + 1, v7 + 1, v7);
+                out << line;
+                cellId++;
+            }
+        }
+    }
+
+    return (long long)out.tellp();
+}
+
+/**
+ * Print one result line: label, seconds and throughput in MB/s
+ */
+inline void printThroughput(const std::string &label, double seconds, long long bytes)
+{
+    std::printf("%-28s %10.3f s %10.1f MB/s\n", label.c_str(), seconds, bytes / seconds / 1e6);
+}
+
+#endif /* BENCHUTIL_H */
@@ -0,0 +1,102 @@
+/**
+ * @file referenceparser.h
+ * @brief The original getline/stoi .mod loader, shared by the benchmarks
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef REFERENCEPARSER_H
+#define REFERENCEPARSER_H
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cell.h"
+#include "material.h"
+#include "vector3d.h"
+
+/**
+ * The original loader: std::getline, a std::vector<std::string> per line
+ * and std::stoi/std::stod. Kept here as the baseline to measure against.
+ */
+class ReferenceParser
+{
+  public:
+    std::vector<Vector3D> vertices;
+    std::vector<Material> materials;
+    std::vector<Cell> cells;
+
+    std::vector<std::string> splitString(std::string line)
+    {
+        std::vector<std::string> strings;
+        std::istringstream f(line);
+        std::string s;
+        while (std::getline(f, s, ' '))
+        {
+            strings.push_back(s);
+        }
+        return strings;
+    }
+
+    void parse(const std::string &filename)
+    {
+        std::ifstream modelFile(filename);
+        std::string line;
+        while (std::getline(modelFile, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            std::vector<std::string> strings = splitString(line);
+            if (line[0] == 'm')
+            {
+                int id = std::stoi(strings[1]);
+                if (id >= materials.size())
+                {
+                    materials.resize(id + 1);
+                }
+                materials[id] = Material(id, std::stod(strings[2]), strings[3], strings[4]);
+            }
+            else if (line[0] == 'v')
+            {
+                int id = std::stoi(strings[1]);
+                if (id >= vertices.size())
+                {
+                    vertices.resize(id + 1);
+                }
+                vertices[id] = Vector3D(std::stod(strings[2]), std::stod(strings[3]), std::stod(strings[4]));
+            }
+            else if (line[0] == 'c')
+            {
+                int id = std::stoi(strings[1]);
+                Material mat = materials[std::stoi(strings[3])];
+                std::vector<Vector3D> cellVertices;
+                for (int i = 4; i < strings.size(); i++)
+                {
+                    cellVertices.push_back(vertices[std::stoi(strings[i])]);
+                }
+                if (id >= cells.size())
+                {
+                    cells.resize(id + 1);
+                }
+                switch (strings[2][0])
+                {
+                case 'h':
+                    cells[id] = Hexahedron(cellVertices, mat);
+                    break;
+                case 'p':
+                    cells[id] = Pyramid(cellVertices, mat);
+                    break;
+                case 't':
+                    cells[id] = Tetrahedron(cellVertices, mat);
+                    break;
+                }
+            }
+        }
+    }
+};
+
+#endif /* REFERENCEPARSER_H */
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <map>
+#include "modreader.h"
+
+// Streams a .mod file (or standard input) and prints record counts,
+// without loading the model into memory.
+class StatsVisitor : public ModVisitor
+{
+  public:
+    long long vertexCount = 0;
+    std::map<int, long long> cellsPerMaterial;
+    std::map<int, std::string> materialNames;
+
+    void visitMaterial(const Material &material) { materialNames[material.getId()] = material.getName(); }
+    void visitVertex(std::int64_t, const Vector3D &) { vertexCount++; }
+    void visitCell(std::int64_t, char, int materialId, const std::vector<std::int64_t> &) { cellsPerMaterial[materialId]++; }
+};
+
+int main(int argc, char **argv) {
+    StatsVisitor stats;
+    bool ok;
+
+    if (argc > 1) {
+        ModReader reader(argv[1]);
+        ok = reader.read(stats);
+    } else {
+        ModReader reader(std::cin);
+        ok = reader.read(stats);
+    }
+
+    if (!ok) {
+        std::cerr << "Error while reading model\n";
+        return 1;
+    }
+
+    std::cout << "Vertices: " << stats.vertexCount << "\n";
+    for (auto &entry : stats.cellsPerMaterial) {
+        std::cout << "Cells of material " << entry.first << " (" << stats.materialNames[entry.first] << "): " << entry.second << "\n";
+    }
+}
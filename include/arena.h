@@ -0,0 +1,163 @@
+/**
+ * @file arena.h
+ * @brief Header file for the Arena class and the ArenaAllocator allocator
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Monotonic memory arena. Memory is handed out from large blocks and is
+ * only returned all at once, by release() or when the arena is destroyed,
+ * so allocating is a pointer bump and freeing costs nothing. Allocation
+ * is thread-safe.
+ */
+class Arena
+{
+  private:
+    /**
+    * Size of the blocks requested from the system, larger requests get a block of their own
+    */
+    std::size_t blockSize;
+
+    /**
+    * Blocks owned by the arena
+    */
+    std::vector<void *> blocks;
+
+    /**
+    * Next free byte and end of the current block
+    */
+    char *current;
+    char *limit;
+
+    /**
+    * Bytes handed out and bytes held in blocks since the last release
+    */
+    std::size_t bytesAllocated;
+    std::size_t bytesReserved;
+
+    std::mutex mutex;
+
+  public:
+    /**
+    * Default size of the blocks requested from the system
+    */
+    static const std::size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+    explicit Arena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+    * Return size bytes aligned to alignment (a power of two), throws
+    * std::bad_alloc if the system is out of memory
+    */
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    /**
+    * Free every block at once. Everything allocated from the arena
+    * becomes invalid.
+    */
+    void release();
+
+    // Accessors
+
+    /**
+    * Get number of bytes handed out since the last release
+    */
+    std::size_t getBytesAllocated();
+
+    /**
+    * Get number of bytes held in blocks
+    */
+    std::size_t getBytesReserved();
+
+    /**
+    * Get number of blocks held
+    */
+    int getBlockCount();
+};
+
+/**
+ * Standard allocator drawing from an Arena, or from the heap when no arena
+ * is given. Memory is aligned to at least Alignment bytes. Deallocation
+ * is a no-op for arena memory, which is freed when the arena is released.
+ */
+template <class T, std::size_t Alignment = alignof(T)>
+class ArenaAllocator
+{
+  private:
+    Arena *arena;
+
+    template <class U, std::size_t A>
+    friend class ArenaAllocator;
+
+    static const std::size_t ALIGNMENT = Alignment > alignof(T) ? Alignment : alignof(T);
+
+  public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef ArenaAllocator<U, Alignment> other;
+    };
+
+    ArenaAllocator() : arena(nullptr) {}
+    ArenaAllocator(Arena *arena) : arena(arena) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U, Alignment> &other) : arena(other.arena) {}
+
+    /**
+    * Get the arena allocated from (nullptr for the heap)
+    */
+    Arena *getArena() const { return this->arena; }
+
+    T *allocate(std::size_t count)
+    {
+        if (this->arena != nullptr)
+        {
+            return (T *)this->arena->allocate(count * sizeof(T), ALIGNMENT);
+        }
+
+        // Over-allocate and keep the original pointer just before the aligned block
+        void *block = ::operator new(count * sizeof(T) + ALIGNMENT + sizeof(void *));
+        std::size_t address = (std::size_t)block + sizeof(void *);
+        address = (address + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        ((void **)address)[-1] = block;
+        return (T *)address;
+    }
+
+    void deallocate(T *pointer, std::size_t)
+    {
+        if (this->arena == nullptr && pointer != nullptr)
+        {
+            ::operator delete(((void **)pointer)[-1]);
+        }
+    }
+
+    // Containers keep allocating from the same arena when copied, moved or swapped
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U, Alignment> &other) const { return this->arena == other.arena; }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U, Alignment> &other) const { return this->arena != other.arena; }
+};
+
+#endif /* ARENA_H */
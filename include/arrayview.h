@@ -0,0 +1,55 @@
+/**
+ * @file arrayview.h
+ * @brief Header file for the ArrayView class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef ARRAYVIEW_H
+#define ARRAYVIEW_H
+
+#include <cstddef>
+
+/**
+ * Read-only, non-owning view of a contiguous array (pointer and size).
+ * Views are cheap to copy and never allocate; they stay valid as long
+ * as the container they were taken from is alive and unchanged.
+ */
+template <class T>
+class ArrayView
+{
+  private:
+    const T *first;
+    std::size_t count;
+
+  public:
+    typedef const T *iterator;
+
+    ArrayView() : first(nullptr), count(0) {}
+    ArrayView(const T *first, std::size_t count) : first(first), count(count) {}
+
+    /**
+    * Get number of elements
+    */
+    std::size_t size() const { return this->count; }
+
+    /**
+    * Return true if there are no elements
+    */
+    bool empty() const { return this->count == 0; }
+
+    /**
+    * Get element i
+    */
+    const T &operator[](std::size_t i) const { return this->first[i]; }
+
+    /**
+    * Get pointer to the first element
+    */
+    const T *data() const { return this->first; }
+
+    iterator begin() const { return this->first; }
+    iterator end() const { return this->first + this->count; }
+};
+
+#endif /* ARRAYVIEW_H */
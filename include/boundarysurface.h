@@ -0,0 +1,140 @@
+/**
+ * @file boundarysurface.h
+ * @brief Header file for the BoundarySurface class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef BOUNDARYSURFACE_H
+#define BOUNDARYSURFACE_H
+
+#include <vector>
+
+#include "arrayview.h"
+
+class CellStore;
+class FaceAdjacency;
+class LoadProgress;
+class VertexStore;
+
+/**
+ * Exterior faces of the cells of a model, as an indexed surface of
+ * triangles and quadrilaterals.
+ *
+ * Faces hold indices into the vertices of the model, with the winding of
+ * Shape::FACES, counter-clockwise seen from outside the cell they belong
+ * to. Each face keeps the cell it comes from and that cell's material.
+ * Faces are in the order of their cells, then of Shape::FACES.
+ */
+class BoundarySurface
+{
+  private:
+    /**
+    * First vertex of each face, followed by the number of vertices
+    */
+    std::vector<int> offsets;
+
+    /**
+    * Vertices of each face, three or four per face
+    */
+    std::vector<int> vertexIds;
+
+    /**
+    * Cell and material of each face
+    */
+    std::vector<int> cellIds;
+    std::vector<int> materialIds;
+
+    int triangleCount;
+    double area;
+
+  public:
+    BoundarySurface() : offsets(1, 0), triangleCount(0), area(0) {}
+
+    /**
+    * Build from the faces, offsets having one more element than there are
+    * faces, and their total area
+    */
+    BoundarySurface(std::vector<int> offsets, std::vector<int> vertexIds, std::vector<int> cellIds,
+                    std::vector<int> materialIds, double area);
+
+    /**
+    * Get number of faces
+    */
+    int getFaceCount() const { return this->cellIds.size(); }
+
+    /**
+    * Get number of triangular faces
+    */
+    int getTriangleCount() const { return this->triangleCount; }
+
+    /**
+    * Get number of quadrilateral faces
+    */
+    int getQuadCount() const { return getFaceCount() - this->triangleCount; }
+
+    /**
+    * Get number of vertices of face i (3 or 4)
+    */
+    int getVertexCount(int i) const { return this->offsets[i + 1] - this->offsets[i]; }
+
+    /**
+    * Get the vertex indices of face i
+    */
+    ArrayView<int> getVertexIds(int i) const
+    {
+        return ArrayView<int>(this->vertexIds.data() + this->offsets[i], getVertexCount(i));
+    }
+
+    /**
+    * Get the cell that face i belongs to
+    */
+    int getCellId(int i) const { return this->cellIds[i]; }
+
+    /**
+    * Get the material of face i
+    */
+    int getMaterialId(int i) const { return this->materialIds[i]; }
+
+    /**
+    * Get the face offsets, one per face followed by the vertex index count
+    */
+    const std::vector<int> &getOffsets() const { return this->offsets; }
+
+    /**
+    * Get the vertex indices of all faces
+    */
+    const std::vector<int> &getVertexIds() const { return this->vertexIds; }
+
+    /**
+    * Get the cells of all faces
+    */
+    const std::vector<int> &getCellIds() const { return this->cellIds; }
+
+    /**
+    * Get the materials of all faces
+    */
+    const std::vector<int> &getMaterialIds() const { return this->materialIds; }
+
+    /**
+    * Get total area of the faces; quadrilaterals are split along their
+    * 0-2 diagonal
+    */
+    double getArea() const { return this->area; }
+};
+
+/**
+ * Extract the faces of cells that no other cell shares (the BOUNDARY
+ * entries of adjacency, which must have been built from cells) on
+ * threadCount threads (0 means one per hardware thread). Faces shared by
+ * more than two cells are not part of the surface. The boundary faces of
+ * each cell are counted in parallel, turned into offsets by a prefix sum
+ * and written in parallel, and the area is summed in fixed blocks of faces,
+ * so the result does not depend on the thread count. If progress is
+ * cancelled, stops after the current pass and returns an empty surface.
+ */
+BoundarySurface extractBoundarySurface(const CellStore &cells, const VertexStore &vertices,
+                                       const FaceAdjacency &adjacency, int threadCount,
+                                       const LoadProgress *progress = nullptr);
+
+#endif /* BOUNDARYSURFACE_H */
@@ -10,35 +10,138 @@
 #define CELL_H
 
 #include <vector>
+#include "arrayview.h"
 #include "vector3d.h"
+#include "vertexstore.h"
 #include "material.h"
+#include "materialtable.h"
+#include "matrix.h"
 
 /**
  * Shape defined by 2 or more vertices (Vector3D).
+ * Vertices are held as indices into a vertex array: the array of the
+ * Model the cell belongs to, or the cell's own copy for cells built
+ * from coordinates. Positions are looked up when needed. The material
+ * is likewise an index into the Model's MaterialTable, so cells of a
+ * model do not copy material names and colours.
+ *
+ * The subclasses only set the type and vertices, which Cell holds, so
+ * cells can be stored by value in a std::vector<Cell> without losing
+ * their type. Shape formulas are static functions of the subclasses and
+ * are shared with the batch kernels in cellstore.h.
  */
 class Cell
 {
+  public:
+    /**
+    * Largest number of vertices of any cell type
+    */
+    static const int MAX_VERTEX_COUNT = 8;
+
   protected:
     /**
-    * Vertices that define the cell
+    * Type of the cell ('h', 'p', 't', or 0 for an empty cell)
+    */
+    char type;
+
+    /**
+    * Vertices owned by the cell (only for cells built from coordinates)
     */
     std::vector<Vector3D> vertices;
 
     /**
-    * Material that the cell is made of
+    * Vertex array shared with a Model, nullptr if the cell owns its vertices
+    */
+    const VertexStore *vertexPool;
+
+    /**
+    * Indices of the vertices that define the cell
+    */
+    int vertexIds[MAX_VERTEX_COUNT];
+
+    /**
+    * Number of vertices that define the cell
+    */
+    int vertexCount;
+
+    /**
+    * Material owned by the cell (only for cells built from coordinates,
+    * a default material until one is set)
     */
     Material material;
 
+    /**
+    * Material table shared with a Model, nullptr if the cell owns its material
+    */
+    const MaterialTable *materialPool;
+
+    /**
+    * Index of the material that the cell is made of
+    */
+    int materialId;
+
+    /**
+    * Copy count vertex positions into the cell
+    */
+    void setVertices(const std::vector<Vector3D> &vertices, int count);
+
+    /**
+    * Reference count vertices of a shared vertex array
+    */
+    void setVertices(const int *vertexIds, const VertexStore *vertexPool, int count);
+
+    /**
+    * Copy material into the cell
+    */
+    void setMaterial(const Material &material);
+
+    /**
+    * Reference material materialId of a shared material table
+    */
+    void setMaterial(int materialId, const MaterialTable *materialPool);
+
   public:
     Cell();
     ~Cell();
 
     // Accessors
 
+    /**
+    * Get type of the cell ('h', 'p', 't', or 0 for an empty cell)
+    */
+    char getType();
+
+    /**
+    * Get number of vertices of the cell
+    */
+    int getVertexCount();
+
+    /**
+    * Get indices of the vertices of the cell (IDs in the Model for cells of a Model)
+    */
+    std::vector<int> getVertexIds();
+
+    /**
+    * Get a view of the indices of the vertices of the cell, without copying them
+    */
+    ArrayView<int> getVertexIdView() const;
+
+    /**
+    * Get position of vertex i of the cell
+    */
+    Vector3D getVertex(int i) const
+    {
+        if (this->vertexPool != nullptr)
+        {
+            return this->vertexPool->get(this->vertexIds[i]);
+        }
+        return this->vertices[this->vertexIds[i]];
+    }
+
     /**
     * Get volume of the cell
     */
-    virtual double getVolume();
+    double getVolume();
 
     /**
     * Get mass of the cell
@@ -59,6 +162,16 @@ class Cell
     * Get material of the cell
     */
     Material getMaterial();
+
+    /**
+    * Get a reference to the material of the cell, without copying it
+    */
+    const Material &getMaterialView() const;
+
+    /**
+    * Get index of the material of the cell (its ID for cells of a Model)
+    */
+    int getMaterialId();
 };
 
 /**
@@ -67,12 +180,59 @@ class Cell
 class Pyramid : public Cell
 {
   public:
+    /**
+    * Cell type character used in .mod files
+    */
+    static const char TYPE = 'p';
+
+    /**
+    * Number of vertices of a pyramid
+    */
+    static const int VERTEX_COUNT = 5;
+
+    /**
+    * Number of faces of a pyramid
+    */
+    static const int FACE_COUNT = 5;
+
+    /**
+    * Vertices of each face, counter-clockwise seen from outside the cell
+    * when its volume is positive (triangles end with -1)
+    */
+    static const int FACES[FACE_COUNT][4];
+
     Pyramid();
     Pyramid(std::vector<Vector3D> &vertices, Material &material);
+
+    /**
+    * Build from vertex IDs into vertexPool and a material ID into
+    * materialPool, which must both outlive the cell
+    */
+    Pyramid(const int *vertexIds, const VertexStore *vertexPool, int materialId, const MaterialTable *materialPool);
     ~Pyramid();
 
-    // Accessors
-    virtual double getVolume();
+    // Shape formulas
+
+    /**
+    * Volume of a pyramid with the given VERTEX_COUNT vertices (base
+    * 0-1-2-3, which need not be planar, and apex 4), positive when the
+    * base is counter-clockwise seen from the apex
+    */
+    static double computeVolume(const Vector3D *vertices);
+
+    /**
+    * First moment of volume (integral of the position over the pyramid),
+    * from the same four tetrahedra as computeVolume; divided by the volume
+    * it gives the centroid
+    */
+    static Vector3D computeMoment(const Vector3D *vertices);
+
+    /**
+    * First and second moments of volume about origin: the integrals of
+    * p - origin and of (p - origin) (p - origin)^T over the pyramid, from
+    * the same tetrahedra as computeVolume
+    */
+    static void computeMoments(const Vector3D *vertices, Vector3D origin, Vector3D &first, Matrix3x3 &second);
 };
 
 /**
@@ -81,12 +241,58 @@ class Pyramid : public Cell
 class Hexahedron : public Cell
 {
   public:
+    /**
+    * Cell type character used in .mod files
+    */
+    static const char TYPE = 'h';
+
+    /**
+    * Number of vertices of a hexahedron
+    */
+    static const int VERTEX_COUNT = 8;
+
+    /**
+    * Number of faces of a hexahedron
+    */
+    static const int FACE_COUNT = 6;
+
+    /**
+    * Vertices of each face, counter-clockwise seen from outside the cell
+    * when its volume is positive
+    */
+    static const int FACES[FACE_COUNT][4];
+
     Hexahedron();
     Hexahedron(std::vector<Vector3D> &vertices, Material &material);
+
+    /**
+    * Build from vertex IDs into vertexPool and a material ID into
+    * materialPool, which must both outlive the cell
+    */
+    Hexahedron(const int *vertexIds, const VertexStore *vertexPool, int materialId, const MaterialTable *materialPool);
     ~Hexahedron();
 
-    // Accessors
-    virtual double getVolume();
+    // Shape formulas
+
+    /**
+    * Volume of a hexahedron with the given VERTEX_COUNT vertices, whose
+    * faces need not be planar (see hexahedronVolume in volumekernels.h)
+    */
+    static double computeVolume(const Vector3D *vertices);
+
+    /**
+    * First moment of volume (integral of the position over the
+    * hexahedron), from the 24 tetrahedra of computeVolume; divided by the
+    * volume it gives the centroid
+    */
+    static Vector3D computeMoment(const Vector3D *vertices);
+
+    /**
+    * First and second moments of volume about origin: the integrals of
+    * p - origin and of (p - origin) (p - origin)^T over the hexahedron, from
+    * the same tetrahedra as computeVolume
+    */
+    static void computeMoments(const Vector3D *vertices, Vector3D origin, Vector3D &first, Matrix3x3 &second);
 };
 
 /**
@@ -95,12 +301,56 @@ class Hexahedron : public Cell
 class Tetrahedron : public Cell
 {
   public:
+    /**
+    * Cell type character used in .mod files
+    */
+    static const char TYPE = 't';
+
+    /**
+    * Number of vertices of a tetrahedron
+    */
+    static const int VERTEX_COUNT = 4;
+
+    /**
+    * Number of faces of a tetrahedron
+    */
+    static const int FACE_COUNT = 4;
+
+    /**
+    * Vertices of each face, counter-clockwise seen from outside the cell
+    * when its volume is positive (triangles end with -1)
+    */
+    static const int FACES[FACE_COUNT][4];
+
     Tetrahedron();
     Tetrahedron(std::vector<Vector3D> &vertices, Material &material);
+
+    /**
+    * Build from vertex IDs into vertexPool and a material ID into
+    * materialPool, which must both outlive the cell
+    */
+    Tetrahedron(const int *vertexIds, const VertexStore *vertexPool, int materialId, const MaterialTable *materialPool);
     ~Tetrahedron();
 
-    // Accessors
-    virtual double getVolume();
+    // Shape formulas
+
+    /**
+    * Volume of a tetrahedron with the given VERTEX_COUNT vertices
+    */
+    static double computeVolume(const Vector3D *vertices);
+
+    /**
+    * First moment of volume (integral of the position over the
+    * tetrahedron), its volume times the mean of its vertices
+    */
+    static Vector3D computeMoment(const Vector3D *vertices);
+
+    /**
+    * First and second moments of volume about origin: the integrals of
+    * p - origin and of (p - origin) (p - origin)^T over the tetrahedron, from
+    * the same tetrahedra as computeVolume
+    */
+    static void computeMoments(const Vector3D *vertices, Vector3D origin, Vector3D &first, Matrix3x3 &second);
 };
 
 #endif /* CELL_H */
\ No newline at end of file
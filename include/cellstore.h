@@ -0,0 +1,373 @@
+/**
+ * @file cellstore.h
+ * @brief Header file for the CellStore class and the per-type cell kernels
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef CELLSTORE_H
+#define CELLSTORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "arena.h"
+#include "cell.h"
+#include "matrix.h"
+#include "vector3d.h"
+#include "vertexarray.h"
+#include "volumekernels.h"
+
+/**
+ * Densely packed cells of a single type (Tetrahedron, Pyramid or
+ * Hexahedron), each with Shape::VERTEX_COUNT vertex IDs.
+ */
+template <class Shape>
+class CellArray
+{
+    // Fills resized arrays in place when assigning whole files
+    friend class CellStore;
+
+  private:
+    /**
+    * ID of each cell in the model
+    */
+    std::vector<int, ArenaAllocator<int>> ids;
+
+    /**
+    * Material ID of each cell
+    */
+    std::vector<int, ArenaAllocator<int>> materialIds;
+
+    /**
+    * Vertex IDs of all cells, Shape::VERTEX_COUNT per cell
+    */
+    std::vector<int, ArenaAllocator<int>> vertexIds;
+
+    /**
+    * Overwrite cell index, which must exist
+    */
+    void set(int index, int id, int materialId, const std::int32_t *cellVertexIds)
+    {
+        this->ids[index] = id;
+        this->materialIds[index] = materialId;
+        std::copy(cellVertexIds, cellVertexIds + Shape::VERTEX_COUNT,
+                  this->vertexIds.begin() + (std::size_t)index * Shape::VERTEX_COUNT);
+    }
+
+  public:
+    CellArray() {}
+
+    /**
+    * Allocate from arena (the heap if nullptr), which must outlive the array
+    */
+    explicit CellArray(Arena *arena) : ids(arena), materialIds(arena), vertexIds(arena) {}
+
+    /**
+    * Append a cell, returns its index in the array
+    */
+    int add(int id, int materialId, const int *cellVertexIds)
+    {
+        this->ids.push_back(id);
+        this->materialIds.push_back(materialId);
+        this->vertexIds.insert(this->vertexIds.end(), cellVertexIds, cellVertexIds + Shape::VERTEX_COUNT);
+        return this->ids.size() - 1;
+    }
+
+    /**
+    * Resize to count cells (new cells are zeroed until set)
+    */
+    void resize(int count)
+    {
+        this->ids.resize(count);
+        this->materialIds.resize(count);
+        this->vertexIds.resize((std::size_t)count * Shape::VERTEX_COUNT);
+    }
+
+    /**
+    * Make room for count cells
+    */
+    void reserve(int count)
+    {
+        this->ids.reserve(count);
+        this->materialIds.reserve(count);
+        this->vertexIds.reserve((std::size_t)count * Shape::VERTEX_COUNT);
+    }
+
+    /**
+    * Remove all cells
+    */
+    void clear()
+    {
+        this->ids.clear();
+        this->materialIds.clear();
+        this->vertexIds.clear();
+    }
+
+    /**
+    * Get number of cells
+    */
+    int size() const
+    {
+        return this->ids.size();
+    }
+
+    /**
+    * Get model ID of cell i
+    */
+    int getId(int i) const
+    {
+        return this->ids[i];
+    }
+
+    /**
+    * Get material ID of cell i
+    */
+    int getMaterialId(int i) const
+    {
+        return this->materialIds[i];
+    }
+
+    /**
+    * Get the Shape::VERTEX_COUNT vertex IDs of cell i
+    */
+    const int *getVertexIds(int i) const
+    {
+        return &this->vertexIds[Shape::VERTEX_COUNT * i];
+    }
+
+    /**
+    * Get the material IDs of all cells, one per cell
+    */
+    const int *getMaterialIds() const
+    {
+        return this->materialIds.data();
+    }
+
+    /**
+    * Get the vertex IDs of all cells, Shape::VERTEX_COUNT per cell
+    */
+    const int *getVertexIds() const
+    {
+        return this->vertexIds.data();
+    }
+};
+
+/**
+ * Cells of a model grouped by type. Each type is kept in its own
+ * CellArray, so kernels can run over one type at a time without
+ * dispatching per cell; an index by ID gives access to single cells.
+ */
+class CellStore
+{
+  private:
+    CellArray<Tetrahedron> tetrahedra;
+    CellArray<Pyramid> pyramids;
+    CellArray<Hexahedron> hexahedra;
+
+    /**
+    * Type of each cell ID ('h', 'p', 't', or 0 for unused IDs)
+    */
+    std::vector<char, ArenaAllocator<char>> types;
+
+    /**
+    * Index of each cell ID in the array of its type
+    */
+    std::vector<int, ArenaAllocator<int>> indices;
+
+  public:
+    CellStore() {}
+
+    /**
+    * Allocate from arena (the heap if nullptr), which must outlive the store
+    */
+    explicit CellStore(Arena *arena);
+
+    /**
+    * Remove all cells
+    */
+    void clear();
+
+    /**
+    * Make room for IDs up to cellCount - 1, new IDs are unused
+    */
+    void resize(int cellCount);
+
+    /**
+    * Make room for the given number of cells of each type
+    */
+    void reserve(int tetrahedronCount, int pyramidCount, int hexahedronCount);
+
+    /**
+    * Store cell id, which must be unused, of type 'h', 'p' or 't'
+    */
+    void add(int id, char type, int materialId, const int *vertexIds);
+
+    /**
+    * Replace all cells by cellCount cells given as columns, as in a binary
+    * .mod file: the type of each cell ('h', 'p', 't', or 0 to leave the ID
+    * unused), its material ID, and the offset of its vertex IDs into
+    * connectivity. Each column is copied in one pass on threadCount threads
+    * rather than cell by cell.
+    */
+    void assign(const char *cellTypes, const std::int32_t *materialIds, const std::uint64_t *offsets,
+                const std::int32_t *connectivity, int cellCount, int threadCount);
+
+    // Accessors
+
+    /**
+    * Get number of cell IDs (including unused ones)
+    */
+    int getCellCount() const;
+
+    /**
+    * Get type of cell id ('h', 'p', 't', or 0 for unused IDs)
+    */
+    char getType(int id) const;
+
+    /**
+    * Get material ID of cell id (-1 for unused IDs)
+    */
+    int getMaterialId(int id) const;
+
+    /**
+    * Get number of vertices of cell id (0 for unused IDs)
+    */
+    int getVertexCount(int id) const;
+
+    /**
+    * Get vertex IDs of cell id (nullptr for unused IDs)
+    */
+    const int *getVertexIds(int id) const;
+
+    /**
+    * Get total number of vertex IDs of all cells
+    */
+    std::size_t getConnectivitySize() const;
+
+    /**
+    * Get all tetrahedra
+    */
+    const CellArray<Tetrahedron> &getTetrahedra() const;
+
+    /**
+    * Get all pyramids
+    */
+    const CellArray<Pyramid> &getPyramids() const;
+
+    /**
+    * Get all hexahedra
+    */
+    const CellArray<Hexahedron> &getHexahedra() const;
+};
+
+// Batch kernels, one loop per cell type without virtual calls
+
+/**
+ * Compute the volume of cells first to first + count - 1 of the array
+ * into volumes
+ */
+template <class Shape, class Scalar>
+void computeVolumes(const CellArray<Shape> &cells, const BasicVertexArray<Scalar> &vertices, int first, int count,
+                    double *volumes)
+{
+    Vector3D positions[Shape::VERTEX_COUNT];
+    for (int i = 0; i < count; i++)
+    {
+        const int *vertexIds = cells.getVertexIds(first + i);
+        for (int j = 0; j < Shape::VERTEX_COUNT; j++)
+        {
+            positions[j] = vertices.get(vertexIds[j]);
+        }
+        volumes[i] = Shape::computeVolume(positions);
+    }
+}
+
+/**
+ * Compute the volume of hexahedra first to first + count - 1 of the
+ * array into volumes, with the SIMD kernel of volumekernels.h
+ */
+template <class Scalar>
+void computeVolumes(const CellArray<Hexahedron> &cells, const BasicVertexArray<Scalar> &vertices, int first, int count,
+                    double *volumes)
+{
+    if (count > 0)
+    {
+        computeHexahedronVolumes(cells.getVertexIds(first), count, vertices.getX(), vertices.getY(), vertices.getZ(),
+                                 volumes);
+    }
+}
+
+/**
+ * Compute the volume of every cell of the array into volumes
+ */
+template <class Shape, class Scalar>
+void computeVolumes(const CellArray<Shape> &cells, const BasicVertexArray<Scalar> &vertices, double *volumes)
+{
+    computeVolumes(cells, vertices, 0, cells.size(), volumes);
+}
+
+/**
+ * Compute the first and second moments of volume about origin (see
+ * Shape::computeMoments) of cells first to first + count - 1 of the array
+ * into firstMoments and secondMoments
+ */
+template <class Shape, class Scalar>
+void computeMoments(const CellArray<Shape> &cells, const BasicVertexArray<Scalar> &vertices, int first, int count,
+                    Vector3D origin, Vector3D *firstMoments, Matrix3x3 *secondMoments)
+{
+    Vector3D positions[Shape::VERTEX_COUNT];
+    for (int i = 0; i < count; i++)
+    {
+        const int *vertexIds = cells.getVertexIds(first + i);
+        for (int j = 0; j < Shape::VERTEX_COUNT; j++)
+        {
+            positions[j] = vertices.get(vertexIds[j]);
+        }
+        Shape::computeMoments(positions, origin, firstMoments[i], secondMoments[i]);
+    }
+}
+
+/**
+ * Compute the mass of every cell of the array into masses, densities
+ * being indexed by material ID
+ */
+template <class Shape, class Scalar>
+void computeMasses(const CellArray<Shape> &cells, const BasicVertexArray<Scalar> &vertices, const double *densities, double *masses)
+{
+    computeVolumes(cells, vertices, masses);
+    for (int i = 0; i < cells.size(); i++)
+    {
+        masses[i] *= densities[cells.getMaterialId(i)];
+    }
+}
+
+/**
+ * Compute the centre (mean of the vertices) of every cell of the array
+ * into centres
+ */
+template <class Shape, class Scalar>
+void computeCentres(const CellArray<Shape> &cells, const BasicVertexArray<Scalar> &vertices, Vector3D *centres)
+{
+    const Scalar *vertexX = vertices.getX();
+    const Scalar *vertexY = vertices.getY();
+    const Scalar *vertexZ = vertices.getZ();
+    for (int i = 0; i < cells.size(); i++)
+    {
+        const int *vertexIds = cells.getVertexIds(i);
+        double x = 0;
+        double y = 0;
+        double z = 0;
+        for (int j = 0; j < Shape::VERTEX_COUNT; j++)
+        {
+            x += vertexX[vertexIds[j]];
+            y += vertexY[vertexIds[j]];
+            z += vertexZ[vertexIds[j]];
+        }
+        centres[i] = Vector3D(x / Shape::VERTEX_COUNT, y / Shape::VERTEX_COUNT, z / Shape::VERTEX_COUNT);
+    }
+}
+
+#endif /* CELLSTORE_H */
@@ -0,0 +1,83 @@
+/**
+ * @file cellstream.h
+ * @brief Header file for the CellStream class
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#ifndef CELLSTREAM_H
+#define CELLSTREAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Cells read while a model is still loading, each with its own copy of the
+ * positions of its vertices, so that a batch can be drawn on its own.
+ */
+struct CellBatch
+{
+    /**
+    * Cell types ('t', 'p' or 'h'), one per cell
+    */
+    std::vector<char> types;
+
+    /**
+    * Colour of the material of each cell, as 0xRRGGBB
+    */
+    std::vector<std::uint32_t> colours;
+
+    /**
+    * Vertex positions of the cells one after the other, three floats per
+    * vertex, in the order of the file
+    */
+    std::vector<float> points;
+
+    /**
+    * Get the number of cells in the batch
+    */
+    int size() const { return this->types.size(); }
+};
+
+/**
+ * Batches of cells handed from a load to another thread as parsing goes,
+ * up to a limit on the total number of cells, beyond which the rest of the
+ * model only comes with the finished load. Every member is safe to call
+ * from any thread.
+ */
+class CellStream
+{
+  private:
+    std::mutex mutex;
+    std::vector<CellBatch> batches;
+    std::atomic<long long> cellCount;
+    long long cellLimit;
+
+  public:
+    /**
+    * Make a stream that takes up to cellLimit cells in all
+    */
+    explicit CellStream(long long cellLimit) : cellCount(0), cellLimit(cellLimit) {}
+
+    CellStream(const CellStream &) = delete;
+    CellStream &operator=(const CellStream &) = delete;
+
+    /**
+    * Get the number of cells that can still be pushed
+    */
+    long long getRoom() const { return this->cellLimit - this->cellCount.load(std::memory_order_relaxed); }
+
+    /**
+    * Add batch, which must fit in the room left
+    */
+    void push(CellBatch &&batch);
+
+    /**
+    * Take every batch pushed since the last call, oldest first
+    */
+    std::vector<CellBatch> take();
+};
+
+#endif /* CELLSTREAM_H */
@@ -0,0 +1,148 @@
+/**
+ * @file cellview.h
+ * @brief Header file for the CellView and CellRange classes
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef CELLVIEW_H
+#define CELLVIEW_H
+
+#include "arrayview.h"
+#include "cellstore.h"
+#include "material.h"
+#include "materialtable.h"
+#include "vector3d.h"
+#include "vertexstore.h"
+
+/**
+ * Read-only view of one cell of a model. It refers to the model's cell,
+ * vertex and material storage instead of copying it, so it is as cheap
+ * to pass around as a pointer and never allocates. All its accessors are
+ * const, so any number of threads can read a model through views.
+ */
+class CellView
+{
+  private:
+    const CellStore *cells;
+    const VertexStore *vertices;
+    const MaterialTable *materials;
+    int id;
+
+  public:
+    CellView(const CellStore *cells, const VertexStore *vertices, const MaterialTable *materials, int id)
+        : cells(cells), vertices(vertices), materials(materials), id(id) {}
+
+    /**
+    * Get ID of the cell
+    */
+    int getId() const { return this->id; }
+
+    /**
+    * Get type of the cell ('h', 'p', 't', or 0 for an unused ID)
+    */
+    char getType() const { return this->cells->getType(this->id); }
+
+    /**
+    * Get number of vertices of the cell
+    */
+    int getVertexCount() const { return this->cells->getVertexCount(this->id); }
+
+    /**
+    * Get IDs of the vertices of the cell
+    */
+    ArrayView<int> getVertexIds() const
+    {
+        return ArrayView<int>(this->cells->getVertexIds(this->id), getVertexCount());
+    }
+
+    /**
+    * Get position of vertex i of the cell
+    */
+    Vector3D getVertex(int i) const
+    {
+        return this->vertices->get(this->cells->getVertexIds(this->id)[i]);
+    }
+
+    /**
+    * Get ID of the material of the cell (-1 for an unused ID)
+    */
+    int getMaterialId() const { return this->cells->getMaterialId(this->id); }
+
+    /**
+    * Get material of the cell, which must not be an unused ID
+    */
+    const Material &getMaterial() const { return this->materials->get(getMaterialId()); }
+
+    /**
+    * Get volume of the cell
+    */
+    double getVolume() const;
+
+    /**
+    * Get mass of the cell
+    */
+    double getMass() const;
+
+    /**
+    * Get the centre of the cell based on the vertices
+    */
+    Vector3D getCentre() const;
+};
+
+/**
+ * Range of CellView over the used cell IDs of a model, in ID order,
+ * for use in range-based for loops.
+ */
+class CellRange
+{
+  private:
+    const CellStore *cells;
+    const VertexStore *vertices;
+    const MaterialTable *materials;
+
+  public:
+    /**
+    * Forward iterator yielding a CellView for each used cell ID
+    */
+    class iterator
+    {
+      private:
+        const CellRange *range;
+        int id;
+
+        void skipUnused()
+        {
+            while (this->id < this->range->cells->getCellCount() && this->range->cells->getType(this->id) == 0)
+            {
+                this->id++;
+            }
+        }
+
+      public:
+        iterator(const CellRange *range, int id) : range(range), id(id) { skipUnused(); }
+
+        CellView operator*() const
+        {
+            return CellView(this->range->cells, this->range->vertices, this->range->materials, this->id);
+        }
+
+        iterator &operator++()
+        {
+            this->id++;
+            skipUnused();
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const { return this->id == other.id; }
+        bool operator!=(const iterator &other) const { return this->id != other.id; }
+    };
+
+    CellRange(const CellStore *cells, const VertexStore *vertices, const MaterialTable *materials)
+        : cells(cells), vertices(vertices), materials(materials) {}
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, this->cells->getCellCount()); }
+};
+
+#endif /* CELLVIEW_H */
@@ -0,0 +1,119 @@
+/**
+ * @file faceadjacency.h
+ * @brief Header file for the FaceAdjacency class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef FACEADJACENCY_H
+#define FACEADJACENCY_H
+
+#include <vector>
+
+class CellStore;
+class LoadProgress;
+
+/**
+ * Cell-to-cell adjacency through faces, in compressed sparse row form.
+ *
+ * Row id holds one entry per face of cell id, in the order of
+ * Shape::FACES: the ID of the cell across that face, BOUNDARY if no other
+ * cell has it, or NON_MANIFOLD if more than two cells share it. Unused
+ * cell IDs have empty rows. Two faces are the same face when they have the
+ * same set of vertex IDs, whatever their order.
+ */
+class FaceAdjacency
+{
+  private:
+    /**
+    * First entry of each cell ID, followed by the number of entries
+    */
+    std::vector<int> offsets;
+
+    /**
+    * Cell across each face of each cell
+    */
+    std::vector<int> neighbours;
+
+    int boundaryFaceCount;
+    int nonManifoldFaceCount;
+
+  public:
+    /**
+    * Entry of a face that belongs to one cell only
+    */
+    static const int BOUNDARY = -1;
+
+    /**
+    * Entry of a face that belongs to more than two cells
+    */
+    static const int NON_MANIFOLD = -2;
+
+    FaceAdjacency() : offsets(1, 0), boundaryFaceCount(0), nonManifoldFaceCount(0) {}
+
+    /**
+    * Build from the rows, offsets having one more element than there
+    * are cell IDs
+    */
+    FaceAdjacency(std::vector<int> offsets, std::vector<int> neighbours);
+
+    /**
+    * Get number of cell IDs (including unused ones)
+    */
+    int getCellCount() const { return this->offsets.size() - 1; }
+
+    /**
+    * Get total number of faces of all cells (a shared face counts once
+    * per cell)
+    */
+    int getFaceCount() const { return this->neighbours.size(); }
+
+    /**
+    * Get number of faces of cell id (0 for unused IDs)
+    */
+    int getFaceCount(int id) const { return this->offsets[id + 1] - this->offsets[id]; }
+
+    /**
+    * Get the getFaceCount(id) entries of cell id
+    */
+    const int *getNeighbours(int id) const { return this->neighbours.data() + this->offsets[id]; }
+
+    /**
+    * Get the entry of face face of cell id
+    */
+    int getNeighbour(int id, int face) const { return this->neighbours[this->offsets[id] + face]; }
+
+    /**
+    * Get the row offsets, one per cell ID followed by the entry count
+    */
+    const std::vector<int> &getOffsets() const { return this->offsets; }
+
+    /**
+    * Get the entries of all rows
+    */
+    const std::vector<int> &getEntries() const { return this->neighbours; }
+
+    /**
+    * Get number of faces that belong to one cell only
+    */
+    int getBoundaryFaceCount() const { return this->boundaryFaceCount; }
+
+    /**
+    * Get number of cell faces (counted once per cell) shared by more than
+    * two cells
+    */
+    int getNonManifoldFaceCount() const { return this->nonManifoldFaceCount; }
+};
+
+/**
+ * Build the face adjacency of cells on threadCount threads (0 means one
+ * per hardware thread). Faces are keyed by their sorted vertex IDs and
+ * partitioned by a hash of the key in parallel, then the faces of each
+ * partition are matched through a hash table of their own. Memory is
+ * proportional to the number of faces, and the result does not depend on
+ * the thread count. If progress is cancelled, stops after the current
+ * pass and returns an empty adjacency.
+ */
+FaceAdjacency buildFaceAdjacency(const CellStore &cells, int threadCount, const LoadProgress *progress = nullptr);
+
+#endif /* FACEADJACENCY_H */
@@ -0,0 +1,133 @@
+/**
+ * @file idmap.h
+ * @brief Header file for the IdMap class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef IDMAP_H
+#define IDMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "arena.h"
+
+/**
+ * Two-way mapping between the IDs of a file (any non-negative 64-bit
+ * values, possibly sparse) and the dense indices 0..size()-1 the model
+ * stores its vertices, cells and materials under. IDs are looked up in
+ * an open-addressing hash table with linear probing. When the IDs are
+ * exactly 0..size()-1, which is the usual case, the map is the identity
+ * and holds no memory at all.
+ */
+class IdMap
+{
+  private:
+    /**
+    * Number of indices
+    */
+    int count;
+
+    /**
+    * ID of each index (empty for the identity)
+    */
+    std::vector<std::int64_t, ArenaAllocator<std::int64_t>> ids;
+
+    /**
+    * Hash table of indices into ids, -1 for empty slots (a power of two
+    * in size, at most half full; empty for the identity)
+    */
+    std::vector<int, ArenaAllocator<int>> table;
+
+    /**
+    * Right shift taking a hashed ID to a slot of the table
+    */
+    int shift;
+
+    /**
+    * Get the home slot of id (Fibonacci hashing)
+    */
+    std::size_t getSlot(std::int64_t id) const
+    {
+        return (std::size_t)(((std::uint64_t)id * 0x9E3779B97F4A7C15ull) >> this->shift);
+    }
+
+  public:
+    IdMap() : count(0), shift(64) {}
+
+    /**
+    * Allocate from arena (the heap if nullptr), which must outlive the map
+    */
+    explicit IdMap(Arena *arena) : count(0), ids(arena), table(arena), shift(64) {}
+
+    /**
+    * Map index i to ID i, for i below count
+    */
+    void assignIdentity(int count);
+
+    /**
+    * Map index i to ids[i], for i below count. Returns false (leaving the
+    * map empty) if an ID is negative or appears twice.
+    */
+    bool assign(const std::int64_t *ids, int count);
+
+    /**
+    * Remove all IDs
+    */
+    void clear();
+
+    // Accessors
+
+    /**
+    * Get number of indices
+    */
+    int size() const { return this->count; }
+
+    /**
+    * Return true if every index is its own ID
+    */
+    bool isIdentity() const { return this->ids.empty(); }
+
+    /**
+    * Get index of id, -1 if the ID is not mapped
+    */
+    int find(std::int64_t id) const
+    {
+        if (this->ids.empty())
+        {
+            return id >= 0 && id < this->count ? (int)id : -1;
+        }
+
+        std::size_t mask = this->table.size() - 1;
+        for (std::size_t slot = getSlot(id);; slot = (slot + 1) & mask)
+        {
+            int index = this->table[slot];
+            if (index < 0 || this->ids[index] == id)
+            {
+                return index;
+            }
+        }
+    }
+
+    /**
+    * Get ID of index
+    */
+    std::int64_t getId(int index) const
+    {
+        return this->ids.empty() ? index : this->ids[index];
+    }
+
+    /**
+    * Get the ID of every index (nullptr for the identity)
+    */
+    const std::int64_t *getIds() const;
+
+    /**
+    * Get number of bytes used by the map
+    */
+    std::size_t getMemorySize() const;
+};
+
+#endif /* IDMAP_H */
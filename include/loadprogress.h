@@ -0,0 +1,82 @@
+/**
+ * @file loadprogress.h
+ * @brief Header file for the LoadProgress class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef LOADPROGRESS_H
+#define LOADPROGRESS_H
+
+#include <atomic>
+
+/**
+ * Progress of a load running on other threads, and a request to cancel
+ * it. The loader reports phases and their progress, another thread polls
+ * them and may cancel; every member is safe to call from any thread.
+ */
+class LoadProgress
+{
+  private:
+    std::atomic<const char *> phase;
+    std::atomic<long long> done;
+    std::atomic<long long> total;
+    std::atomic<bool> cancelled;
+
+  public:
+    LoadProgress() : phase(""), done(0), total(0), cancelled(false) {}
+
+    LoadProgress(const LoadProgress &) = delete;
+    LoadProgress &operator=(const LoadProgress &) = delete;
+
+    /**
+    * Start phase name (a string that outlives the load) of total steps
+    */
+    void beginPhase(const char *name, long long total)
+    {
+        this->done.store(0, std::memory_order_relaxed);
+        this->total.store(total, std::memory_order_relaxed);
+        this->phase.store(name, std::memory_order_release);
+    }
+
+    /**
+    * Record that steps more steps of the current phase are done
+    */
+    void advance(long long steps) { this->done.fetch_add(steps, std::memory_order_relaxed); }
+
+    /**
+    * Get the name of the current phase ("" before the first)
+    */
+    const char *getPhase() const { return this->phase.load(std::memory_order_acquire); }
+
+    /**
+    * Get the fraction of the current phase that is done, from 0 to 1
+    */
+    double getFraction() const
+    {
+        long long total = this->total.load(std::memory_order_relaxed);
+        long long done = this->done.load(std::memory_order_relaxed);
+        return total > 0 ? (done < total ? (double)done / total : 1.0) : 0.0;
+    }
+
+    /**
+    * Ask the load to stop at its next check
+    */
+    void cancel() { this->cancelled.store(true, std::memory_order_relaxed); }
+
+    /**
+    * Return true once cancel has been called
+    */
+    bool isCancelled() const { return this->cancelled.load(std::memory_order_relaxed); }
+};
+
+/**
+ * Return true if progress is given (not nullptr) and has been cancelled,
+ * for the long computations of a load that check it between steps
+ */
+inline bool isLoadCancelled(const LoadProgress *progress)
+{
+    return progress != nullptr && progress->isCancelled();
+}
+
+#endif /* LOADPROGRESS_H */
@@ -0,0 +1,143 @@
+/**
+ * @file massproperties.h
+ * @brief Header file for the CompensatedSum class and the whole-model mass properties
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef MASSPROPERTIES_H
+#define MASSPROPERTIES_H
+
+#include <cmath>
+#include <vector>
+
+#include "matrix.h"
+#include "vector3d.h"
+
+class CellStore;
+class LoadProgress;
+class MaterialTable;
+class VertexStore;
+
+/**
+ * Running sum with Neumaier compensation: the rounding error of every
+ * addition is kept in a second term, so that long sums of values of
+ * mixed magnitude stay accurate to about one rounding of the result.
+ */
+class CompensatedSum
+{
+  private:
+    double sum;
+    double compensation;
+
+  public:
+    CompensatedSum() : sum(0), compensation(0) {}
+
+    /**
+    * Add value to the sum
+    */
+    void add(double value)
+    {
+        double total = this->sum + value;
+        if (std::fabs(this->sum) >= std::fabs(value))
+        {
+            this->compensation += (this->sum - total) + value;
+        }
+        else
+        {
+            this->compensation += (value - total) + this->sum;
+        }
+        this->sum = total;
+    }
+
+    /**
+    * Add another compensated sum to the sum
+    */
+    void add(const CompensatedSum &other)
+    {
+        add(other.sum);
+        this->compensation += other.compensation;
+    }
+
+    /**
+    * Get the value of the sum
+    */
+    double getValue() const
+    {
+        return this->sum + this->compensation;
+    }
+};
+
+/**
+ * Volume, mass, centre of gravity and inertia of the cells of one
+ * material.
+ */
+struct MaterialMassProperties
+{
+    /**
+    * Number of cells made of the material
+    */
+    int cellCount;
+
+    /**
+    * Total volume of the cells
+    */
+    double volume;
+
+    /**
+    * Total mass of the cells (volume times the density of the material)
+    */
+    double mass;
+
+    /**
+    * Centre of gravity of the cells (the origin if they have no mass)
+    */
+    Vector3D centreOfGravity;
+
+    /**
+    * Inertia tensor about the centre of gravity
+    */
+    Matrix3x3 inertia;
+
+    /**
+    * Principal moments of inertia, in increasing order
+    */
+    Vector3D principalMoments;
+
+    /**
+    * Principal axes of inertia, the columns of a rotation matrix in the
+    * order of principalMoments
+    */
+    Matrix3x3 principalAxes;
+
+    MaterialMassProperties() : cellCount(0), volume(0), mass(0), principalAxes(Matrix3x3::identity()) {}
+};
+
+/**
+ * Volume, mass, centre of gravity and inertia of a model, in total and
+ * per material.
+ */
+struct MassProperties : MaterialMassProperties
+{
+    /**
+    * Properties of the cells of each material, indexed by material ID
+    */
+    std::vector<MaterialMassProperties> materials;
+};
+
+/**
+ * Compute the mass properties of cells on threadCount threads (0 means
+ * one per hardware thread), in one pass over the cells. Cells are taken
+ * in fixed blocks of each type, summed with compensation within a block
+ * and the blocks then combined in order, so the result does not depend
+ * on the thread count. Each cell contributes its exact first and second
+ * moments (see Hexahedron::computeMoments), taken about the centroid of
+ * the vertices so that models far from the origin keep their precision.
+ * If progress is cancelled, stops at the next block and returns empty
+ * (zero) properties.
+ */
+MassProperties computeMassProperties(const CellStore &cells, const VertexStore &vertices,
+                                     const MaterialTable &materials, int threadCount,
+                                     const LoadProgress *progress = nullptr);
+
+#endif /* MASSPROPERTIES_H */
@@ -46,22 +46,22 @@ class Material
 	/**
 	 * Return material's ID
 	*/
-	int getId();
+	int getId() const;
 
 	/**
 	* Return material's density
 	*/
-	double getDensity();
+	double getDensity() const;
 
 	/**
 	* Return material's colour
 	*/
-	std::string getColour();
+	std::string getColour() const;
 
 	/**
 	* Return material's name
 	*/
-	std::string getName();
+	std::string getName() const;
 
 	// Mutators
 
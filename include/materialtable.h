@@ -0,0 +1,90 @@
+/**
+ * @file materialtable.h
+ * @brief Header file for the MaterialTable class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef MATERIALTABLE_H
+#define MATERIALTABLE_H
+
+#include <vector>
+
+#include "arena.h"
+#include "arrayview.h"
+#include "material.h"
+
+/**
+ * Materials of a model, each stored once and referenced by cells through
+ * its index (the material ID). Densities are also kept as a column so
+ * that mass kernels can look them up without touching the strings.
+ */
+class MaterialTable
+{
+  private:
+    /**
+    * Material at each index (default materials for unused IDs)
+    */
+    std::vector<Material, ArenaAllocator<Material>> materials;
+
+    /**
+    * Density of each material
+    */
+    std::vector<double, ArenaAllocator<double>> densities;
+
+  public:
+    MaterialTable() {}
+
+    /**
+    * Allocate the table from arena (the heap if nullptr), which must
+    * outlive the table. Material names and colours stay on the heap.
+    */
+    explicit MaterialTable(Arena *arena) : materials(arena), densities(arena) {}
+
+    /**
+    * Get number of materials (including unused IDs)
+    */
+    int size() const;
+
+    /**
+    * Resize to count materials, new ones being default materials
+    */
+    void resize(int count);
+
+    /**
+    * Remove all materials
+    */
+    void clear();
+
+    /**
+    * Store material at index, growing the table if needed
+    */
+    void set(int index, const Material &material);
+
+    /**
+    * Get material at index
+    */
+    const Material &get(int index) const;
+
+    /**
+    * Get density of the material at index
+    */
+    double getDensity(int index) const;
+
+    /**
+    * Get the density of every material, indexed like the table
+    */
+    const double *getDensities() const;
+
+    /**
+    * Get a view of all materials, without copying them
+    */
+    ArrayView<Material> getMaterials() const;
+
+    /**
+    * Copy the materials into a std::vector
+    */
+    std::vector<Material> toVector() const;
+};
+
+#endif /* MATERIALTABLE_H */
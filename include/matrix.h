@@ -9,27 +9,233 @@
 #define MATRIX_H
 
 #include "vector3d.h"
-#include <vector>
 
 /**
- * 3x3 matrix.
+ * 3x3 matrix of doubles, stored in row-major order inside the object (no
+ * heap allocation). Everything but the eigen-decomposition is constexpr.
  */
 class Matrix3x3
 {
   protected:
     /**
-    * Values that make up the matrix
+    * Values that make up the matrix, row by row
     */
-    std::vector<float> values;
+    double values[9];
 
   public:
-    Matrix3x3();
-    ~Matrix3x3();
+    /**
+    * Zero matrix
+    */
+    constexpr Matrix3x3() : values{0, 0, 0, 0, 0, 0, 0, 0, 0} {}
+
+    /**
+    * Matrix with the given values, row by row
+    */
+    constexpr Matrix3x3(double a00, double a01, double a02,
+                        double a10, double a11, double a12,
+                        double a20, double a21, double a22)
+        : values{a00, a01, a02, a10, a11, a12, a20, a21, a22} {}
+
+    /**
+    * Identity matrix
+    */
+    static constexpr Matrix3x3 identity()
+    {
+        return diagonal(1, 1, 1);
+    }
+
+    /**
+    * Diagonal matrix with the given diagonal
+    */
+    static constexpr Matrix3x3 diagonal(double a00, double a11, double a22)
+    {
+        return Matrix3x3(a00, 0, 0, 0, a11, 0, 0, 0, a22);
+    }
+
+    // Accessors
+
+    /**
+    * Get the value at row, column
+    */
+    constexpr double get(int row, int column) const
+    {
+        return this->values[3 * row + column];
+    }
+
+    /**
+    * Set the value at row, column
+    */
+    constexpr void set(int row, int column, double value)
+    {
+        this->values[3 * row + column] = value;
+    }
+
+    /**
+    * Get the nine values, row by row
+    */
+    constexpr const double *data() const
+    {
+        return this->values;
+    }
+
+    /**
+    * Set diagonal of the matrix (other values become 0)
+    */
+    constexpr void setDiagonal(const Vector3D &v)
+    {
+        *this = diagonal(v.x, v.y, v.z);
+    }
+
+    // Operator overloading
+
+    /**
+    * Addition operation
+    */
+    constexpr Matrix3x3 operator+(const Matrix3x3 &rhsMatrix) const
+    {
+        Matrix3x3 result;
+        for (int i = 0; i < 9; i++)
+        {
+            result.values[i] = this->values[i] + rhsMatrix.values[i];
+        }
+        return result;
+    }
+
+    /**
+    * Subtract operation
+    */
+    constexpr Matrix3x3 operator-(const Matrix3x3 &rhsMatrix) const
+    {
+        Matrix3x3 result;
+        for (int i = 0; i < 9; i++)
+        {
+            result.values[i] = this->values[i] - rhsMatrix.values[i];
+        }
+        return result;
+    }
+
+    /**
+    * Scalar multiplication (Matrix3x3 on left hand side)
+    */
+    constexpr Matrix3x3 operator*(double scalar) const
+    {
+        Matrix3x3 result;
+        for (int i = 0; i < 9; i++)
+        {
+            result.values[i] = this->values[i] * scalar;
+        }
+        return result;
+    }
+
+    /**
+    * Scalar multiplication (Matrix3x3 on right hand side)
+    */
+    friend constexpr Matrix3x3 operator*(double scalar, const Matrix3x3 &m)
+    {
+        return m * scalar;
+    }
+
+    /**
+    * Matrix multiplication
+    */
+    constexpr Matrix3x3 operator*(const Matrix3x3 &rhsMatrix) const
+    {
+        Matrix3x3 result;
+        for (int row = 0; row < 3; row++)
+        {
+            for (int column = 0; column < 3; column++)
+            {
+                result.values[3 * row + column] = this->values[3 * row] * rhsMatrix.values[column] +
+                                                  this->values[3 * row + 1] * rhsMatrix.values[3 + column] +
+                                                  this->values[3 * row + 2] * rhsMatrix.values[6 + column];
+            }
+        }
+        return result;
+    }
+
+    /**
+    * Matrix-vector multiplication
+    */
+    constexpr Vector3D operator*(const Vector3D &v) const
+    {
+        return Vector3D(this->values[0] * v.x + this->values[1] * v.y + this->values[2] * v.z,
+                        this->values[3] * v.x + this->values[4] * v.y + this->values[5] * v.z,
+                        this->values[6] * v.x + this->values[7] * v.y + this->values[8] * v.z);
+    }
+
+    /**
+    * Equality operation
+    */
+    constexpr bool operator==(const Matrix3x3 &rhsMatrix) const
+    {
+        for (int i = 0; i < 9; i++)
+        {
+            if (this->values[i] != rhsMatrix.values[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Misc functions
+
+    /**
+    * Return the transposed matrix
+    */
+    constexpr Matrix3x3 transpose() const
+    {
+        return Matrix3x3(this->values[0], this->values[3], this->values[6],
+                         this->values[1], this->values[4], this->values[7],
+                         this->values[2], this->values[5], this->values[8]);
+    }
+
+    /**
+    * Return the sum of the diagonal
+    */
+    constexpr double trace() const
+    {
+        return this->values[0] + this->values[4] + this->values[8];
+    }
+
+    /**
+    * Return the determinant
+    */
+    constexpr double determinant() const
+    {
+        return this->values[0] * (this->values[4] * this->values[8] - this->values[5] * this->values[7]) -
+               this->values[1] * (this->values[3] * this->values[8] - this->values[5] * this->values[6]) +
+               this->values[2] * (this->values[3] * this->values[7] - this->values[4] * this->values[6]);
+    }
+
+    /**
+    * Set inverse to the inverse matrix, returns false (leaving inverse
+    * unchanged) if the matrix is singular
+    */
+    constexpr bool getInverse(Matrix3x3 &inverse) const
+    {
+        double det = determinant();
+        if (det == 0)
+        {
+            return false;
+        }
+
+        // Transposed matrix of cofactors over the determinant
+        const double *m = this->values;
+        inverse = Matrix3x3(m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8], m[1] * m[5] - m[2] * m[4],
+                            m[5] * m[6] - m[3] * m[8], m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+                            m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7], m[0] * m[4] - m[1] * m[3]) *
+                  (1 / det);
+        return true;
+    }
 
     /**
-    * Set diagonal of the matrix
+    * Decompose a symmetric matrix as V diag(eigenvalues) V^T: eigenvalues
+    * are in increasing order and the columns of eigenvectors are the
+    * matching unit eigenvectors, forming a right-handed basis. Only the
+    * upper triangle of the matrix is read.
     */
-    void setDiagonal(Vector3D &v);
+    void getEigenDecomposition(Vector3D &eigenvalues, Matrix3x3 &eigenvectors) const;
 };
 
-#endif /* MATRIX_H */
\ No newline at end of file
+#endif /* MATRIX_H */
@@ -0,0 +1,224 @@
+/**
+ * @file modbinary.h
+ * @brief Header file for the binary .mod companion format (.modb)
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ *
+ * Layout of a .modb file (native byte order, every section 8-byte aligned):
+ *
+ *  - ModBinaryHeader
+ *  - ModBinaryMaterial[materialCount]
+ *  - char strings[] (material colours and names, not NUL-terminated)
+ *  - double x[vertexCount], y[vertexCount], z[vertexCount]
+ *  - char cellTypes[cellCount] ('h', 'p', 't', or 0 for unused IDs)
+ *  - int32_t cellMaterialIds[cellCount]
+ *  - uint64_t cellOffsets[cellCount + 1] (into connectivity)
+ *  - int32_t connectivity[connectivitySize] (vertex indices of every cell)
+ *  - int64_t vertexIds[vertexIdCount] (file ID of every vertex)
+ *  - int64_t cellIds[cellIdCount] (file ID of every cell)
+ *
+ * Materials, vertices and cells are stored under the dense indices used
+ * by Model, and cells reference materials and vertices by index. The
+ * file IDs of vertices and cells are only written when they differ from
+ * the indices (the counts are 0 otherwise); material IDs are kept in the
+ * material table. All arrays can be used in place from a memory mapping,
+ * without decoding individual records.
+ */
+
+#ifndef MODBINARY_H
+#define MODBINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "material.h"
+
+class MappedFile;
+
+/**
+ * Current version of the binary format
+ */
+const std::uint32_t MOD_BINARY_VERSION = 2;
+
+/**
+ * Header at the start of every .modb file.
+ * Section offsets are in bytes from the start of the file.
+ */
+struct ModBinaryHeader
+{
+    char magic[8];                    /**< "13CADBIN" */
+    std::uint32_t version;            /**< MOD_BINARY_VERSION */
+    std::uint32_t byteOrderMark;      /**< 0x01020304 in the writer's byte order */
+    std::uint64_t fileSize;           /**< Total size of the file */
+    std::uint64_t materialCount;      /**< Number of material slots */
+    std::uint64_t vertexCount;        /**< Number of vertex slots */
+    std::uint64_t cellCount;          /**< Number of cell slots */
+    std::uint64_t connectivitySize;   /**< Number of entries in connectivity */
+    std::uint64_t stringsSize;        /**< Size of the strings section */
+    std::uint64_t materialOffset;     /**< ModBinaryMaterial[materialCount] */
+    std::uint64_t stringsOffset;      /**< char[stringsSize] */
+    std::uint64_t coordinateOffset;   /**< double[3 * vertexCount], x then y then z */
+    std::uint64_t cellTypeOffset;     /**< char[cellCount] */
+    std::uint64_t cellMaterialOffset; /**< int32_t[cellCount] */
+    std::uint64_t cellOffsetOffset;   /**< uint64_t[cellCount + 1] */
+    std::uint64_t connectivityOffset; /**< int32_t[connectivitySize] */
+    std::uint64_t vertexIdCount;      /**< vertexCount, or 0 if the IDs are the indices */
+    std::uint64_t cellIdCount;        /**< cellCount, or 0 if the IDs are the indices */
+    std::uint64_t vertexIdOffset;     /**< int64_t[vertexIdCount] */
+    std::uint64_t cellIdOffset;       /**< int64_t[cellIdCount] */
+};
+
+/**
+ * Material table entry. Strings are (offset, length) pairs in the
+ * strings section.
+ */
+struct ModBinaryMaterial
+{
+    std::int32_t id;
+    std::int32_t reserved;
+    double density;
+    std::uint64_t colourOffset;
+    std::uint64_t colourLength;
+    std::uint64_t nameOffset;
+    std::uint64_t nameLength;
+};
+
+/**
+ * Read-only view of a .modb file. When opened from a filename the file is
+ * memory-mapped and every array is used in place, so opening costs the
+ * same regardless of model size.
+ */
+class ModBinaryFile
+{
+  private:
+    /**
+    * Mapping owned by the view when opened from a filename
+    */
+    std::unique_ptr<MappedFile> mapping;
+
+    /**
+    * Start of the file contents (nullptr if not valid)
+    */
+    const char *data;
+
+    /**
+    * Header of the file
+    */
+    const ModBinaryHeader *header;
+
+  public:
+    ModBinaryFile();
+    ModBinaryFile(std::string filename);
+    ~ModBinaryFile();
+
+    /**
+    * Map and validate a file, returns false if it is not a valid .modb file
+    */
+    bool open(std::string filename);
+
+    /**
+    * Validate a .modb file that is already in memory (not copied, must
+    * outlive the view and be 8-byte aligned)
+    */
+    bool attach(const char *data, std::size_t size);
+
+    /**
+    * Return true if the view holds a valid .modb file
+    */
+    bool isValid() const;
+
+    // Accessors
+
+    /**
+    * Get format version of the file
+    */
+    std::uint32_t getVersion() const;
+
+    /**
+    * Get number of material slots
+    */
+    std::size_t getMaterialCount() const;
+
+    /**
+    * Get number of vertex slots
+    */
+    std::size_t getVertexCount() const;
+
+    /**
+    * Get number of cell slots
+    */
+    std::size_t getCellCount() const;
+
+    /**
+    * Get number of entries in the connectivity array
+    */
+    std::size_t getConnectivitySize() const;
+
+    /**
+    * Build material i from the material table
+    */
+    Material getMaterial(std::size_t i) const;
+
+    /**
+    * Get X coordinates of all vertices
+    */
+    const double *getX() const;
+
+    /**
+    * Get Y coordinates of all vertices
+    */
+    const double *getY() const;
+
+    /**
+    * Get Z coordinates of all vertices
+    */
+    const double *getZ() const;
+
+    /**
+    * Get type of every cell ('h', 'p', 't', or 0 for unused IDs)
+    */
+    const char *getCellTypes() const;
+
+    /**
+    * Get material ID of every cell
+    */
+    const std::int32_t *getCellMaterialIds() const;
+
+    /**
+    * Get offsets of every cell's vertex IDs in the connectivity array
+    * (getCellCount() + 1 entries)
+    */
+    const std::uint64_t *getCellOffsets() const;
+
+    /**
+    * Get vertex indices of all cells
+    */
+    const std::int32_t *getConnectivity() const;
+
+    /**
+    * Get file ID of every vertex (nullptr if the IDs are the indices)
+    */
+    const std::int64_t *getVertexIds() const;
+
+    /**
+    * Get file ID of every cell (nullptr if the IDs are the indices)
+    */
+    const std::int64_t *getCellIds() const;
+
+    // Misc functions
+
+    /**
+    * Return true if the buffer starts like a .modb file
+    */
+    static bool hasMagic(const char *data, std::size_t size);
+};
+
+/**
+ * Convert an ASCII .mod file to a binary .modb file.
+ * threadCount is passed on to the Model loader (0 means one per hardware thread).
+ */
+bool convertModToBinary(std::string modFilename, std::string binaryFilename, int threadCount = 0);
+
+#endif /* MODBINARY_H */
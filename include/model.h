@@ -11,11 +11,32 @@
 #include <string>
 
 #include "vector3d.h"
+#include "arena.h"
+#include "boundarysurface.h"
 #include "cell.h"
+#include "cellstore.h"
+#include "cellstream.h"
+#include "cellview.h"
+#include "faceadjacency.h"
+#include "idmap.h"
+#include "loadprogress.h"
+#include "massproperties.h"
 #include "material.h"
+#include "materialtable.h"
+#include "vertexcellindex.h"
+#include "vertexstore.h"
+
+class ModBinaryFile;
+struct CellRecord;
 
 /**
  * Model that loads vectors and cells from files.
+ *
+ * Vertices, cells and materials are stored under dense indices, in the
+ * order of their file IDs, and the IDs taken by the accessors below are
+ * these indices. The IDs of the file, which may be sparse or huge, are
+ * kept in IdMaps and written back by saveToFile and saveBinary. For files
+ * numbered from 0 without gaps, indices and file IDs are the same.
  */
 class Model
 {
@@ -31,42 +52,74 @@ class Model
     bool isSTL;
 
     /**
-    * std::vector of vertices loaded from file
+    * Vertices loaded from file, as x, y and z columns of the precision
+    * chosen at load time
+    */
+    VertexStore vertices;
+
+    /**
+    * Materials loaded from file, indexed by ID and shared by the cells
+    */
+    MaterialTable materials;
+
+    /**
+    * Cells loaded from file, grouped by type
     */
-    std::vector<Vector3D> vertices;
+    CellStore cells;
 
     /**
-    * std::vector of materials loaded from file
+    * Vertex indices of the triangles of a STL file, three per triangle
     */
-    std::vector<Material> materials;
+    std::vector<int, ArenaAllocator<int>> triangles;
 
     /**
-    * std::vector of cells loaded from file
+    * File IDs of the vertices, cells and materials
     */
-    std::vector<Cell> cells;
+    IdMap vertexIdMap;
+    IdMap cellIdMap;
+    IdMap materialIdMap;
+
+    /**
+    * Cells of each vertex, built on first use by getVertexCellIndex and
+    * not carried over to copies
+    */
+    VertexCellIndexCache vertexCellIndex;
 
     // Parsing functions
 
     /**
-    * Parse vertex string
+    * Parse an in-memory .mod file, split across threadCount threads.
+    * Lines are first parsed into records, then cell references to
+    * vertices and materials are resolved once the whole file is read.
+    * Records are kept in scratch arenas freed at once at the end.
+    * Progress, if not nullptr, is reported to progress, and parsing stops
+    * between phases, and while placing cells, once it is cancelled. If
+    * stream is not nullptr, each chunk is parsed a slice at a time and the
+    * cells read so far are sent to it after each slice (see CellStreamer).
     */
-    void parseVertex(std::string line);
+    void parseBuffer(const char *begin, const char *end, int threadCount, LoadProgress *progress,
+                     CellStream *stream);
 
     /**
-    * Parse material string
+    * Load a validated binary .modb file, checking cells on threadCount
+    * threads and stopping part way once progress, if not nullptr, is
+    * cancelled
     */
-    void parseMaterial(std::string line);
+    void loadBinary(const ModBinaryFile &file, int threadCount, const LoadProgress *progress);
 
     /**
-    * Parse cell string
+    * Return true if a cell of the given type ('h', 'p' or 't') only
+    * references defined vertices and materials (by index)
     */
-    void parseCell(std::string line);
+    bool isCellValid(char type, int materialId, const int *vertexIds, int vertexCount);
 
-    // Misc functions
     /**
-    * Split string into space-separated words
+    * Translate the material and vertex IDs of a cell record into indices,
+    * returns false if the cell references undefined vertices or materials
     */
-    std::vector<std::string> splitString(std::string line);
+    bool resolveCell(const CellRecord &record, int &materialIndex, int *vertexIndices) const;
+
+    // Misc functions
 
     /**
     * Return true if file is of that extension.
@@ -76,9 +129,57 @@ class Model
   public:
     Model() = default;
     ~Model() = default;
+    Model(const Model &) = default;
+    Model(Model &&) = default;
+    Model &operator=(const Model &) = default;
+    Model &operator=(Model &&) = default;
     // Loads model from file
     Model(std::string filename);
 
+    /**
+    * Load model from file using threadCount threads (0 means one per
+    * hardware thread). The result is identical to the serial constructor.
+    * STL files (binary or ASCII) are loaded as an indexed triangle list
+    * with coincident corners welded into shared vertices.
+    */
+    Model(std::string filename, int threadCount);
+
+    /**
+    * Load model from file using threadCount threads, allocating all of its
+    * storage from arena (the heap if nullptr). The arena must outlive the
+    * model; releasing it frees the whole model at once, after which the
+    * model must no longer be used.
+    */
+    Model(std::string filename, int threadCount, Arena *arena);
+
+    /**
+    * Load model from file as above, storing vertex coordinates in the
+    * given precision. Single precision halves the memory used by the
+    * coordinates, for models that are only displayed; volumes, masses and
+    * centres are still accumulated in double.
+    */
+    Model(std::string filename, int threadCount, Arena *arena, Precision precision);
+
+    /**
+    * Load model from file as above, reporting the phases of the load and
+    * their progress to progress (ignored if nullptr), which another thread
+    * may poll. If progress is cancelled during the load, loading stops at
+    * the next check and the model is left incomplete: it should then be
+    * discarded.
+    */
+    Model(std::string filename, int threadCount, Arena *arena, Precision precision, LoadProgress *progress);
+
+    /**
+    * Load model from file as above, also sending the cells of a text .mod
+    * file to stream (ignored if nullptr) in batches as they are parsed, so
+    * that another thread can draw them before the load is done. Only cells
+    * whose vertices and material are already read when they are sent go,
+    * which in a file listing its vertices first is all of them, up to the
+    * limit of the stream.
+    */
+    Model(std::string filename, int threadCount, Arena *arena, Precision precision, LoadProgress *progress,
+          CellStream *stream);
+
     // Accessors
 
     /**
@@ -96,30 +197,161 @@ class Model
     */
     std::vector<Material> getMaterials();
 
+    /**
+    * Get the materials as stored, without copying them
+    */
+    const MaterialTable &getMaterialTable() const;
+
+    /**
+    * Get a view of the materials, indexed by ID, without copying them
+    */
+    ArrayView<Material> getMaterialView() const;
+
     /**
     * Get list of vertices as a std::vector
     */
     std::vector<Vector3D> getVertices();
 
     /**
-    * Get list of cells as a std::vector
+    * Get the vertices as stored, without copying them
+    */
+    const VertexStore &getVertexStore() const;
+
+    /**
+    * Get precision of the stored vertex coordinates
+    */
+    Precision getPrecision() const;
+
+    /**
+    * Get the file IDs of the vertices
+    */
+    const IdMap &getVertexIdMap() const;
+
+    /**
+    * Get the file IDs of the cells
+    */
+    const IdMap &getCellIdMap() const;
+
+    /**
+    * Get the file IDs of the materials
+    */
+    const IdMap &getMaterialIdMap() const;
+
+    /**
+    * Get list of cells as a std::vector, each keeping its type. Cells of
+    * text files are indexed densely, in file ID order, so every entry is a
+    * real cell; only cells of binary files that fail validation stay at
+    * their index as empty cells of type 0. Cells are built on demand from
+    * the stored vertex IDs and look up positions in this model's vertices,
+    * so they must not outlive the model.
     */
     std::vector<Cell> getCells();
 
+    /**
+    * Get the cells as stored, grouped by type, without copying them
+    */
+    const CellStore &getCellStore() const;
+
+    /**
+    * Get a range of views of the used cells, in ID order. Iterating it
+    * copies nothing and allocates nothing; the views refer to this model
+    * and must not outlive it. Safe to use from several threads at once.
+    */
+    CellRange getCellView() const;
+
+    /**
+    * Get a view of cell id, which must be less than getCellCount()
+    */
+    CellView getCell(int id) const;
+
     /**
     * Get total number of materials
     */
-    int getMaterialCount();
+    int getMaterialCount() const;
 
     /**
     * Get total number of vertices
     */
-    int getVertexCount();
+    int getVertexCount() const;
 
     /**
     * Get total number of cells
     */
-    int getCellCount();
+    int getCellCount() const;
+
+    /**
+    * Get volume of every cell, indexed by cell ID (0 for the invalid cells
+    * of binary files, see getCells).
+    * Computed one cell type at a time by the kernels in cellstore.h.
+    */
+    std::vector<double> getCellVolumes();
+
+    /**
+    * Get mass of every cell, indexed by cell ID (0 for the invalid cells of
+    * binary files, see getCells)
+    */
+    std::vector<double> getCellMasses();
+
+    /**
+    * Get centre of every cell, indexed by cell ID
+    */
+    std::vector<Vector3D> getCellCentres();
+
+    /**
+    * Get total volume, mass, centre of gravity, inertia tensor and
+    * principal axes of the cells, and the same per material, computed in
+    * one pass on threadCount threads (0 means one per hardware thread).
+    * The result is the same for any thread count; see
+    * computeMassProperties. Cancelling progress gives empty properties.
+    */
+    MassProperties getMassProperties(int threadCount = 0, const LoadProgress *progress = nullptr) const;
+
+    /**
+    * Get the cells across each face of each cell, indexed by cell ID,
+    * built on threadCount threads (0 means one per hardware thread); see
+    * buildFaceAdjacency
+    */
+    FaceAdjacency getFaceAdjacency(int threadCount = 0) const;
+
+    /**
+    * Get the exterior faces of the cells, with their materials and total
+    * area, extracted on threadCount threads (0 means one per hardware
+    * thread); see extractBoundarySurface. Cancelling progress gives an
+    * empty surface.
+    */
+    BoundarySurface getBoundarySurface(int threadCount = 0, const LoadProgress *progress = nullptr) const;
+
+    /**
+    * Get the cells using each vertex, indexed by vertex ID. Built on the
+    * first call on threadCount threads (0 means one per hardware thread)
+    * and kept with the model; safe to call from several threads at once.
+    */
+    const VertexCellIndex &getVertexCellIndex(int threadCount = 0) const;
+
+    /**
+    * Get the IDs of the cells using vertex id, in increasing order, from
+    * getVertexCellIndex(). The view refers to this model and must not
+    * outlive it.
+    */
+    ArrayView<int> getVertexCells(int id) const;
+
+    /**
+    * Get vertex indices of the triangles of a STL file (three per triangle,
+    * indices into getVertices())
+    */
+    std::vector<int> getTriangles();
+
+    /**
+    * Get the vertex indices of the triangles of a STL file as stored,
+    * without copying them. The view refers to this model and must not
+    * outlive it.
+    */
+    ArrayView<int> getTriangleView() const;
+
+    /**
+    * Get total number of triangles of a STL file
+    */
+    int getTriangleCount();
 
     /**
     * Return a string with the total number of cells
@@ -132,6 +364,12 @@ class Model
     */
     Vector3D getCentre();
 
+    /**
+    * Get the corners of the bounding box of the vertices, returns false
+    * if the model has no vertices
+    */
+    bool getBounds(Vector3D &min, Vector3D &max);
+
     // Misc functions
 
     /**
@@ -140,9 +378,15 @@ class Model
     void copyToFile(std::string filename);
 
     /**
-    * Save current model to file
+    * Save current model to file, under the IDs it was loaded with
     */
     void saveToFile(std::string filename);
+
+    /**
+    * Save current model in the binary .modb format (see modbinary.h),
+    * returns false if the file cannot be written
+    */
+    bool saveBinary(std::string filename);
 };
 
 #endif /* MODEL_H */
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * @file modelpreview.h
+ * @brief Header file for the ModelPreview class
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#ifndef MODELPREVIEW_H
+#define MODELPREVIEW_H
+
+#include <string>
+#include <vector>
+
+#include "vector3d.h"
+
+class LoadProgress;
+
+/**
+ * Vertices sampled through a model file and their bounds, read without
+ * parsing the rest of the file so that something can be shown while the
+ * whole model loads. The bounds are those of the sample, which may miss
+ * the extremes of the model.
+ */
+class ModelPreview
+{
+  private:
+    std::vector<Vector3D> points;
+    Vector3D min;
+    Vector3D max;
+
+  public:
+    /**
+    * Add point to the sample, growing the bounds to include it
+    */
+    void add(const Vector3D &point);
+
+    /**
+    * Return true if no vertex was sampled
+    */
+    bool isEmpty() const { return this->points.empty(); }
+
+    /**
+    * Get the number of sampled vertices
+    */
+    int getPointCount() const { return this->points.size(); }
+
+    /**
+    * Get the sampled vertices, in file order
+    */
+    const std::vector<Vector3D> &getPoints() const { return this->points; }
+
+    /**
+    * Get the lower corner of the bounds (zero if empty)
+    */
+    Vector3D getMin() const { return this->min; }
+
+    /**
+    * Get the upper corner of the bounds (zero if empty)
+    */
+    Vector3D getMax() const { return this->max; }
+};
+
+/**
+ * Read up to sampleCount vertices spread evenly through the .mod or binary
+ * .mod file filename. Text files are sampled at evenly spaced offsets, each
+ * taking a vertex line among the few lines that follow it, so the cost
+ * depends on sampleCount rather than on the size of the file. STL files and
+ * files that cannot be read give an empty preview, as does cancelling
+ * progress while sampling.
+ */
+ModelPreview readModelPreview(const std::string &filename, int sampleCount,
+                              const LoadProgress *progress = nullptr);
+
+#endif /* MODELPREVIEW_H */
@@ -0,0 +1,106 @@
+/**
+ * @file modreader.h
+ * @brief Header file for the ModReader and ModVisitor classes
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef MODREADER_H
+#define MODREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "material.h"
+#include "vector3d.h"
+
+/**
+ * Receives the records of a .mod file from a ModReader, in file order.
+ * Override only the functions you need; the defaults do nothing.
+ * Cells are reported by vertex and material ID: a visitor that needs
+ * cell geometry has to keep the vertices it is interested in. Vertex and
+ * cell IDs are passed as read, as 64-bit values, so sparse or globally
+ * numbered IDs reach the visitor unchanged.
+ */
+class ModVisitor
+{
+  public:
+    virtual ~ModVisitor();
+
+    /**
+    * Called for every material line
+    */
+    virtual void visitMaterial(const Material &material);
+
+    /**
+    * Called for every vertex line
+    */
+    virtual void visitVertex(std::int64_t id, const Vector3D &vertex);
+
+    /**
+    * Called for every cell line (type is 'h', 'p' or 't').
+    * vertexIds is only valid for the duration of the call.
+    */
+    virtual void visitCell(std::int64_t id, char type, int materialId, const std::vector<std::int64_t> &vertexIds);
+};
+
+/**
+ * Streams a .mod file from a file or any std::istream (including pipes)
+ * to a ModVisitor, without building a Model. Memory use is bounded by the
+ * read buffer (grown only for lines longer than it), not by the file size.
+ */
+class ModReader
+{
+  private:
+    /**
+    * Stream owned by the reader when constructed from a filename
+    */
+    std::unique_ptr<std::ifstream> ownedStream;
+
+    /**
+    * Stream the records are read from
+    */
+    std::istream *stream;
+
+    /**
+    * Size of the blocks read from the stream
+    */
+    std::size_t blockSize;
+
+    /**
+    * Dispatch one line to the visitor
+    */
+    void parseLine(const char *begin, const char *end, ModVisitor &visitor, std::vector<std::int64_t> &vertexIds);
+
+  public:
+    /**
+    * Read from a file
+    */
+    ModReader(std::string filename, std::size_t blockSize = 1 << 20);
+
+    /**
+    * Read from an already open stream (not owned by the reader)
+    */
+    ModReader(std::istream &stream, std::size_t blockSize = 1 << 20);
+
+    ~ModReader();
+
+    /**
+    * Return true if the input could be opened
+    */
+    bool isOpen();
+
+    /**
+    * Read the whole input, calling the visitor for every record.
+    * Malformed lines are skipped. Returns false if the input is not open
+    * or a read error occurs.
+    */
+    bool read(ModVisitor &visitor);
+};
+
+#endif /* MODREADER_H */
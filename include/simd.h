@@ -0,0 +1,66 @@
+/**
+ * @file simd.h
+ * @brief Header file for the runtime detection of SIMD instruction sets
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+// SIMD kernels are compiled for x86 with compilers that can build
+// functions for a given instruction set and check at run time which ones
+// the processor supports, AVX-512 included: GCC 5, Clang 6 (for
+// __builtin_cpu_init) and Apple Clang 10 onwards. Elsewhere, or when built
+// with -DSIMD_DISPATCH=0, only scalar code is built
+#ifndef SIMD_DISPATCH
+#if !(defined(__x86_64__) || defined(__i386__))
+#define SIMD_DISPATCH 0
+#elif defined(__clang__) && defined(__apple_build_version__)
+#define SIMD_DISPATCH (__clang_major__ >= 10)
+#elif defined(__clang__)
+#define SIMD_DISPATCH (__clang_major__ >= 6)
+#elif defined(__GNUC__)
+#define SIMD_DISPATCH (__GNUC__ >= 5)
+#else
+#define SIMD_DISPATCH 0
+#endif
+#endif
+
+// Formulas shared by the scalar and SIMD kernels are forced inline, so
+// that they are compiled for the instruction set of the kernel using them
+#if defined(__GNUC__)
+#define SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define SIMD_INLINE inline
+#endif
+
+/**
+ * Instruction sets the SIMD kernels are built for, in increasing order
+ */
+enum class SimdLevel
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/**
+ * Get the best instruction set supported by this processor and build
+ * (detected once, thread-safe)
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * Get the level actually used when level is requested: level, lowered to
+ * what getSimdLevel() supports
+ */
+SimdLevel resolveSimdLevel(SimdLevel level);
+
+/**
+ * Get a printable name for level
+ */
+const char *getSimdLevelName(SimdLevel level);
+
+#endif /* SIMD_H */
@@ -8,11 +8,16 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
-#include <stdio.h>
+#include <cmath>
 #include <iostream>
+#include <type_traits>
 
 /**
  * 3D vector representation of a vertex.
+ *
+ * Header-only and trivially copyable: every operation is constexpr (but
+ * distance, which needs a square root) and inlines into the caller, and
+ * arrays of vectors can be copied with memcpy.
  */
 class Vector3D
 {
@@ -37,43 +42,42 @@ class Vector3D
     double z;
 
   public:
-    Vector3D();
-    Vector3D(double x, double y, double z);
-    ~Vector3D();
+    constexpr Vector3D() : x(0.0), y(0.0), z(0.0) {}
+    constexpr Vector3D(double x, double y, double z) : x(x), y(y), z(z) {}
 
     // Accessors
 
     /**
     * Return X coordinate
     */
-    double getX();
+    constexpr double getX() const { return this->x; }
 
     /**
     * Return Y coordinate
     */
-    double getY();
+    constexpr double getY() const { return this->y; }
 
     /**
     * Return Z coordinate
     */
-    double getZ();
+    constexpr double getZ() const { return this->z; }
 
     // Mutators
 
     /**
     * Set X coordinate
     */
-    void setX(double x);
+    constexpr void setX(double x) { this->x = x; }
 
     /**
     * Set Y coordinate
     */
-    void setY(double y);
+    constexpr void setY(double y) { this->y = y; }
 
     /**
     * Set Z coordinate
     */
-    void setZ(double z);
+    constexpr void setZ(double z) { this->z = z; }
 
     // Operator overloading
     // Note: rhs stands for right hand side
@@ -81,54 +85,91 @@ class Vector3D
     /**
     * Addition operation
     */
-    Vector3D operator+(Vector3D rhsVector);
+    constexpr Vector3D operator+(const Vector3D &rhsVector) const
+    {
+        return Vector3D(this->x + rhsVector.x, this->y + rhsVector.y, this->z + rhsVector.z);
+    }
 
     /**
     * Subtract operation
     */
-    Vector3D operator-(Vector3D rhsVector);
+    constexpr Vector3D operator-(const Vector3D &rhsVector) const
+    {
+        return Vector3D(this->x - rhsVector.x, this->y - rhsVector.y, this->z - rhsVector.z);
+    }
 
     /**
     * Equality operation
     */
-    friend bool operator==(const Vector3D &lhsVector, const Vector3D &rhsVector);
+    friend constexpr bool operator==(const Vector3D &lhsVector, const Vector3D &rhsVector)
+    {
+        return lhsVector.x == rhsVector.x && lhsVector.y == rhsVector.y && lhsVector.z == rhsVector.z;
+    }
 
     /**
     * Dot product (returns a single value)
     */
-    double dot(Vector3D rhsVector);
+    constexpr double dot(const Vector3D &rhsVector) const
+    {
+        return this->x * rhsVector.x + this->y * rhsVector.y + this->z * rhsVector.z;
+    }
 
     /**
     * Cross product (returns a Vector3D)
     */
-    Vector3D cross(Vector3D rhsVector);
+    constexpr Vector3D cross(const Vector3D &rhsVector) const
+    {
+        return Vector3D(this->y * rhsVector.z - this->z * rhsVector.y,
+                        this->z * rhsVector.x - this->x * rhsVector.z,
+                        this->x * rhsVector.y - this->y * rhsVector.x);
+    }
 
     /**
     * Scalar multiplication (Vector3D on left hand side)
     */
-    Vector3D operator*(double scalar);
+    constexpr Vector3D operator*(double scalar) const
+    {
+        return Vector3D(this->x * scalar, this->y * scalar, this->z * scalar);
+    }
 
     /**
     * Scalar multiplication (Vector3D on right hand side)
     */
-    friend Vector3D operator*(double scalar, Vector3D v);
+    friend constexpr Vector3D operator*(double scalar, const Vector3D &v)
+    {
+        return Vector3D(v.x * scalar, v.y * scalar, v.z * scalar);
+    }
 
     /**
     * Output Vector3D
     */
-    friend std::ostream &operator<<(std::ostream &os, Vector3D &v); // cout
+    friend std::ostream &operator<<(std::ostream &os, const Vector3D &v) // cout
+    {
+        return os << "[" << v.x << "," << v.y << "," << v.z << "]";
+    }
 
     // Misc functions
 
     /**
     * Return distance between two vertices
     */
-    double distance(Vector3D &v2);
+    double distance(const Vector3D &v2) const
+    {
+        // Distance between two 3D points:
+        // sqrt((x2-x1)^2+(y2-y1)^2+(z2-z1)^2)
+        Vector3D difference = v2 - *this;
+        return std::sqrt(difference.dot(difference));
+    }
 
     /**
     * Return midpoint between two vertices
     */
-    Vector3D midpoint(Vector3D &v2);
+    constexpr Vector3D midpoint(const Vector3D &v2) const
+    {
+        return Vector3D((this->x + v2.x) / 2, (this->y + v2.y) / 2, (this->z + v2.z) / 2);
+    }
 };
 
-#endif /* VECTOR_H */
\ No newline at end of file
+static_assert(std::is_trivially_copyable<Vector3D>::value, "Vector3D must stay trivially copyable");
+
+#endif /* VECTOR_H */
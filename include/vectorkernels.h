@@ -0,0 +1,105 @@
+/**
+ * @file vectorkernels.h
+ * @brief Header file for the vector formulas and their batch kernels over coordinate columns
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef VECTORKERNELS_H
+#define VECTORKERNELS_H
+
+#include "matrix.h"
+#include "simd.h"
+#include "vector3d.h"
+
+// Formulas shared by the scalar and SIMD kernels. T is double, or a SIMD
+// vector of doubles (one vector per lane); the operations are those of
+// Vector3D and Matrix3x3 in the same order, so every kernel rounds like
+// the single-vector code.
+
+/**
+ * Set result to a . b
+ */
+template <class T>
+SIMD_INLINE void dotProduct(T ax, T ay, T az, T bx, T by, T bz, T &result)
+{
+    result = ax * bx + ay * by + az * bz;
+}
+
+/**
+ * Set (x, y, z) to a x b
+ */
+template <class T>
+SIMD_INLINE void crossProduct(T ax, T ay, T az, T bx, T by, T bz, T &x, T &y, T &z)
+{
+    x = ay * bz - az * by;
+    y = az * bx - ax * bz;
+    z = ax * by - ay * bx;
+}
+
+/**
+ * Set (x, y, z) to m * (x, y, z) + d, m being 3x3 in row-major order
+ */
+template <class T>
+SIMD_INLINE void affineTransform(const T *m, const T *d, T &x, T &y, T &z)
+{
+    T vx = x;
+    T vy = y;
+    T vz = z;
+    x = (m[0] * vx + m[1] * vy + m[2] * vz) + d[0];
+    y = (m[3] * vx + m[4] * vy + m[5] * vz) + d[1];
+    z = (m[6] * vx + m[7] * vy + m[8] * vz) + d[2];
+}
+
+// Batch kernels. Vectors are given as x, y and z columns of Scalar (float
+// or double) and computed in double; count vectors are processed with the
+// best instruction set up to level that the processor supports, and every
+// level gives the same result as the matching Vector3D or Matrix3x3
+// operation applied to each vector.
+
+/**
+ * Set dots[i] to a[i] . b[i]
+ */
+template <class Scalar>
+void computeDots(const Scalar *ax, const Scalar *ay, const Scalar *az, const Scalar *bx, const Scalar *by,
+                 const Scalar *bz, int count, double *dots, SimdLevel level = SimdLevel::AVX512);
+
+/**
+ * Set (x[i], y[i], z[i]) to a[i] x b[i]
+ */
+template <class Scalar>
+void computeCrosses(const Scalar *ax, const Scalar *ay, const Scalar *az, const Scalar *bx, const Scalar *by,
+                    const Scalar *bz, int count, double *x, double *y, double *z, SimdLevel level = SimdLevel::AVX512);
+
+/**
+ * Set norms[i] to the length of v[i]
+ */
+template <class Scalar>
+void computeNorms(const Scalar *x, const Scalar *y, const Scalar *z, int count, double *norms,
+                  SimdLevel level = SimdLevel::AVX512);
+
+/**
+ * Set distances[i] to the distance between v[i] and point
+ */
+template <class Scalar>
+void computeDistances(const Scalar *x, const Scalar *y, const Scalar *z, int count, Vector3D point,
+                      double *distances, SimdLevel level = SimdLevel::AVX512);
+
+/**
+ * Set out[i] to matrix * v[i] + offset, rounded to Scalar. The output
+ * columns may be the input columns, to transform in place.
+ */
+template <class Scalar>
+void transformVectors(const Scalar *x, const Scalar *y, const Scalar *z, int count, const Matrix3x3 &matrix,
+                      Vector3D offset, Scalar *outX, Scalar *outY, Scalar *outZ, SimdLevel level = SimdLevel::AVX512);
+
+/**
+ * Set min and max to the corners of the axis-aligned bounding box of the
+ * vectors, returns false (leaving min and max unchanged) if count is 0.
+ * NaN coordinates are ignored unless the first vector has them.
+ */
+template <class Scalar>
+bool computeBounds(const Scalar *x, const Scalar *y, const Scalar *z, int count, Vector3D &min, Vector3D &max,
+                   SimdLevel level = SimdLevel::AVX512);
+
+#endif /* VECTORKERNELS_H */
@@ -0,0 +1,252 @@
+/**
+ * @file vertexarray.h
+ * @brief Header file for the BasicVertexRef and BasicVertexArray classes
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef VERTEXARRAY_H
+#define VERTEXARRAY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "arena.h"
+#include "vector3d.h"
+
+/**
+ * Reference to one vertex of a BasicVertexArray that behaves like a
+ * Vector3D: it converts to a Vector3D, and assigning a Vector3D stores it
+ * back into the columns (rounded to Scalar).
+ */
+template <class Scalar>
+class BasicVertexRef
+{
+  private:
+    Scalar *x;
+    Scalar *y;
+    Scalar *z;
+
+  public:
+    BasicVertexRef(Scalar *x, Scalar *y, Scalar *z) : x(x), y(y), z(z) {}
+
+    double getX() const { return *this->x; }
+    double getY() const { return *this->y; }
+    double getZ() const { return *this->z; }
+
+    void setX(double x) { *this->x = x; }
+    void setY(double y) { *this->y = y; }
+    void setZ(double z) { *this->z = z; }
+
+    operator Vector3D() const
+    {
+        return Vector3D(*this->x, *this->y, *this->z);
+    }
+
+    BasicVertexRef &operator=(Vector3D v)
+    {
+        *this->x = v.getX();
+        *this->y = v.getY();
+        *this->z = v.getZ();
+        return *this;
+    }
+
+    BasicVertexRef &operator=(const BasicVertexRef &other)
+    {
+        return *this = (Vector3D)other;
+    }
+};
+
+typedef BasicVertexRef<double> VertexRef;
+
+/**
+ * Vertex positions stored as a structure of arrays: separate x, y and z
+ * columns of Scalar (float or double), each aligned to a cache line and
+ * optionally held in an Arena. Whole-array passes run over the columns:
+ * bounds and transforms through the batch kernels of vectorkernels.h,
+ * the others as plain loops that the compiler can vectorize; sums and
+ * transforms are computed in double whatever the Scalar. Single
+ * vertices are read as Vector3D values or through a BasicVertexRef.
+ */
+template <class Scalar>
+class BasicVertexArray
+{
+  public:
+    /**
+    * Alignment of each column in bytes
+    */
+    static const std::size_t ALIGNMENT = 64;
+
+    /**
+    * Storage type of a column
+    */
+    typedef std::vector<Scalar, ArenaAllocator<Scalar, ALIGNMENT>> Column;
+
+  private:
+    Column x;
+    Column y;
+    Column z;
+
+  public:
+    BasicVertexArray() {}
+
+    /**
+    * Allocate the columns from arena (the heap if nullptr), which must
+    * outlive the array
+    */
+    explicit BasicVertexArray(Arena *arena) : x(arena), y(arena), z(arena) {}
+
+    /**
+    * Copy a std::vector of vertices into columns
+    */
+    explicit BasicVertexArray(const std::vector<Vector3D> &vertices);
+
+    // Size
+
+    /**
+    * Get number of vertices
+    */
+    int size() const { return this->x.size(); }
+
+    /**
+    * Return true if there are no vertices
+    */
+    bool empty() const { return this->x.empty(); }
+
+    /**
+    * Resize to count vertices, new vertices are at the origin
+    */
+    void resize(int count);
+
+    /**
+    * Make room for count vertices
+    */
+    void reserve(int count);
+
+    /**
+    * Remove all vertices
+    */
+    void clear();
+
+    /**
+    * Append a vertex
+    */
+    void push_back(Scalar x, Scalar y, Scalar z)
+    {
+        this->x.push_back(x);
+        this->y.push_back(y);
+        this->z.push_back(z);
+    }
+
+    /**
+    * Append a vertex
+    */
+    void push_back(Vector3D v)
+    {
+        push_back((Scalar)v.getX(), (Scalar)v.getY(), (Scalar)v.getZ());
+    }
+
+    // Element access
+
+    /**
+    * Get position of vertex i
+    */
+    Vector3D get(int i) const
+    {
+        return Vector3D(this->x[i], this->y[i], this->z[i]);
+    }
+
+    /**
+    * Set position of vertex i
+    */
+    void set(int i, Scalar x, Scalar y, Scalar z)
+    {
+        this->x[i] = x;
+        this->y[i] = y;
+        this->z[i] = z;
+    }
+
+    /**
+    * Get position of vertex i
+    */
+    Vector3D operator[](int i) const
+    {
+        return get(i);
+    }
+
+    /**
+    * Get a reference to vertex i
+    */
+    BasicVertexRef<Scalar> operator[](int i)
+    {
+        return BasicVertexRef<Scalar>(&this->x[i], &this->y[i], &this->z[i]);
+    }
+
+    // Column access
+
+    /**
+    * Get the x column
+    */
+    const Scalar *getX() const { return this->x.data(); }
+    Scalar *getX() { return this->x.data(); }
+
+    /**
+    * Get the y column
+    */
+    const Scalar *getY() const { return this->y.data(); }
+    Scalar *getY() { return this->y.data(); }
+
+    /**
+    * Get the z column
+    */
+    const Scalar *getZ() const { return this->z.data(); }
+    Scalar *getZ() { return this->z.data(); }
+
+    /**
+    * Replace the vertices by count vertices read from double columns
+    */
+    void assign(const double *x, const double *y, const double *z, int count);
+
+    /**
+    * Get number of bytes used by the columns
+    */
+    std::size_t getMemorySize() const;
+
+    /**
+    * Copy the vertices into a std::vector<Vector3D>
+    */
+    std::vector<Vector3D> toVector() const;
+
+    // Whole-array passes
+
+    /**
+    * Get the corners of the axis-aligned bounding box, returns false
+    * (leaving min and max unchanged) if there are no vertices
+    */
+    bool getBounds(Vector3D &min, Vector3D &max) const;
+
+    /**
+    * Get the mean position of the vertices (the origin if there are none)
+    */
+    Vector3D getCentroid() const;
+
+    /**
+    * Move every vertex by offset
+    */
+    void translate(Vector3D offset);
+
+    /**
+    * Scale every vertex about the origin by factor
+    */
+    void scale(double factor);
+
+    /**
+    * Replace every vertex v by matrix * v + offset, matrix being 3x3 in
+    * row-major order
+    */
+    void transform(const double matrix[9], Vector3D offset);
+};
+
+typedef BasicVertexArray<double> VertexArray;
+
+#endif /* VERTEXARRAY_H */
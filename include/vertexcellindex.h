@@ -0,0 +1,141 @@
+/**
+ * @file vertexcellindex.h
+ * @brief Header file for the VertexCellIndex class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef VERTEXCELLINDEX_H
+#define VERTEXCELLINDEX_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "arrayview.h"
+
+class CellStore;
+
+/**
+ * Reverse incidence of the cells: for each vertex, the IDs of the cells
+ * that use it, in increasing order, in compressed sparse row form. A cell
+ * that repeats a vertex (a collapsed cell) is listed once for it.
+ */
+class VertexCellIndex
+{
+  private:
+    /**
+    * First entry of each vertex, followed by the number of entries
+    */
+    std::vector<int> offsets;
+
+    /**
+    * Cells of each vertex
+    */
+    std::vector<int> cells;
+
+  public:
+    VertexCellIndex() : offsets(1, 0) {}
+
+    /**
+    * Build from the rows, offsets having one more element than there
+    * are vertices
+    */
+    VertexCellIndex(std::vector<int> offsets, std::vector<int> cells);
+
+    /**
+    * Get number of vertices
+    */
+    int getVertexCount() const { return this->offsets.size() - 1; }
+
+    /**
+    * Get total number of entries (cell vertices, less repeated ones)
+    */
+    int getEntryCount() const { return this->cells.size(); }
+
+    /**
+    * Get number of cells using vertex id
+    */
+    int getCellCount(int id) const { return this->offsets[id + 1] - this->offsets[id]; }
+
+    /**
+    * Get the IDs of the cells using vertex id, in increasing order
+    */
+    ArrayView<int> getCells(int id) const
+    {
+        return ArrayView<int>(this->cells.data() + this->offsets[id], getCellCount(id));
+    }
+
+    /**
+    * Get the row offsets, one per vertex followed by the entry count
+    */
+    const std::vector<int> &getOffsets() const { return this->offsets; }
+
+    /**
+    * Get the entries of all rows
+    */
+    const std::vector<int> &getEntries() const { return this->cells; }
+};
+
+/**
+ * Build the vertex-to-cell index of cells, whose vertex IDs must be less
+ * than vertexCount, on threadCount threads (0 means one per hardware
+ * thread): the cells of each vertex are counted in parallel, the counts
+ * turned into offsets by a parallel prefix sum, and the cells written to
+ * their rows in parallel, each row then being sorted. The result does not
+ * depend on the thread count.
+ */
+VertexCellIndex buildVertexCellIndex(const CellStore &cells, int vertexCount, int threadCount);
+
+/**
+ * VertexCellIndex built on first use and kept alongside the cells it
+ * indexes. Copies start empty, as the copied cells may then change on
+ * their own; moves take the index along. get is safe to call from several
+ * threads at once, but copying or moving is not while it runs.
+ */
+class VertexCellIndexCache
+{
+  private:
+    mutable std::mutex mutex;
+    mutable std::shared_ptr<const VertexCellIndex> index;
+
+  public:
+    VertexCellIndexCache() = default;
+    VertexCellIndexCache(const VertexCellIndexCache &) {}
+    VertexCellIndexCache(VertexCellIndexCache &&other) : index(std::move(other.index)) {}
+
+    VertexCellIndexCache &operator=(const VertexCellIndexCache &other)
+    {
+        if (this != &other)
+        {
+            this->index.reset();
+        }
+        return *this;
+    }
+
+    VertexCellIndexCache &operator=(VertexCellIndexCache &&other)
+    {
+        if (this != &other)
+        {
+            this->index = std::move(other.index);
+        }
+        return *this;
+    }
+
+    /**
+    * Get the index, calling build (returning a VertexCellIndex) first if
+    * there is none yet
+    */
+    template <class Build>
+    const VertexCellIndex &get(Build build) const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->index)
+        {
+            this->index = std::make_shared<const VertexCellIndex>(build());
+        }
+        return *this->index;
+    }
+};
+
+#endif /* VERTEXCELLINDEX_H */
@@ -0,0 +1,209 @@
+/**
+ * @file vertexstore.h
+ * @brief Header file for the VertexStore class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef VERTEXSTORE_H
+#define VERTEXSTORE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "arena.h"
+#include "vector3d.h"
+#include "vertexarray.h"
+
+/**
+ * Scalar type used to store vertex coordinates
+ */
+enum class Precision
+{
+    Double,
+    Single
+};
+
+/**
+ * Vertices of a model, stored in the precision chosen when the model is
+ * loaded: double columns, or float columns at half the memory for
+ * display-only use. Single vertices are read and written as doubles;
+ * kernels that want the columns themselves call visit(), which passes the
+ * BasicVertexArray of the stored precision, so that they are compiled
+ * once per Scalar and branch once per call rather than per vertex.
+ */
+class VertexStore
+{
+  private:
+    Precision precision;
+
+    /**
+    * Vertices when stored in double precision (empty otherwise)
+    */
+    BasicVertexArray<double> doubleVertices;
+
+    /**
+    * Vertices when stored in single precision (empty otherwise)
+    */
+    BasicVertexArray<float> singleVertices;
+
+  public:
+    VertexStore() : precision(Precision::Double) {}
+
+    /**
+    * Store vertices in the given precision, allocating from arena (the
+    * heap if nullptr), which must outlive the store
+    */
+    VertexStore(Arena *arena, Precision precision)
+        : precision(precision), doubleVertices(arena), singleVertices(arena) {}
+
+    /**
+    * Get precision of the stored coordinates
+    */
+    Precision getPrecision() const { return this->precision; }
+
+    /**
+    * Call function with the BasicVertexArray of the stored precision
+    */
+    template <class Function>
+    void visit(Function function) const
+    {
+        if (this->precision == Precision::Single)
+        {
+            function(this->singleVertices);
+        }
+        else
+        {
+            function(this->doubleVertices);
+        }
+    }
+
+    /**
+    * Call function with the BasicVertexArray of the stored precision, for writing
+    */
+    template <class Function>
+    void visit(Function function)
+    {
+        if (this->precision == Precision::Single)
+        {
+            function(this->singleVertices);
+        }
+        else
+        {
+            function(this->doubleVertices);
+        }
+    }
+
+    // Size
+
+    /**
+    * Get number of vertices
+    */
+    int size() const
+    {
+        return this->precision == Precision::Single ? this->singleVertices.size() : this->doubleVertices.size();
+    }
+
+    /**
+    * Return true if there are no vertices
+    */
+    bool empty() const { return size() == 0; }
+
+    /**
+    * Resize to count vertices, new vertices are at the origin
+    */
+    void resize(int count);
+
+    /**
+    * Make room for count vertices
+    */
+    void reserve(int count);
+
+    /**
+    * Remove all vertices
+    */
+    void clear();
+
+    // Element access
+
+    /**
+    * Append a vertex (rounded to the stored precision)
+    */
+    void push_back(double x, double y, double z)
+    {
+        if (this->precision == Precision::Single)
+        {
+            this->singleVertices.push_back((float)x, (float)y, (float)z);
+        }
+        else
+        {
+            this->doubleVertices.push_back(x, y, z);
+        }
+    }
+
+    /**
+    * Set position of vertex i (rounded to the stored precision)
+    */
+    void set(int i, double x, double y, double z)
+    {
+        if (this->precision == Precision::Single)
+        {
+            this->singleVertices.set(i, (float)x, (float)y, (float)z);
+        }
+        else
+        {
+            this->doubleVertices.set(i, x, y, z);
+        }
+    }
+
+    /**
+    * Get position of vertex i
+    */
+    Vector3D get(int i) const
+    {
+        return this->precision == Precision::Single ? this->singleVertices.get(i) : this->doubleVertices.get(i);
+    }
+
+    /**
+    * Get position of vertex i
+    */
+    Vector3D operator[](int i) const
+    {
+        return get(i);
+    }
+
+    /**
+    * Replace the vertices by count vertices read from double columns
+    */
+    void assign(const double *x, const double *y, const double *z, int count);
+
+    /**
+    * Get the vertices as double columns, nullptr if stored in single precision
+    */
+    const BasicVertexArray<double> *getDoubleArray() const;
+
+    /**
+    * Get the vertices as float columns, nullptr if stored in double precision
+    */
+    const BasicVertexArray<float> *getSingleArray() const;
+
+    /**
+    * Get number of bytes used by the coordinates
+    */
+    std::size_t getMemorySize() const;
+
+    /**
+    * Copy the vertices into a std::vector<Vector3D>
+    */
+    std::vector<Vector3D> toVector() const;
+
+    // Whole-array passes, see BasicVertexArray
+
+    bool getBounds(Vector3D &min, Vector3D &max) const;
+    Vector3D getCentroid() const;
+    void translate(Vector3D offset);
+    void scale(double factor);
+    void transform(const double matrix[9], Vector3D offset);
+};
+
+#endif /* VERTEXSTORE_H */
@@ -0,0 +1,80 @@
+/**
+ * @file volumekernels.h
+ * @brief Header file for the hexahedron volume formula and its batch kernels
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef VOLUMEKERNELS_H
+#define VOLUMEKERNELS_H
+
+#include "simd.h"
+
+/**
+ * Set result to a . (b x c), vectors being given as x, y, z components
+ */
+template <class T>
+SIMD_INLINE void tripleProduct(const T *a, const T *b, const T *c, T &result)
+{
+    result = a[0] * (b[1] * c[2] - b[2] * c[1]) +
+             a[1] * (b[2] * c[0] - b[0] * c[2]) +
+             a[2] * (b[0] * c[1] - b[1] * c[0]);
+}
+
+/**
+ * Set volume to the volume of the hexahedron with vertices (x[i], y[i],
+ * z[i]), in .mod order: 0-1-2-3 the bottom face, 4-5-6-7 the top face
+ * with vertex 4 above vertex 0. The volume is signed, positive when the
+ * bottom face is counter-clockwise seen from the top face.
+ *
+ * Faces need not be planar. The result is the volume of the consistent
+ * decomposition into 24 tetrahedra that splits every face into four
+ * triangles about its centroid and joins them to the cell centroid, so
+ * that neighbouring cells split their shared face the same way; this is
+ * also the exact volume of the trilinear hexahedron. Summed in closed
+ * form with B, C, D the sums of the vertices along the three edge
+ * directions and E, F, G the sums along the twist directions:
+ *
+ *   V = B . (C x D) / 64 + (B . (E x G) - C . (E x F) - D . (F x G)) / 192
+ *
+ * T is double, or a SIMD vector of doubles (one hexahedron per lane) on
+ * compilers that provide arithmetic operators for vector types. The
+ * operations are the same in both cases, so all kernels round alike.
+ */
+template <class T>
+SIMD_INLINE void hexahedronVolume(const T *x, const T *y, const T *z, T &volume)
+{
+    const T *p[3] = {x, y, z};
+    T b[3], c[3], d[3], e[3], f[3], g[3];
+    for (int k = 0; k < 3; k++)
+    {
+        const T *v = p[k];
+        b[k] = ((v[1] + v[2]) + (v[5] + v[6])) - ((v[0] + v[3]) + (v[4] + v[7]));
+        c[k] = ((v[2] + v[3]) + (v[6] + v[7])) - ((v[0] + v[1]) + (v[4] + v[5]));
+        d[k] = ((v[4] + v[5]) + (v[6] + v[7])) - ((v[0] + v[1]) + (v[2] + v[3]));
+        e[k] = ((v[0] + v[2]) + (v[4] + v[6])) - ((v[1] + v[3]) + (v[5] + v[7]));
+        f[k] = ((v[0] + v[1]) + (v[6] + v[7])) - ((v[2] + v[3]) + (v[4] + v[5]));
+        g[k] = ((v[0] + v[3]) + (v[5] + v[6])) - ((v[1] + v[2]) + (v[4] + v[7]));
+    }
+
+    T bcd, beg, cef, dfg;
+    tripleProduct(b, c, d, bcd);
+    tripleProduct(b, e, g, beg);
+    tripleProduct(c, e, f, cef);
+    tripleProduct(d, f, g, dfg);
+    volume = bcd * (1.0 / 64) + ((beg - cef) - dfg) * (1.0 / 192);
+}
+
+/**
+ * Compute the volume of count hexahedra into volumes. The vertex IDs of
+ * hexahedron i are vertexIds[8 * i] to vertexIds[8 * i + 7], indices into
+ * the coordinate columns x, y and z. Several hexahedra are computed at
+ * once with the best instruction set up to level that the processor
+ * supports (AVX2 or AVX-512; SSE2 and Scalar use the scalar loop). Every
+ * level gives the same result as hexahedronVolume.
+ */
+template <class Scalar>
+void computeHexahedronVolumes(const int *vertexIds, int count, const Scalar *x, const Scalar *y, const Scalar *z,
+                              double *volumes, SimdLevel level = SimdLevel::AVX512);
+
+#endif /* VOLUMEKERNELS_H */
@@ -0,0 +1,91 @@
+/**
+ * @file arena.cpp
+ * @brief Source file for the Arena class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <new>
+
+#include "arena.h"
+
+const std::size_t Arena::DEFAULT_BLOCK_SIZE;
+
+Arena::Arena(std::size_t blockSize)
+{
+    this->blockSize = blockSize;
+    this->current = nullptr;
+    this->limit = nullptr;
+    this->bytesAllocated = 0;
+    this->bytesReserved = 0;
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+void *Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    std::size_t address = ((std::size_t)this->current + alignment - 1) & ~(alignment - 1);
+    if (this->current == nullptr || address + size > (std::size_t)this->limit)
+    {
+        // Large requests get a block of their own so that the current
+        // block is not abandoned half used
+        std::size_t newBlockSize = size + alignment > this->blockSize / 2 ? size + alignment : this->blockSize;
+        char *block = (char *)::operator new(newBlockSize);
+        this->blocks.push_back(block);
+        this->bytesReserved += newBlockSize;
+
+        address = ((std::size_t)block + alignment - 1) & ~(alignment - 1);
+        if (newBlockSize == this->blockSize)
+        {
+            this->current = block;
+            this->limit = block + newBlockSize;
+        }
+        else
+        {
+            this->bytesAllocated += size;
+            return (void *)address;
+        }
+    }
+
+    this->current = (char *)(address + size);
+    this->bytesAllocated += size;
+    return (void *)address;
+}
+
+void Arena::release()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    for (int i = 0; i < this->blocks.size(); i++)
+    {
+        ::operator delete(this->blocks[i]);
+    }
+    this->blocks.clear();
+    this->current = nullptr;
+    this->limit = nullptr;
+    this->bytesAllocated = 0;
+    this->bytesReserved = 0;
+}
+
+std::size_t Arena::getBytesAllocated()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->bytesAllocated;
+}
+
+std::size_t Arena::getBytesReserved()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->bytesReserved;
+}
+
+int Arena::getBlockCount()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->blocks.size();
+}
@@ -0,0 +1,188 @@
+/**
+ * @file boundarysurface.cpp
+ * @brief Source file for the BoundarySurface class and its parallel extraction
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "boundarysurface.h"
+
+#include <cmath>
+#include <utility>
+
+#include "cell.h"
+#include "cellstore.h"
+#include "faceadjacency.h"
+#include "loadprogress.h"
+#include "massproperties.h"
+#include "parallel.h"
+#include "vertexstore.h"
+
+// Number of faces whose areas are summed together; blocks are then
+// combined in order, whatever thread summed them
+static const int AREA_BLOCK_SIZE = 4096;
+
+BoundarySurface::BoundarySurface(std::vector<int> offsets, std::vector<int> vertexIds, std::vector<int> cellIds,
+                                 std::vector<int> materialIds, double area)
+    : offsets(std::move(offsets)), vertexIds(std::move(vertexIds)), cellIds(std::move(cellIds)),
+      materialIds(std::move(materialIds)), triangleCount(0), area(area)
+{
+    for (int i = 0; i < getFaceCount(); i++)
+    {
+        if (getVertexCount(i) == 3)
+        {
+            this->triangleCount++;
+        }
+    }
+}
+
+// Get the faces of a cell type, as in Shape::FACES (nullptr for unused IDs)
+static const int (*getShapeFaces(char type))[4]
+{
+    switch (type)
+    {
+    case Tetrahedron::TYPE:
+        return Tetrahedron::FACES;
+    case Pyramid::TYPE:
+        return Pyramid::FACES;
+    case Hexahedron::TYPE:
+        return Hexahedron::FACES;
+    default:
+        return nullptr;
+    }
+}
+
+static int getFaceVertexCount(const int *face)
+{
+    return face[3] < 0 ? 3 : 4;
+}
+
+// Area of a triangle or of a quadrilateral split along its 0-2 diagonal
+static double getFaceArea(const VertexStore &vertices, ArrayView<int> vertexIds)
+{
+    Vector3D first = vertices.get(vertexIds[0]);
+    double area = 0;
+    for (int k = 1; k + 1 < vertexIds.size(); k++)
+    {
+        Vector3D normal = (vertices.get(vertexIds[k]) - first).cross(vertices.get(vertexIds[k + 1]) - first);
+        area += 0.5 * std::sqrt(normal.dot(normal));
+    }
+    return area;
+}
+
+BoundarySurface extractBoundarySurface(const CellStore &cells, const VertexStore &vertices,
+                                       const FaceAdjacency &adjacency, int threadCount,
+                                       const LoadProgress *progress)
+{
+    int cellCount = cells.getCellCount();
+    threadCount = resolveThreadCount(threadCount);
+    if (threadCount > cellCount)
+    {
+        threadCount = cellCount > 0 ? cellCount : 1;
+    }
+
+    // The adjacency of a cancelled build is empty
+    if (isLoadCancelled(progress))
+    {
+        return BoundarySurface();
+    }
+
+    // First face and first vertex index of each cell, from its boundary
+    // faces by prefix sums
+    std::vector<int> faceStarts(cellCount + 1);
+    std::vector<int> vertexStarts(cellCount + 1);
+    parallelFor(threadCount, [&](int thread) {
+        int first = (long long)cellCount * thread / threadCount;
+        int last = (long long)cellCount * (thread + 1) / threadCount;
+        for (int id = first; id < last; id++)
+        {
+            const int(*faces)[4] = getShapeFaces(cells.getType(id));
+            const int *neighbours = adjacency.getNeighbours(id);
+            int faceCount = 0;
+            int vertexCount = 0;
+            for (int face = 0; face < adjacency.getFaceCount(id); face++)
+            {
+                if (neighbours[face] == FaceAdjacency::BOUNDARY)
+                {
+                    faceCount++;
+                    vertexCount += getFaceVertexCount(faces[face]);
+                }
+            }
+            faceStarts[id] = faceCount;
+            vertexStarts[id] = vertexCount;
+        }
+    });
+    int faceCount = parallelExclusiveScan(faceStarts.data(), cellCount, threadCount);
+    int vertexCount = parallelExclusiveScan(vertexStarts.data(), cellCount, threadCount);
+    if (isLoadCancelled(progress))
+    {
+        return BoundarySurface();
+    }
+
+    std::vector<int> offsets(faceCount + 1);
+    std::vector<int> vertexIds(vertexCount);
+    std::vector<int> cellIds(faceCount);
+    std::vector<int> materialIds(faceCount);
+    offsets[faceCount] = vertexCount;
+    parallelFor(threadCount, [&](int thread) {
+        int first = (long long)cellCount * thread / threadCount;
+        int last = (long long)cellCount * (thread + 1) / threadCount;
+        for (int id = first; id < last; id++)
+        {
+            const int(*faces)[4] = getShapeFaces(cells.getType(id));
+            const int *neighbours = adjacency.getNeighbours(id);
+            const int *cellVertexIds = cells.getVertexIds(id);
+            int i = faceStarts[id];
+            int position = vertexStarts[id];
+            for (int face = 0; face < adjacency.getFaceCount(id); face++)
+            {
+                if (neighbours[face] == FaceAdjacency::BOUNDARY)
+                {
+                    offsets[i] = position;
+                    cellIds[i] = id;
+                    materialIds[i] = cells.getMaterialId(id);
+                    for (int k = 0; k < getFaceVertexCount(faces[face]); k++)
+                    {
+                        vertexIds[position++] = cellVertexIds[faces[face][k]];
+                    }
+                    i++;
+                }
+            }
+        }
+    });
+
+    if (isLoadCancelled(progress))
+    {
+        return BoundarySurface();
+    }
+
+    // Sum the areas of each block of faces, then the blocks in order
+    int blockCount = (faceCount + AREA_BLOCK_SIZE - 1) / AREA_BLOCK_SIZE;
+    std::vector<CompensatedSum> blockAreas(blockCount);
+    int areaThreadCount = threadCount < blockCount ? threadCount : (blockCount > 0 ? blockCount : 1);
+    parallelFor(areaThreadCount, [&](int thread) {
+        int firstBlock = (long long)blockCount * thread / areaThreadCount;
+        int lastBlock = (long long)blockCount * (thread + 1) / areaThreadCount;
+        for (int b = firstBlock; b < lastBlock && !isLoadCancelled(progress); b++)
+        {
+            int end = (b + 1) * AREA_BLOCK_SIZE < faceCount ? (b + 1) * AREA_BLOCK_SIZE : faceCount;
+            for (int i = b * AREA_BLOCK_SIZE; i < end; i++)
+            {
+                ArrayView<int> faceVertexIds(vertexIds.data() + offsets[i], offsets[i + 1] - offsets[i]);
+                blockAreas[b].add(getFaceArea(vertices, faceVertexIds));
+            }
+        }
+    });
+    if (isLoadCancelled(progress))
+    {
+        return BoundarySurface();
+    }
+    CompensatedSum area;
+    for (const CompensatedSum &blockArea : blockAreas)
+    {
+        area.add(blockArea);
+    }
+
+    return BoundarySurface(std::move(offsets), std::move(vertexIds), std::move(cellIds), std::move(materialIds),
+                           area.getValue());
+}
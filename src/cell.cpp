@@ -7,35 +7,178 @@
  */
 
 #include <sstream>
+#include <utility>
 #include "cell.h"
 #include "iostream"
 #include <vector>
 #include "vector3d.h"
+#include "volumekernels.h"
+
+const int Cell::MAX_VERTEX_COUNT;
+const char Pyramid::TYPE;
+const int Pyramid::VERTEX_COUNT;
+const char Hexahedron::TYPE;
+const int Hexahedron::VERTEX_COUNT;
+const char Tetrahedron::TYPE;
+const int Tetrahedron::VERTEX_COUNT;
+const int Pyramid::FACE_COUNT;
+const int Hexahedron::FACE_COUNT;
+const int Tetrahedron::FACE_COUNT;
+
+const int Pyramid::FACES[5][4] = {{0, 3, 2, 1}, {0, 1, 4, -1}, {1, 2, 4, -1}, {2, 3, 4, -1}, {3, 0, 4, -1}};
+const int Hexahedron::FACES[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+                                     {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+const int Tetrahedron::FACES[4][4] = {{0, 2, 1, -1}, {0, 1, 3, -1}, {1, 2, 3, -1}, {2, 0, 3, -1}};
+
+Cell::Cell()
+{
+    this->type = 0;
+    this->vertexPool = nullptr;
+    this->vertexCount = 0;
+    this->materialPool = nullptr;
+    this->materialId = -1;
+}
 
-Cell::Cell() {}
 Cell::~Cell() {}
 
-double Cell::getVolume() 
+void Cell::setVertices(const std::vector<Vector3D> &vertices, int count)
+{
+    this->vertexPool = nullptr;
+    this->vertexCount = count;
+    for (int i = 0; i < count; i++)
+    {
+        this->vertices.push_back(vertices[i]);
+        this->vertexIds[i] = i;
+    }
+}
+
+void Cell::setVertices(const int *vertexIds, const VertexStore *vertexPool, int count)
+{
+    this->vertexPool = vertexPool;
+    this->vertexCount = count;
+    for (int i = 0; i < count; i++)
+    {
+        this->vertexIds[i] = vertexIds[i];
+    }
+}
+
+void Cell::setMaterial(const Material &material)
+{
+    this->materialPool = nullptr;
+    this->materialId = 0;
+    this->material = material;
+}
+
+void Cell::setMaterial(int materialId, const MaterialTable *materialPool)
+{
+    this->materialPool = materialPool;
+    this->materialId = materialId;
+}
+
+char Cell::getType()
+{
+    return this->type;
+}
+
+int Cell::getVertexCount()
+{
+    return this->vertexCount;
+}
+
+std::vector<int> Cell::getVertexIds()
+{
+    return std::vector<int>(this->vertexIds, this->vertexIds + this->vertexCount);
+}
+
+ArrayView<int> Cell::getVertexIdView() const
 {
-	return 0;
+    return ArrayView<int>(this->vertexIds, this->vertexCount);
+}
+
+// Volume of a cell of type Shape. The vertex array is built from its
+// initializers instead of being zeroed first and then overwritten.
+template <class Shape, std::size_t... Indices>
+static double computeShapeVolume(const Cell &cell, std::index_sequence<Indices...>)
+{
+    Vector3D positions[Shape::VERTEX_COUNT] = {cell.getVertex(Indices)...};
+    return Shape::computeVolume(positions);
+}
+
+template <class Shape>
+static double computeShapeVolume(const Cell &cell)
+{
+    return computeShapeVolume<Shape>(cell, std::make_index_sequence<Shape::VERTEX_COUNT>());
+}
+
+double Cell::getVolume()
+{
+    // Empty cells have no volume
+    if (this->vertexCount == 0)
+    {
+        return 0;
+    }
+
+    switch (this->type)
+    {
+    case Pyramid::TYPE:
+        return computeShapeVolume<Pyramid>(*this);
+    case Hexahedron::TYPE:
+        return computeShapeVolume<Hexahedron>(*this);
+    case Tetrahedron::TYPE:
+        return computeShapeVolume<Tetrahedron>(*this);
+    default:
+        return 0;
+    }
 }
 
 double Cell::getMass()
 {
     double volume = this->getVolume();
-    double density = this->material.getDensity();
+    double density = 0;
+    if (this->materialPool != nullptr)
+    {
+        density = this->materialPool->getDensity(this->materialId);
+    }
+    else
+    {
+        density = this->material.getDensity();
+    }
     double mass = density * volume;
     return mass;
 }
 
 Material Cell::getMaterial()
 {
+    if (this->materialPool != nullptr)
+    {
+        return this->materialPool->get(this->materialId);
+    }
     return this->material;
 }
 
+const Material &Cell::getMaterialView() const
+{
+    if (this->materialPool != nullptr)
+    {
+        return this->materialPool->get(this->materialId);
+    }
+    return this->material;
+}
+
+int Cell::getMaterialId()
+{
+    return this->materialId;
+}
+
 std::vector<Vector3D> Cell::getVertices()
 {
-    return this->vertices;
+    std::vector<Vector3D> positions;
+    positions.reserve(this->vertexCount);
+    for (int i = 0; i < this->vertexCount; i++)
+    {
+        positions.push_back(getVertex(i));
+    }
+    return positions;
 }
 
 Vector3D Cell::getCentre()
@@ -44,83 +187,287 @@ Vector3D Cell::getCentre()
     double y_sum = 0;
     double z_sum = 0;
 
-    for (int i = 0; i < this->vertices.size(); i++)
+    for (int i = 0; i < this->vertexCount; i++)
     {
-        x_sum += this->vertices[i].getX();
-        y_sum += this->vertices[i].getY();
-        z_sum += this->vertices[i].getZ();
+        Vector3D vertex = getVertex(i);
+        x_sum += vertex.getX();
+        y_sum += vertex.getY();
+        z_sum += vertex.getZ();
     }
 
-    double x = x_sum / this->vertices.size();
-    double y = y_sum / this->vertices.size();
-    double z = z_sum / this->vertices.size();
+    double x = x_sum / this->vertexCount;
+    double y = y_sum / this->vertexCount;
+    double z = z_sum / this->vertexCount;
 
     Vector3D centre(x, y, z);
     return centre;
 }
 
-Pyramid::Pyramid(std::vector<Vector3D> &vertices, Material &material)
+// Tetrahedral decompositions used by the moment formulas, as indices into
+// a list of points: the vertices of the cell followed by the centroids
+// its faces and body are split about (see hexahedronVolume)
+static const int TETRAHEDRON_SPLIT[1][4] = {{0, 1, 2, 3}};
+
+// Base centroid (point 5) joined to each base edge and the apex
+static const int PYRAMID_SPLIT[4][4] = {{5, 0, 1, 4}, {5, 1, 2, 4}, {5, 2, 3, 4}, {5, 3, 0, 4}};
+
+// Cell centroid (point 8) joined to each face edge and that face's
+// centroid (points 9 to 14), faces in the order of Hexahedron::FACES
+static const int HEXAHEDRON_SPLIT[24][4] = {
+    {8, 0, 3, 9}, {8, 3, 2, 9}, {8, 2, 1, 9}, {8, 1, 0, 9},
+    {8, 4, 5, 10}, {8, 5, 6, 10}, {8, 6, 7, 10}, {8, 7, 4, 10},
+    {8, 0, 1, 11}, {8, 1, 5, 11}, {8, 5, 4, 11}, {8, 4, 0, 11},
+    {8, 1, 2, 12}, {8, 2, 6, 12}, {8, 6, 5, 12}, {8, 5, 1, 12},
+    {8, 2, 3, 13}, {8, 3, 7, 13}, {8, 7, 6, 13}, {8, 6, 2, 13},
+    {8, 3, 0, 14}, {8, 0, 4, 14}, {8, 4, 7, 14}, {8, 7, 3, 14}};
+
+// Points of the decomposition of a cell, relative to origin
+static void loadPoints(const Vector3D *vertices, int count, Vector3D origin, double points[][3])
 {
-    for (int i = 0; i < 5; i++)
+    double o[3] = {origin.getX(), origin.getY(), origin.getZ()};
+    for (int i = 0; i < count; i++)
     {
-        this->vertices.push_back(vertices[i]);
+        Vector3D v = vertices[i];
+        points[i][0] = v.getX() - o[0];
+        points[i][1] = v.getY() - o[1];
+        points[i][2] = v.getZ() - o[2];
     }
-    this->material = material;
 }
 
-Pyramid::Pyramid() {}
+static void loadPyramidPoints(const Vector3D *vertices, Vector3D origin, double points[6][3])
+{
+    loadPoints(vertices, Pyramid::VERTEX_COUNT, origin, points);
+    for (int k = 0; k < 3; k++)
+    {
+        points[5][k] = 0.25 * ((points[0][k] + points[1][k]) + (points[2][k] + points[3][k]));
+    }
+}
+
+static void loadHexahedronPoints(const Vector3D *vertices, Vector3D origin, double points[15][3])
+{
+    loadPoints(vertices, Hexahedron::VERTEX_COUNT, origin, points);
+    for (int k = 0; k < 3; k++)
+    {
+        points[8][k] = 0.125 * (((points[0][k] + points[1][k]) + (points[2][k] + points[3][k])) +
+                                ((points[4][k] + points[5][k]) + (points[6][k] + points[7][k])));
+        for (int face = 0; face < 6; face++)
+        {
+            const int *f = Hexahedron::FACES[face];
+            points[9 + face][k] = 0.25 * ((points[f[0]][k] + points[f[1]][k]) + (points[f[2]][k] + points[f[3]][k]));
+        }
+    }
+}
+
+// Sum the moments of the tetrahedra of a decomposition: first gets the
+// integral of the position, second (if not nullptr) the integral of its
+// outer product with itself, as xx, yy, zz, xy, yz, zx
+static void integrateTetrahedra(const double points[][3], const int split[][4], int count, double first[3],
+                                double second[6])
+{
+    for (int t = 0; t < count; t++)
+    {
+        const double *a = points[split[t][0]];
+        const double *b = points[split[t][1]];
+        const double *c = points[split[t][2]];
+        const double *d = points[split[t][3]];
+
+        double ab[3], ac[3], ad[3], sum[3];
+        for (int k = 0; k < 3; k++)
+        {
+            ab[k] = b[k] - a[k];
+            ac[k] = c[k] - a[k];
+            ad[k] = d[k] - a[k];
+            sum[k] = (a[k] + b[k]) + (c[k] + d[k]);
+        }
+        double volume;
+        tripleProduct(ab, ac, ad, volume);
+        volume /= 6;
+
+        for (int k = 0; k < 3; k++)
+        {
+            first[k] += 0.25 * volume * sum[k];
+        }
+        if (second == nullptr)
+        {
+            continue;
+        }
+
+        // Over a tetrahedron, the integral of p p^T is V / 20 times the
+        // sum of v v^T over its vertices plus s s^T, s the vertex sum
+        static const int rows[6] = {0, 1, 2, 0, 1, 2};
+        static const int columns[6] = {0, 1, 2, 1, 2, 0};
+        for (int j = 0; j < 6; j++)
+        {
+            int r = rows[j];
+            int q = columns[j];
+            double products = (a[r] * a[q] + b[r] * b[q]) + (c[r] * c[q] + d[r] * d[q]) + sum[r] * sum[q];
+            second[j] += volume / 20 * products;
+        }
+    }
+}
+
+static Matrix3x3 toSymmetricMatrix(const double second[6])
+{
+    return Matrix3x3(second[0], second[3], second[5],
+                     second[3], second[1], second[4],
+                     second[5], second[4], second[2]);
+}
+
+Pyramid::Pyramid(std::vector<Vector3D> &vertices, Material &material)
+{
+    this->type = TYPE;
+    setVertices(vertices, VERTEX_COUNT);
+    setMaterial(material);
+}
+
+Pyramid::Pyramid(const int *vertexIds, const VertexStore *vertexPool, int materialId, const MaterialTable *materialPool)
+{
+    this->type = TYPE;
+    setVertices(vertexIds, vertexPool, VERTEX_COUNT);
+    setMaterial(materialId, materialPool);
+}
+
+Pyramid::Pyramid()
+{
+    this->type = TYPE;
+}
 
 Pyramid::~Pyramid() {}
 
-double Pyramid::getVolume()
+double Pyramid::computeVolume(const Vector3D *vertices)
 {
-    double length = vertices[0].distance(vertices[1]);
-    double width = vertices[1].distance(vertices[2]);
-    Vector3D baseCentre = vertices[0].midpoint(vertices[2]);
-    double height = baseCentre.distance(vertices[4]);
+    // Split the base into four triangles about its centroid, like the
+    // faces of a hexahedron (see hexahedronVolume), and join them to the
+    // apex. The four tetrahedra add up to a sixth of (apex - centroid)
+    // dotted with the cross product of the base diagonals, which is exact
+    // for non-planar bases too.
+    Vector3D v0 = vertices[0];
+    Vector3D v1 = vertices[1];
+    Vector3D v2 = vertices[2];
+    Vector3D v3 = vertices[3];
+    Vector3D v4 = vertices[4];
+
+    Vector3D baseCentre = 0.25 * (v0 + v1 + v2 + v3);
+    Vector3D diagonals = (v2 - v0).cross(v3 - v1);
 
-    double volume = (length * width * height) / 3;
+    double volume = (v4 - baseCentre).dot(diagonals) / 6;
     return volume;
 }
 
+Vector3D Pyramid::computeMoment(const Vector3D *vertices)
+{
+    double points[6][3];
+    double first[3] = {0, 0, 0};
+    loadPyramidPoints(vertices, Vector3D(), points);
+    integrateTetrahedra(points, PYRAMID_SPLIT, 4, first, nullptr);
+    return Vector3D(first[0], first[1], first[2]);
+}
+
+void Pyramid::computeMoments(const Vector3D *vertices, Vector3D origin, Vector3D &first, Matrix3x3 &second)
+{
+    double points[6][3];
+    double firstSums[3] = {0, 0, 0};
+    double secondSums[6] = {0, 0, 0, 0, 0, 0};
+    loadPyramidPoints(vertices, origin, points);
+    integrateTetrahedra(points, PYRAMID_SPLIT, 4, firstSums, secondSums);
+    first = Vector3D(firstSums[0], firstSums[1], firstSums[2]);
+    second = toSymmetricMatrix(secondSums);
+}
+
 Hexahedron::Hexahedron(std::vector<Vector3D> &vertices, Material &material)
 {
-    for (int i = 0; i < 8; i++)
-    {
-        this->vertices.push_back(vertices[i]);
-    }
-    this->material = material;
+    this->type = TYPE;
+    setVertices(vertices, VERTEX_COUNT);
+    setMaterial(material);
 }
 
-Hexahedron::Hexahedron() {}
+Hexahedron::Hexahedron(const int *vertexIds, const VertexStore *vertexPool, int materialId, const MaterialTable *materialPool)
+{
+    this->type = TYPE;
+    setVertices(vertexIds, vertexPool, VERTEX_COUNT);
+    setMaterial(materialId, materialPool);
+}
+
+Hexahedron::Hexahedron()
+{
+    this->type = TYPE;
+}
 
 Hexahedron::~Hexahedron() {}
 
-double Hexahedron::getVolume()
+double Hexahedron::computeVolume(const Vector3D *vertices)
+{
+    double x[VERTEX_COUNT];
+    double y[VERTEX_COUNT];
+    double z[VERTEX_COUNT];
+    for (int i = 0; i < VERTEX_COUNT; i++)
+    {
+        Vector3D v = vertices[i];
+        x[i] = v.getX();
+        y[i] = v.getY();
+        z[i] = v.getZ();
+    }
+
+    // Through the batch kernel, so that single cells round like whole arrays
+    static const int vertexIds[VERTEX_COUNT] = {0, 1, 2, 3, 4, 5, 6, 7};
+    double volume;
+    computeHexahedronVolumes(vertexIds, 1, x, y, z, &volume, SimdLevel::Scalar);
+    return volume;
+}
+
+Vector3D Hexahedron::computeMoment(const Vector3D *vertices)
+{
+    double points[15][3];
+    double first[3] = {0, 0, 0};
+    loadHexahedronPoints(vertices, Vector3D(), points);
+    integrateTetrahedra(points, HEXAHEDRON_SPLIT, 24, first, nullptr);
+    return Vector3D(first[0], first[1], first[2]);
+}
+
+void Hexahedron::computeMoments(const Vector3D *vertices, Vector3D origin, Vector3D &first, Matrix3x3 &second)
 {
-	return 0;
+    double points[15][3];
+    double firstSums[3] = {0, 0, 0};
+    double secondSums[6] = {0, 0, 0, 0, 0, 0};
+    loadHexahedronPoints(vertices, origin, points);
+    integrateTetrahedra(points, HEXAHEDRON_SPLIT, 24, firstSums, secondSums);
+    first = Vector3D(firstSums[0], firstSums[1], firstSums[2]);
+    second = toSymmetricMatrix(secondSums);
 }
 
 Tetrahedron::Tetrahedron(std::vector<Vector3D> &vertices, Material &material)
 {
-    for (int i = 0; i < 4; i++)
-    {
-        this->vertices.push_back(vertices[i]);
-    }
-    this->material = material;
+    this->type = TYPE;
+    setVertices(vertices, VERTEX_COUNT);
+    setMaterial(material);
 }
 
-Tetrahedron::Tetrahedron() {}
+Tetrahedron::Tetrahedron(const int *vertexIds, const VertexStore *vertexPool, int materialId, const MaterialTable *materialPool)
+{
+    this->type = TYPE;
+    setVertices(vertexIds, vertexPool, VERTEX_COUNT);
+    setMaterial(materialId, materialPool);
+}
+
+Tetrahedron::Tetrahedron()
+{
+    this->type = TYPE;
+}
 
 Tetrahedron::~Tetrahedron() {}
 
-double Tetrahedron::getVolume()
+double Tetrahedron::computeVolume(const Vector3D *vertices)
 {
     // Source: http://mathworld.wolfram.com/Tetrahedron.html
 
-    Vector3D va = this->vertices[1] - this->vertices[0];
-    Vector3D vb = this->vertices[2] - this->vertices[0];
-    Vector3D vc = this->vertices[3] - this->vertices[0];
+    Vector3D v0 = vertices[0];
+    Vector3D v1 = vertices[1];
+    Vector3D v2 = vertices[2];
+    Vector3D v3 = vertices[3];
+
+    Vector3D va = v1 - v0;
+    Vector3D vb = v2 - v0;
+    Vector3D vc = v3 - v0;
 
     Vector3D vCross = vb.cross(vc);
 
@@ -129,4 +476,24 @@ double Tetrahedron::getVolume()
     double volume = scalar / 6;
 
     return volume;
-}
\ No newline at end of file
+}
+
+Vector3D Tetrahedron::computeMoment(const Vector3D *vertices)
+{
+    double points[4][3];
+    double first[3] = {0, 0, 0};
+    loadPoints(vertices, VERTEX_COUNT, Vector3D(), points);
+    integrateTetrahedra(points, TETRAHEDRON_SPLIT, 1, first, nullptr);
+    return Vector3D(first[0], first[1], first[2]);
+}
+
+void Tetrahedron::computeMoments(const Vector3D *vertices, Vector3D origin, Vector3D &first, Matrix3x3 &second)
+{
+    double points[4][3];
+    double firstSums[3] = {0, 0, 0};
+    double secondSums[6] = {0, 0, 0, 0, 0, 0};
+    loadPoints(vertices, VERTEX_COUNT, origin, points);
+    integrateTetrahedra(points, TETRAHEDRON_SPLIT, 1, firstSums, secondSums);
+    first = Vector3D(firstSums[0], firstSums[1], firstSums[2]);
+    second = toSymmetricMatrix(secondSums);
+}
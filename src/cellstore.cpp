@@ -0,0 +1,204 @@
+/**
+ * @file cellstore.cpp
+ * @brief Source file for the CellStore class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "cellstore.h"
+
+#include "parallel.h"
+
+CellStore::CellStore(Arena *arena)
+    : tetrahedra(arena), pyramids(arena), hexahedra(arena), types(arena), indices(arena)
+{
+}
+
+void CellStore::clear()
+{
+    this->tetrahedra.clear();
+    this->pyramids.clear();
+    this->hexahedra.clear();
+    this->types.clear();
+    this->indices.clear();
+}
+
+void CellStore::resize(int cellCount)
+{
+    if (cellCount > this->types.size())
+    {
+        this->types.resize(cellCount, 0);
+        this->indices.resize(cellCount, -1);
+    }
+}
+
+void CellStore::reserve(int tetrahedronCount, int pyramidCount, int hexahedronCount)
+{
+    this->tetrahedra.reserve(tetrahedronCount);
+    this->pyramids.reserve(pyramidCount);
+    this->hexahedra.reserve(hexahedronCount);
+}
+
+void CellStore::add(int id, char type, int materialId, const int *vertexIds)
+{
+    resize(id + 1);
+
+    switch (type)
+    {
+    case Tetrahedron::TYPE:
+        this->indices[id] = this->tetrahedra.add(id, materialId, vertexIds);
+        break;
+    case Pyramid::TYPE:
+        this->indices[id] = this->pyramids.add(id, materialId, vertexIds);
+        break;
+    case Hexahedron::TYPE:
+        this->indices[id] = this->hexahedra.add(id, materialId, vertexIds);
+        break;
+    default:
+        return;
+    }
+    this->types[id] = type;
+}
+
+void CellStore::assign(const char *cellTypes, const std::int32_t *materialIds, const std::uint64_t *offsets,
+                       const std::int32_t *connectivity, int cellCount, int threadCount)
+{
+    clear();
+    this->types.assign(cellTypes, cellTypes + cellCount);
+    this->indices.resize(cellCount);
+
+    // Count the cells of each type in each thread's range of IDs, so that
+    // the ranges can be placed one after the other within each type
+    std::vector<int> counts((std::size_t)threadCount * 3, 0);
+    const char shapeTypes[3] = {Tetrahedron::TYPE, Pyramid::TYPE, Hexahedron::TYPE};
+    parallelFor(threadCount, [&](int thread) {
+        int first = (long long)cellCount * thread / threadCount;
+        int last = (long long)cellCount * (thread + 1) / threadCount;
+        for (int id = first; id < last; id++)
+        {
+            for (int t = 0; t < 3; t++)
+            {
+                counts[thread * 3 + t] += cellTypes[id] == shapeTypes[t];
+            }
+        }
+    });
+    int totals[3] = {0, 0, 0};
+    for (int thread = 0; thread < threadCount; thread++)
+    {
+        for (int t = 0; t < 3; t++)
+        {
+            int count = counts[thread * 3 + t];
+            counts[thread * 3 + t] = totals[t];
+            totals[t] += count;
+        }
+    }
+    this->tetrahedra.resize(totals[0]);
+    this->pyramids.resize(totals[1]);
+    this->hexahedra.resize(totals[2]);
+
+    // Place each thread's cells after those of the threads before it, in ID
+    // order within each type
+    parallelFor(threadCount, [&](int thread) {
+        int first = (long long)cellCount * thread / threadCount;
+        int last = (long long)cellCount * (thread + 1) / threadCount;
+        int next[3] = {counts[thread * 3], counts[thread * 3 + 1], counts[thread * 3 + 2]};
+        for (int id = first; id < last; id++)
+        {
+            switch (cellTypes[id])
+            {
+            case Tetrahedron::TYPE:
+                this->indices[id] = next[0]++;
+                this->tetrahedra.set(this->indices[id], id, materialIds[id], connectivity + offsets[id]);
+                break;
+            case Pyramid::TYPE:
+                this->indices[id] = next[1]++;
+                this->pyramids.set(this->indices[id], id, materialIds[id], connectivity + offsets[id]);
+                break;
+            case Hexahedron::TYPE:
+                this->indices[id] = next[2]++;
+                this->hexahedra.set(this->indices[id], id, materialIds[id], connectivity + offsets[id]);
+                break;
+            default:
+                this->types[id] = 0;
+                this->indices[id] = -1;
+            }
+        }
+    });
+}
+
+int CellStore::getCellCount() const
+{
+    return this->types.size();
+}
+
+char CellStore::getType(int id) const
+{
+    return this->types[id];
+}
+
+int CellStore::getMaterialId(int id) const
+{
+    switch (this->types[id])
+    {
+    case Tetrahedron::TYPE:
+        return this->tetrahedra.getMaterialId(this->indices[id]);
+    case Pyramid::TYPE:
+        return this->pyramids.getMaterialId(this->indices[id]);
+    case Hexahedron::TYPE:
+        return this->hexahedra.getMaterialId(this->indices[id]);
+    default:
+        return -1;
+    }
+}
+
+int CellStore::getVertexCount(int id) const
+{
+    switch (this->types[id])
+    {
+    case Tetrahedron::TYPE:
+        return Tetrahedron::VERTEX_COUNT;
+    case Pyramid::TYPE:
+        return Pyramid::VERTEX_COUNT;
+    case Hexahedron::TYPE:
+        return Hexahedron::VERTEX_COUNT;
+    default:
+        return 0;
+    }
+}
+
+const int *CellStore::getVertexIds(int id) const
+{
+    switch (this->types[id])
+    {
+    case Tetrahedron::TYPE:
+        return this->tetrahedra.getVertexIds(this->indices[id]);
+    case Pyramid::TYPE:
+        return this->pyramids.getVertexIds(this->indices[id]);
+    case Hexahedron::TYPE:
+        return this->hexahedra.getVertexIds(this->indices[id]);
+    default:
+        return nullptr;
+    }
+}
+
+std::size_t CellStore::getConnectivitySize() const
+{
+    return (std::size_t)this->tetrahedra.size() * Tetrahedron::VERTEX_COUNT +
+           (std::size_t)this->pyramids.size() * Pyramid::VERTEX_COUNT +
+           (std::size_t)this->hexahedra.size() * Hexahedron::VERTEX_COUNT;
+}
+
+const CellArray<Tetrahedron> &CellStore::getTetrahedra() const
+{
+    return this->tetrahedra;
+}
+
+const CellArray<Pyramid> &CellStore::getPyramids() const
+{
+    return this->pyramids;
+}
+
+const CellArray<Hexahedron> &CellStore::getHexahedra() const
+{
+    return this->hexahedra;
+}
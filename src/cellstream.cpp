@@ -0,0 +1,25 @@
+/**
+ * @file cellstream.cpp
+ * @brief Source file for the CellStream class
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#include "cellstream.h"
+
+#include <utility>
+
+void CellStream::push(CellBatch &&batch)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->cellCount.fetch_add(batch.size(), std::memory_order_relaxed);
+    this->batches.push_back(std::move(batch));
+}
+
+std::vector<CellBatch> CellStream::take()
+{
+    std::vector<CellBatch> taken;
+    std::lock_guard<std::mutex> lock(this->mutex);
+    taken.swap(this->batches);
+    return taken;
+}
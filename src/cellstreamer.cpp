@@ -0,0 +1,162 @@
+/**
+ * @file cellstreamer.cpp
+ * @brief Source file for the CellStreamer class
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#include "cellstreamer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+// Cells pushed to the stream at most in one batch
+static const int STREAM_BATCH_CELLS = 1 << 15;
+
+// Vertex IDs indexed directly while below twice the range indexed so far
+// plus this many
+static const std::int64_t DENSE_ID_SLACK = 1 << 16;
+
+CellStreamer::CellStreamer(CellStream &stream, const std::vector<ModParser> &parsers)
+    : stream(stream), parsers(parsers), finished(parsers.size(), 0), chunk(0), materialCount(0), vertexCount(0),
+      cellCount(0)
+{
+}
+
+void CellStreamer::addVertex(const VertexRecord &record)
+{
+    // Later definitions of an ID replace earlier ones, as in the finished load
+    float *position;
+    if (record.id >= 0 && record.id < 2 * (std::int64_t)(this->positions.size() / 3) + DENSE_ID_SLACK)
+    {
+        std::size_t index = 3 * (std::size_t)record.id;
+        if (index >= this->positions.size())
+        {
+            this->positions.resize(index + 3, std::numeric_limits<float>::quiet_NaN());
+        }
+        position = &this->positions[index];
+    }
+    else
+    {
+        auto inserted = this->sparseIndices.emplace(record.id, this->sparsePositions.size());
+        if (inserted.second)
+        {
+            this->sparsePositions.resize(this->sparsePositions.size() + 3);
+        }
+        position = &this->sparsePositions[inserted.first->second];
+    }
+    position[0] = (float)record.x;
+    position[1] = (float)record.y;
+    position[2] = (float)record.z;
+}
+
+const float *CellStreamer::findVertex(std::int64_t id) const
+{
+    // An ID indexed directly once stays so, and its latest position is there
+    if (id >= 0 && 3 * (std::uint64_t)id < this->positions.size() && !std::isnan(this->positions[3 * id]))
+    {
+        return &this->positions[3 * id];
+    }
+    auto sparse = this->sparseIndices.find(id);
+    return sparse != this->sparseIndices.end() ? &this->sparsePositions[sparse->second] : nullptr;
+}
+
+void CellStreamer::take(const ModParser &parser)
+{
+    const MaterialRecordList &materials = parser.getMaterials();
+    for (; this->materialCount < materials.size(); this->materialCount++)
+    {
+        const MaterialRecord &record = materials[this->materialCount];
+        this->colours[record.id] = (std::uint32_t)std::strtoul(record.colour.toString().c_str(), nullptr, 16);
+    }
+
+    const VertexRecordList &vertices = parser.getVertices();
+    for (; this->vertexCount < vertices.size(); this->vertexCount++)
+    {
+        addVertex(vertices[this->vertexCount]);
+    }
+
+    // Cells go as far as the stream has room; those with a reference not
+    // read yet are skipped
+    long long room = this->stream.getRoom() - this->batch.size();
+    const CellRecordList &cells = parser.getCells();
+    for (; this->cellCount < cells.size() && room > 0; this->cellCount++)
+    {
+        const CellRecord &record = cells[this->cellCount];
+        auto colour = this->colours.find(record.materialId);
+        if (colour == this->colours.end())
+        {
+            continue;
+        }
+        const float *points[8];
+        int found = 0;
+        while (found < record.vertexCount && (points[found] = findVertex(record.vertexIds[found])) != nullptr)
+        {
+            found++;
+        }
+        if (found < record.vertexCount)
+        {
+            continue;
+        }
+
+        this->batch.types.push_back(record.type);
+        this->batch.colours.push_back(colour->second);
+        for (int i = 0; i < record.vertexCount; i++)
+        {
+            this->batch.points.insert(this->batch.points.end(), points[i], points[i] + 3);
+        }
+        room--;
+        if (this->batch.size() == STREAM_BATCH_CELLS)
+        {
+            flush();
+        }
+    }
+}
+
+void CellStreamer::flush()
+{
+    if (this->batch.size() > 0)
+    {
+        this->stream.push(std::move(this->batch));
+        this->batch = CellBatch();
+    }
+}
+
+void CellStreamer::update(int chunk, bool finished)
+{
+    // The stream only fills up, once full there is nothing left to do
+    if (this->stream.getRoom() <= 0)
+    {
+        return;
+    }
+
+    // The records of a chunk are only read by the thread parsing it, or
+    // once it is finished, which the lock makes visible to other threads
+    std::unique_lock<std::mutex> lock(this->mutex, std::defer_lock);
+    if (finished)
+    {
+        lock.lock();
+        this->finished[chunk] = 1;
+    }
+    else if (!lock.try_lock())
+    {
+        return;
+    }
+
+    while (this->chunk < this->parsers.size() && this->stream.getRoom() > 0 &&
+           (this->chunk == chunk || this->finished[this->chunk]))
+    {
+        take(this->parsers[this->chunk]);
+        flush();
+        if (!this->finished[this->chunk])
+        {
+            break;
+        }
+        this->chunk++;
+        this->materialCount = 0;
+        this->vertexCount = 0;
+        this->cellCount = 0;
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file cellstreamer.h
+ * @brief Header file for the CellStreamer class
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#ifndef CELLSTREAMER_H
+#define CELLSTREAMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cellstream.h"
+#include "modparser.h"
+
+/**
+ * Sends the cells of a .mod file to a CellStream while its chunks are
+ * still being parsed. Records are taken in file order, from the chunks
+ * whose parsing has finished and from the chunk being parsed by the
+ * calling thread, so that a file listing its vertices first streams its
+ * cells as they are read. Cells that reference a vertex or material not
+ * read yet are left to the finished load.
+ */
+class CellStreamer
+{
+  private:
+    CellStream &stream;
+    const std::vector<ModParser> &parsers;
+    std::mutex mutex;
+
+    /**
+    * Whether the parsing of each chunk has finished
+    */
+    std::vector<char> finished;
+
+    /**
+    * First chunk not wholly taken, and the records of it taken so far
+    */
+    int chunk;
+    std::size_t materialCount;
+    std::size_t vertexCount;
+    std::size_t cellCount;
+
+    /**
+    * Colour of every material read by ID
+    */
+    std::unordered_map<int, std::uint32_t> colours;
+
+    /**
+    * Position of every vertex read, three floats each. Files usually
+    * number their vertices densely, so positions are indexed by ID (NaN
+    * where no vertex is read yet), and only IDs far past those go to
+    * sparsePositions, indexed through sparseIndices.
+    */
+    std::vector<float> positions;
+    std::vector<float> sparsePositions;
+    std::unordered_map<std::int64_t, std::size_t> sparseIndices;
+
+    /**
+    * Store the position of vertex record
+    */
+    void addVertex(const VertexRecord &record);
+
+    /**
+    * Return the position of vertex id, nullptr if none is read yet
+    */
+    const float *findVertex(std::int64_t id) const;
+
+    /**
+    * Cells not pushed yet
+    */
+    CellBatch batch;
+
+    /**
+    * Take the records of parser not taken yet
+    */
+    void take(const ModParser &parser);
+
+    /**
+    * Push the cells of the batch, if any
+    */
+    void flush();
+
+  public:
+    /**
+    * Stream the records of parsers, one per chunk, to stream
+    */
+    CellStreamer(CellStream &stream, const std::vector<ModParser> &parsers);
+
+    /**
+    * Send what can be sent after the thread parsing chunk has parsed some
+    * more of it, finished if it is done with it. Calls that are not
+    * finished skip their turn rather than wait while another thread sends.
+    */
+    void update(int chunk, bool finished);
+};
+
+#endif /* CELLSTREAMER_H */
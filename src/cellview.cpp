@@ -0,0 +1,57 @@
+/**
+ * @file cellview.cpp
+ * @brief Source file for the CellView class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "cellview.h"
+
+double CellView::getVolume() const
+{
+    Vector3D positions[Cell::MAX_VERTEX_COUNT];
+    for (int i = 0; i < getVertexCount(); i++)
+    {
+        positions[i] = getVertex(i);
+    }
+
+    switch (getType())
+    {
+    case Pyramid::TYPE:
+        return Pyramid::computeVolume(positions);
+    case Hexahedron::TYPE:
+        return Hexahedron::computeVolume(positions);
+    case Tetrahedron::TYPE:
+        return Tetrahedron::computeVolume(positions);
+    default:
+        return 0;
+    }
+}
+
+double CellView::getMass() const
+{
+    // Unused IDs have no material and no volume
+    if (getType() == 0)
+    {
+        return 0;
+    }
+    return getVolume() * this->materials->getDensity(getMaterialId());
+}
+
+Vector3D CellView::getCentre() const
+{
+    const int *vertexIds = this->cells->getVertexIds(this->id);
+    int vertexCount = getVertexCount();
+    double x = 0;
+    double y = 0;
+    double z = 0;
+
+    for (int i = 0; i < vertexCount; i++)
+    {
+        Vector3D position = this->vertices->get(vertexIds[i]);
+        x += position.getX();
+        y += position.getY();
+        z += position.getZ();
+    }
+    return Vector3D(x / vertexCount, y / vertexCount, z / vertexCount);
+}
@@ -0,0 +1,306 @@
+/**
+ * @file faceadjacency.cpp
+ * @brief Source file for the FaceAdjacency class and its parallel construction
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "faceadjacency.h"
+
+#include <memory>
+#include <utility>
+
+#include "cell.h"
+#include "cellstore.h"
+#include "loadprogress.h"
+#include "parallel.h"
+
+const int FaceAdjacency::BOUNDARY;
+const int FaceAdjacency::NON_MANIFOLD;
+
+// Average number of faces per hash partition; each partition is matched
+// on its own through a hash table that should fit in cache
+static const int FACES_PER_PARTITION = 16384;
+
+FaceAdjacency::FaceAdjacency(std::vector<int> offsets, std::vector<int> neighbours)
+    : offsets(std::move(offsets)), neighbours(std::move(neighbours)), boundaryFaceCount(0), nonManifoldFaceCount(0)
+{
+    for (int i = 0; i < this->neighbours.size(); i++)
+    {
+        if (this->neighbours[i] == BOUNDARY)
+        {
+            this->boundaryFaceCount++;
+        }
+        else if (this->neighbours[i] == NON_MANIFOLD)
+        {
+            this->nonManifoldFaceCount++;
+        }
+    }
+}
+
+// Face key: the vertex IDs of a face in increasing order, each plus one
+// and packed two by two (triangles start with -1, stored as 0, so they
+// never match a quadrilateral)
+struct FaceKey
+{
+    unsigned long long values[2];
+
+    bool operator==(const FaceKey &other) const
+    {
+        return this->values[0] == other.values[0] && this->values[1] == other.values[1];
+    }
+};
+
+// Face of a cell
+struct FaceRecord
+{
+    FaceKey key;
+    int cell;
+    int face;
+};
+
+// Records of one face key in a partition's hash table
+struct FaceSlot
+{
+    int count;
+    int first;
+    int second;
+};
+
+// Sort four values with a sorting network
+static void sortFaceVertices(int *vertices)
+{
+    if (vertices[0] > vertices[1]) std::swap(vertices[0], vertices[1]);
+    if (vertices[2] > vertices[3]) std::swap(vertices[2], vertices[3]);
+    if (vertices[0] > vertices[2]) std::swap(vertices[0], vertices[2]);
+    if (vertices[1] > vertices[3]) std::swap(vertices[1], vertices[3]);
+    if (vertices[1] > vertices[2]) std::swap(vertices[1], vertices[2]);
+}
+
+// Hash of a face key: the top bits choose the partition, the bottom bits
+// the slot in the partition's table
+static unsigned long long getFaceHash(const FaceKey &key)
+{
+    unsigned long long hash = (key.values[0] ^ (key.values[1] * 0xC2B2AE3D27D4EB4FULL)) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 29);
+}
+
+static int getFacePartition(const FaceKey &key, int partitionBits)
+{
+    return partitionBits > 0 ? (int)(getFaceHash(key) >> (64 - partitionBits)) : 0;
+}
+
+// Call function(key, face) for every face of a cell of type Shape
+template <class Shape, class Function>
+static void forEachShapeFace(const int *vertexIds, Function &function)
+{
+    for (int face = 0; face < Shape::FACE_COUNT; face++)
+    {
+        const int *faceVertices = Shape::FACES[face];
+        int vertices[4];
+        for (int k = 0; k < 4; k++)
+        {
+            vertices[k] = faceVertices[k] < 0 ? -1 : vertexIds[faceVertices[k]];
+        }
+        sortFaceVertices(vertices);
+        FaceKey key = {{(unsigned long long)(unsigned int)(vertices[0] + 1) << 32 | (unsigned int)(vertices[1] + 1),
+                        (unsigned long long)(unsigned int)(vertices[2] + 1) << 32 | (unsigned int)(vertices[3] + 1)}};
+        function(key, face);
+    }
+}
+
+// Call function(key, face) for every face of cell id
+template <class Function>
+static void forEachFace(const CellStore &cells, int id, Function function)
+{
+    switch (cells.getType(id))
+    {
+    case Tetrahedron::TYPE:
+        forEachShapeFace<Tetrahedron>(cells.getVertexIds(id), function);
+        break;
+    case Pyramid::TYPE:
+        forEachShapeFace<Pyramid>(cells.getVertexIds(id), function);
+        break;
+    case Hexahedron::TYPE:
+        forEachShapeFace<Hexahedron>(cells.getVertexIds(id), function);
+        break;
+    }
+}
+
+static int getFaceCount(char type)
+{
+    switch (type)
+    {
+    case Tetrahedron::TYPE:
+        return Tetrahedron::FACE_COUNT;
+    case Pyramid::TYPE:
+        return Pyramid::FACE_COUNT;
+    case Hexahedron::TYPE:
+        return Hexahedron::FACE_COUNT;
+    default:
+        return 0;
+    }
+}
+
+FaceAdjacency buildFaceAdjacency(const CellStore &cells, int threadCount, const LoadProgress *progress)
+{
+    int cellCount = cells.getCellCount();
+    threadCount = resolveThreadCount(threadCount);
+    if (threadCount > cellCount)
+    {
+        threadCount = cellCount > 0 ? cellCount : 1;
+    }
+
+    // First entry of each cell, from the face counts by a prefix sum
+    std::vector<int> offsets(cellCount + 1);
+    parallelFor(threadCount, [&](int thread) {
+        int first = (long long)cellCount * thread / threadCount;
+        int last = (long long)cellCount * (thread + 1) / threadCount;
+        for (int id = first; id < last; id++)
+        {
+            offsets[id] = getFaceCount(cells.getType(id));
+        }
+    });
+    int faceCount = parallelExclusiveScan(offsets.data(), cellCount, threadCount);
+    offsets[cellCount] = faceCount;
+    int partitionBits = 0;
+    while (((long long)FACES_PER_PARTITION << partitionBits) < faceCount || (1 << partitionBits) < 4 * threadCount)
+    {
+        partitionBits++;
+    }
+    int partitionCount = 1 << partitionBits;
+
+    // Count the faces of each thread's cells in each partition
+    std::vector<int> counts((std::size_t)threadCount * partitionCount, 0);
+    parallelFor(threadCount, [&](int thread) {
+        int *threadCounts = &counts[(std::size_t)thread * partitionCount];
+        int first = (long long)cellCount * thread / threadCount;
+        int last = (long long)cellCount * (thread + 1) / threadCount;
+        for (int id = first; id < last; id++)
+        {
+            forEachFace(cells, id, [&](const FaceKey &key, int) { threadCounts[getFacePartition(key, partitionBits)]++; });
+        }
+    });
+
+    if (isLoadCancelled(progress))
+    {
+        return FaceAdjacency();
+    }
+
+    // Partitions one after the other, each split between the threads in
+    // order; counts become the position where each thread writes
+    std::vector<int> partitionStarts(partitionCount + 1);
+    int position = 0;
+    for (int partition = 0; partition < partitionCount; partition++)
+    {
+        partitionStarts[partition] = position;
+        for (int thread = 0; thread < threadCount; thread++)
+        {
+            int &count = counts[(std::size_t)thread * partitionCount + partition];
+            int start = position;
+            position += count;
+            count = start;
+        }
+    }
+    partitionStarts[partitionCount] = position;
+
+    // Left uninitialized, every record being written once below
+    std::unique_ptr<FaceRecord[]> records(new FaceRecord[faceCount]);
+    parallelFor(threadCount, [&](int thread) {
+        int *positions = &counts[(std::size_t)thread * partitionCount];
+        int first = (long long)cellCount * thread / threadCount;
+        int last = (long long)cellCount * (thread + 1) / threadCount;
+        for (int id = first; id < last; id++)
+        {
+            forEachFace(cells, id, [&](const FaceKey &key, int face) {
+                FaceRecord &record = records[positions[getFacePartition(key, partitionBits)]++];
+                record.key = key;
+                record.cell = id;
+                record.face = face;
+            });
+        }
+    });
+
+    if (isLoadCancelled(progress))
+    {
+        return FaceAdjacency();
+    }
+
+    // Match the faces of each partition through a hash table. The result
+    // of a face only depends on the other records with its key, so it
+    // does not depend on the order of the records either
+    std::vector<int> neighbours(faceCount, FaceAdjacency::BOUNDARY);
+    parallelFor(threadCount, [&](int thread) {
+        std::vector<FaceSlot> slots;
+        int firstPartition = (long long)partitionCount * thread / threadCount;
+        int lastPartition = (long long)partitionCount * (thread + 1) / threadCount;
+        for (int partition = firstPartition; partition < lastPartition && !isLoadCancelled(progress); partition++)
+        {
+            int begin = partitionStarts[partition];
+            int end = partitionStarts[partition + 1];
+            int mask = 1;
+            while (mask < 2 * (end - begin))
+            {
+                mask *= 2;
+            }
+            mask--;
+            slots.assign(mask + 1, FaceSlot{0, -1, -1});
+
+            // Find the slot of a key by linear probing
+            auto findSlot = [&](const FaceKey &key) -> FaceSlot & {
+                int index = getFaceHash(key) & mask;
+                while (slots[index].count > 0 && !(records[slots[index].first].key == key))
+                {
+                    index = (index + 1) & mask;
+                }
+                return slots[index];
+            };
+
+            bool isNonManifold = false;
+            for (int r = begin; r < end; r++)
+            {
+                FaceSlot &slot = findSlot(records[r].key);
+                if (slot.count == 0)
+                {
+                    slot.first = r;
+                }
+                else if (slot.count == 1)
+                {
+                    slot.second = r;
+                }
+                else
+                {
+                    isNonManifold = true;
+                }
+                slot.count++;
+            }
+
+            for (const FaceSlot &slot : slots)
+            {
+                if (slot.count == 2)
+                {
+                    const FaceRecord &first = records[slot.first];
+                    const FaceRecord &second = records[slot.second];
+                    neighbours[offsets[first.cell] + first.face] = second.cell;
+                    neighbours[offsets[second.cell] + second.face] = first.cell;
+                }
+            }
+            if (isNonManifold)
+            {
+                for (int r = begin; r < end; r++)
+                {
+                    if (findSlot(records[r].key).count > 2)
+                    {
+                        neighbours[offsets[records[r].cell] + records[r].face] = FaceAdjacency::NON_MANIFOLD;
+                    }
+                }
+            }
+        }
+    });
+
+    if (isLoadCancelled(progress))
+    {
+        return FaceAdjacency();
+    }
+    return FaceAdjacency(std::move(offsets), std::move(neighbours));
+}
@@ -24,44 +24,56 @@
 #include <vtkTransform.h>
 
 // VTK libraries - cells
+#include <vtkLookupTable.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkMassProperties.h>
+
+// VTK libraries - load preview
 #include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkCellType.h>
+#include <vtkFloatArray.h>
+#include <vtkOutlineSource.h>
 #include <vtkPoints.h>
-#include <vtkUnstructuredGrid.h>
-#include <vtkTetra.h>
-#include <vtkPyramid.h>
-#include <vtkHexahedron.h>
-#include <vtkMassProperties.h>
+#include <vtkUnsignedCharArray.h>
 
 // VTK libraries - filters
-#include <vtkTriangleFilter.h>
 #include <vtkShrinkFilter.h>
 #include <vtkClipDataSet.h>
 
-// VTK libraries - STL reading
-#include <vtkSTLReader.h>
+// VTK libraries - STL surfaces
 #include <vtkPolyDataMapper.h>
 
 // VTK libraries - Screenshot function
 #include <vtkWindowToImageFilter.h>
 #include <vtkPNGWriter.h>
 
+// Standard library
+#include <algorithm>
+#include <atomic>
+
 // Qt headers
 #include <QDebug>
+#include <QtConcurrent/QtConcurrent>
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "helpdialog.h"
 #include "clipdialog.h"
 
 // Local headers
+#include "cellstream.h"
+#include "loadprogress.h"
 #include "model.h"
+#include "modeldataset.h"
+#include "modelpreview.h"
+#include "modbinary.h"
 
 // VTK global variables
 // Create a VTK render window and a renderer
 vtkNew<vtkGenericOpenGLRenderWindow> renderWindow;
 vtkSmartPointer<vtkRenderer> renderer = vtkSmartPointer<vtkRenderer>::New();
-// Create STL reader
-vtkSmartPointer<vtkSTLReader> reader;
+// Surface of the STL model shown, which the filters start from
+vtkSmartPointer<vtkPolyData> stlSurface;
 // Create colors
 vtkSmartPointer<vtkNamedColors> colors = vtkSmartPointer<vtkNamedColors>::New();
 // Setup the light
@@ -85,15 +97,15 @@ float prevClipNormalX = -1;
 float prevClipNormalY = 0;
 float prevClipNormalZ = 0;
 // Initialise vectors for mappers and actors
-// .mod files have an actor/mapper per cell,
-// while .stl files only require one actor/mapper for the entire file
+// Both .mod and .stl files have one actor/mapper for the entire file
 std::vector<vtkSmartPointer<vtkDataSetMapper>> mappers;
 std::vector<vtkSmartPointer<vtkActor>> actors;
-// Initialise vectors for .mod parsing
-std::vector<vtkSmartPointer<vtkUnstructuredGrid>> unstructuredGrids;
-std::vector<vtkSmartPointer<vtkTetra>> tetras;
-std::vector<vtkSmartPointer<vtkPyramid>> pyras;
-std::vector<vtkSmartPointer<vtkHexahedron>> hexas;
+// Bounding box and sampled vertices drawn while a model loads, then the
+// batches of cells streamed by the parser, one actor each
+std::vector<vtkSmartPointer<vtkActor>> previewActors;
+std::vector<vtkSmartPointer<vtkActor>> batchActors;
+// Model shown, whose storage the VTK datasets refer to
+std::unique_ptr<Model> loadedModel;
 QString inputFileName;	// Global string for model's filename
 bool modelLoaded = false; // Global flag that indicates a model is currently loaded
 bool clipFilterEnabled = false;
@@ -105,6 +117,40 @@ QString volumeString;
 QString cellString;
 QString pointString;
 
+// Vertices sampled for the preview of a load
+static const int PREVIEW_SAMPLE_COUNT = 8192;
+
+// Cells streamed while a model is parsed, about 100 bytes each, beyond
+// which the rest only shows with the grid
+static const long long STREAMED_CELL_LIMIT = 1000000;
+
+// Model loaded off the GUI thread, with the datasets and stats to show it.
+// The window may take the preview once previewReady is set, the batches of
+// cells as they are streamed, and the .mod grid and colours once gridReady
+// is set, the worker no longer touching them; the rest is only complete
+// once the load has finished.
+struct LoadResult
+{
+	ModelPreview preview;
+	CellStream streamedCells{STREAMED_CELL_LIMIT};
+	std::atomic<bool> previewReady{false};
+	std::atomic<bool> gridReady{false};
+	std::unique_ptr<Model> model;
+	// .stl files: surface of the model's welded triangles
+	vtkSmartPointer<vtkPolyData> stlSurface;
+	// .mod files: grid of the cells and colour of each material
+	vtkSmartPointer<vtkUnstructuredGrid> grid;
+	vtkSmartPointer<vtkLookupTable> materialColours;
+	int materialCount = 0;
+	// Stats
+	double surfaceArea = 0;
+	double volume = 0;
+	int cellCount = 0;
+	int pointCount = 0;
+	// True if the load was cancelled, the rest then being incomplete
+	bool cancelled = false;
+};
+
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWindow)
 {
 	clipWindow = new ClipDialog();
@@ -135,6 +181,13 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
 
 MainWindow::~MainWindow()
 {
+	// A load still running is only told to stop: the worker touches
+	// nothing but its own result and progress, which it shares, so the
+	// window need not wait for it
+	if (loadWatcher->isRunning())
+	{
+		loadProgress->cancel();
+	}
 	delete ui;
 }
 
@@ -147,6 +200,7 @@ void MainWindow::setupWindow()
 	setupButtons(modelLoaded);
 	setupIcons();
 	setupConnects();
+	setupLoader();
 
 	setWindowTitle(tr("13CAD"));
 
@@ -257,33 +311,424 @@ void MainWindow::setupConnects()
 	connect(clipWindow, SIGNAL(clipDialogAccepted()), this, SLOT(on_clipDialog_dialogAccepted()));
 }
 
-void MainWindow::loadModel(QString inputFilename)
+void MainWindow::setupLoader()
 {
+	// Progress bar and cancel button, shown in the status bar while loading
+	progressBar = new QProgressBar(this);
+	progressBar->setRange(0, 100);
+	progressBar->setMaximumWidth(200);
+	progressBar->hide();
+	cancelLoadButton = new QPushButton(tr("Cancel"), this);
+	cancelLoadButton->hide();
+	ui->statusBar->addPermanentWidget(progressBar);
+	ui->statusBar->addPermanentWidget(cancelLoadButton);
+
+	// The loader runs on a worker thread, its progress is polled from here
+	loadWatcher = new QFutureWatcher<std::shared_ptr<LoadResult>>(this);
+	progressTimer = new QTimer(this);
+	progressTimer->setInterval(50);
+	connect(loadWatcher, SIGNAL(finished()), this, SLOT(handleLoadFinished()));
+	connect(progressTimer, SIGNAL(timeout()), this, SLOT(handleLoadProgress()));
+	connect(cancelLoadButton, SIGNAL(clicked()), this, SLOT(handleCancelLoad()));
+}
 
-	// Declare data to display in stats section
-	double modSurfArea;
-	double modVolume;
-	int modCells;
-	int modPoints;
-	vtkSmartPointer<vtkPolyData> modPolyData;
+// Load a model into result and build its VTK datasets, reporting each
+// phase to progress. The preview comes first and the grid before the
+// stats, each handed over as soon as it is complete (see LoadResult).
+// Runs on a worker thread: nothing here may touch the window or the
+// renderer.
+static std::shared_ptr<LoadResult> loadInBackground(std::string modelFileName, std::shared_ptr<LoadProgress> progress,
+													std::shared_ptr<LoadResult> result)
+{
+	// A few thousand vertices read straight from the file, which costs
+	// about the same whatever its size
+	progress->beginPhase("Reading preview", 1);
+	result->preview = readModelPreview(modelFileName, PREVIEW_SAMPLE_COUNT, progress.get());
+	result->previewReady.store(true, std::memory_order_release);
+	progress->advance(1);
+
+	result->model.reset(
+		new Model(modelFileName, 0, nullptr, Precision::Double, progress.get(), &result->streamedCells));
+	Model &mod1 = *result->model;
+
+	if (mod1.getIsSTL() && !progress->isCancelled())
+	{
+		// The surface is drawn from the triangles the model has already
+		// parsed and welded, so the file is read only once
+		progress->beginPhase("Building STL dataset", 1);
+		result->stlSurface = createModelSurface(mod1);
+		result->cellCount = mod1.getTriangleCount();
+		result->pointCount = mod1.getVertexCount();
+		progress->advance(1);
+		if (progress->isCancelled())
+		{
+			result->cancelled = true;
+			return result;
+		}
 
-	if (modelLoaded)
+		// The surface is all triangles, as vtkMassProperties needs
+		progress->beginPhase("Computing mass properties", 1);
+		vtkSmartPointer<vtkMassProperties> massProperty = vtkSmartPointer<vtkMassProperties>::New();
+		massProperty->SetInputData(result->stlSurface);
+		massProperty->Update();
+		result->surfaceArea = massProperty->GetSurfaceArea();
+		result->volume = massProperty->GetVolume();
+		progress->advance(1);
+	}
+	else if (!progress->isCancelled())
+	{
+		// The grid reads the coordinates, and where it can the cells, from
+		// the model itself, which is kept as long as the grid is shown
+		progress->beginPhase("Building grid", 1);
+		result->grid = createModelGrid(mod1);
+
+		// Colour each cell by material through a lookup table, entry i
+		// covering the range i - 0.5 to i + 0.5
+		const MaterialTable &modMaterials = mod1.getMaterialTable();
+		result->materialCount = modMaterials.size();
+		result->materialColours = vtkSmartPointer<vtkLookupTable>::New();
+		result->materialColours->SetNumberOfTableValues(modMaterials.size() > 0 ? modMaterials.size() : 1);
+		result->materialColours->SetTableRange(-0.5, modMaterials.size() - 0.5);
+		for (int i = 0; i < modMaterials.size(); i++)
+		{
+			// Convert the colour from a hexadecimal string to separate r, g
+			// and b in the range 0 to 1
+			std::string matColour = modMaterials.get(i).getColour();
+			int r = 0, g = 0, b = 0;
+			sscanf(matColour.c_str(), "%02x%02x%02x", &r, &g, &b);
+			result->materialColours->SetTableValue(i, (double)r / 255, (double)g / 255, (double)b / 255, 1);
+		}
+		result->gridReady.store(true, std::memory_order_release);
+		progress->advance(1);
+		if (progress->isCancelled())
+		{
+			result->cancelled = true;
+			return result;
+		}
+
+		// The stats only read the model, which the grid may be drawing by now.
+		// The volume comes from the cells, the area from their exterior faces
+		progress->beginPhase("Computing mass properties", 1);
+		MassProperties massProperties = mod1.getMassProperties(0, progress.get());
+		result->volume = massProperties.volume;
+		result->cellCount = massProperties.cellCount;
+		result->pointCount = mod1.getVertexCount();
+		progress->advance(1);
+		if (progress->isCancelled())
+		{
+			result->cancelled = true;
+			return result;
+		}
+
+		progress->beginPhase("Extracting surface", 1);
+		result->surfaceArea = mod1.getBoundarySurface(0, progress.get()).getArea();
+		progress->advance(1);
+	}
+
+	result->cancelled = progress->isCancelled();
+	return result;
+}
+
+void MainWindow::loadModel(QString inputFilename)
+{
+	// Only one load at a time: one still running is abandoned, along with
+	// whatever it has drawn
+	if (loadWatcher->isRunning())
 	{
-		double modSurfArea = 0;
-		double modVolume = 0;
-		int modCells = 0;
-		int modPoints = 0;
-		modPolyData->Initialize();
+		abandonLoad();
 	}
 
 	// Convert QString to std::string
 	std::string modelFileName = inputFileName.toUtf8().constData();
-	// Load model
-	// (maybe only do model mod1 in case it's a .mod file, remove isstl from model,
-	// and check here, so that you don't construct a model in case it's stl.)
-	Model mod1(modelFileName);
 
-	if (mod1.getIsSTL())
+	// Parse the file and build its datasets on a worker thread, the window
+	// polls the progress and draws each stage of the model as it becomes
+	// ready, until handleLoadFinished shows the rest
+	loadProgress = std::make_shared<LoadProgress>();
+	pendingLoad = std::make_shared<LoadResult>();
+	loadPreviewShown = false;
+	loadGridShown = false;
+	shownLoadPhase = nullptr;
+	progressBar->setValue(0);
+	progressBar->show();
+	cancelLoadButton->show();
+	progressTimer->start();
+	loadWatcher->setFuture(QtConcurrent::run(loadInBackground, modelFileName, loadProgress, pendingLoad));
+}
+
+void MainWindow::handleLoadProgress()
+{
+	// Report each phase once, and its progress on the bar
+	const char *phase = loadProgress->getPhase();
+	if (phase != shownLoadPhase && *phase != '\0')
+	{
+		shownLoadPhase = phase;
+		emit statusUpdateMessage(QString("Loading: ") + phase, 0);
+	}
+	progressBar->setValue((int)(100 * loadProgress->getFraction()));
+
+	// Each stage is drawn once and stays until replaced, so nothing already
+	// drawn is sent to VTK again
+	if (!loadPreviewShown && pendingLoad->previewReady.load(std::memory_order_acquire))
+	{
+		loadPreviewShown = true;
+		showPreview(pendingLoad->preview);
+	}
+	if (!loadGridShown)
+	{
+		std::vector<CellBatch> batches = pendingLoad->streamedCells.take();
+		for (const CellBatch &batch : batches)
+		{
+			showCellBatch(batch);
+		}
+		if (!batches.empty())
+		{
+			ui->qvtkWidget->GetRenderWindow()->Render();
+		}
+	}
+	if (!loadGridShown && pendingLoad->gridReady.load(std::memory_order_acquire))
+	{
+		loadGridShown = true;
+		showGrid(*pendingLoad);
+	}
+}
+
+void MainWindow::handleCancelLoad()
+{
+	loadProgress->cancel();
+	emit statusUpdateMessage(QString("Cancelling..."), 0);
+}
+
+void MainWindow::handleLoadFinished()
+{
+	progressTimer->stop();
+	progressBar->hide();
+	cancelLoadButton->hide();
+
+	// The worker is done with the result, the rest of which is taken over
+	// in one go
+	std::shared_ptr<LoadResult> result = loadWatcher->result();
+	if (result->cancelled)
+	{
+		discardLoad();
+		emit statusUpdateMessage(QString("Loading cancelled"), 0);
+		return;
+	}
+	pendingLoad.reset();
+	showModel(*result);
+}
+
+void MainWindow::showPreview(const ModelPreview &preview)
+{
+	if (preview.isEmpty())
+	{
+		return;
+	}
+
+	// The preview replaces the model shown so far
+	if (modelLoaded)
+	{
+		actors.clear();
+		mappers.clear();
+		clearModel();
+	}
+
+	// Outline of the bounds of the sample
+	Vector3D min = preview.getMin();
+	Vector3D max = preview.getMax();
+	vtkSmartPointer<vtkOutlineSource> outline = vtkSmartPointer<vtkOutlineSource>::New();
+	outline->SetBounds(min.getX(), max.getX(), min.getY(), max.getY(), min.getZ(), max.getZ());
+	vtkSmartPointer<vtkPolyDataMapper> outlineMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+	outlineMapper->SetInputConnection(outline->GetOutputPort());
+
+	// Sampled vertices as a cloud of points
+	vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+	vtkSmartPointer<vtkCellArray> vertices = vtkSmartPointer<vtkCellArray>::New();
+	points->SetNumberOfPoints(preview.getPointCount());
+	for (vtkIdType i = 0; i < preview.getPointCount(); i++)
+	{
+		const Vector3D &point = preview.getPoints()[i];
+		points->SetPoint(i, point.getX(), point.getY(), point.getZ());
+		vertices->InsertNextCell(1, &i);
+	}
+	vtkSmartPointer<vtkPolyData> cloud = vtkSmartPointer<vtkPolyData>::New();
+	cloud->SetPoints(points);
+	cloud->SetVerts(vertices);
+	vtkSmartPointer<vtkPolyDataMapper> cloudMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+	cloudMapper->SetInputData(cloud);
+
+	previewActors.resize(2);
+	previewActors[0] = vtkSmartPointer<vtkActor>::New();
+	previewActors[0]->SetMapper(outlineMapper);
+	previewActors[0]->GetProperty()->SetColor(colors->GetColor3d("White").GetData());
+	previewActors[1] = vtkSmartPointer<vtkActor>::New();
+	previewActors[1]->SetMapper(cloudMapper);
+	previewActors[1]->GetProperty()->SetColor(colors->GetColor3d("Gray").GetData());
+	previewActors[1]->GetProperty()->SetPointSize(2);
+	for (vtkActor *actor : previewActors)
+	{
+		renderer->AddActor(actor);
+	}
+
+	resetCamera();
+	ui->qvtkWidget->GetRenderWindow()->Render();
+}
+
+void MainWindow::showCellBatch(const CellBatch &batch)
+{
+	// The first batch replaces the model shown so far, if the preview has
+	// not already
+	bool firstShown = previewActors.empty() && batchActors.empty();
+	if (modelLoaded)
+	{
+		actors.clear();
+		mappers.clear();
+		clearModel();
+	}
+
+	// The batch has a copy of the vertices of each cell, VTK gets one more
+	vtkSmartPointer<vtkFloatArray> coordinates = vtkSmartPointer<vtkFloatArray>::New();
+	coordinates->SetNumberOfComponents(3);
+	coordinates->SetNumberOfTuples(batch.points.size() / 3);
+	std::copy(batch.points.begin(), batch.points.end(), coordinates->GetPointer(0));
+	vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+	points->SetData(coordinates);
+
+	// Each cell coloured by its material directly, without a lookup table
+	vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+	vtkSmartPointer<vtkUnsignedCharArray> cellColours = vtkSmartPointer<vtkUnsignedCharArray>::New();
+	cellColours->SetNumberOfComponents(3);
+	cellColours->SetNumberOfTuples(batch.size());
+	grid->SetPoints(points);
+	grid->Allocate(batch.size());
+	vtkIdType next = 0;
+	for (int i = 0; i < batch.size(); i++)
+	{
+		int vtkType = batch.types[i] == 'h' ? VTK_HEXAHEDRON : batch.types[i] == 'p' ? VTK_PYRAMID : VTK_TETRA;
+		int vertexCount = batch.types[i] == 'h' ? 8 : batch.types[i] == 'p' ? 5 : 4;
+		vtkIdType vertexIds[8];
+		for (int k = 0; k < vertexCount; k++)
+		{
+			vertexIds[k] = next++;
+		}
+		grid->InsertNextCell(vtkType, vertexCount, vertexIds);
+		std::uint32_t colour = batch.colours[i];
+		unsigned char rgb[3] = {(unsigned char)(colour >> 16), (unsigned char)(colour >> 8), (unsigned char)colour};
+		cellColours->SetTypedTuple(i, rgb);
+	}
+	grid->GetCellData()->SetScalars(cellColours);
+
+	vtkSmartPointer<vtkDataSetMapper> mapper = vtkSmartPointer<vtkDataSetMapper>::New();
+	mapper->SetInputData(grid);
+	mapper->SetScalarModeToUseCellData();
+	mapper->ScalarVisibilityOn();
+	vtkSmartPointer<vtkActor> actor = vtkSmartPointer<vtkActor>::New();
+	actor->SetMapper(mapper);
+	actor->GetProperty()->SetSpecular(0.5);
+	actor->GetProperty()->SetSpecularPower(5);
+	renderer->AddActor(actor);
+	batchActors.push_back(actor);
+
+	if (firstShown)
+	{
+		resetCamera();
+	}
+}
+
+void MainWindow::removePreview()
+{
+	for (vtkActor *actor : previewActors)
+	{
+		renderer->RemoveActor(actor);
+	}
+	previewActors.clear();
+	for (vtkActor *actor : batchActors)
+	{
+		renderer->RemoveActor(actor);
+	}
+	batchActors.clear();
+}
+
+void MainWindow::showGrid(LoadResult &result)
+{
+	// Prevent user from selecting STL only filters
+	ui->shrinkButton->setEnabled(false);
+	ui->resetFiltersButton->setEnabled(false);
+	ui->clipButton->setEnabled(false);
+
+	bool previewShown = !previewActors.empty() || !batchActors.empty();
+	removePreview();
+	if (modelLoaded)
+	{
+		actors.clear();
+		mappers.clear();
+
+		clearModel();
+	}
+
+	// All cells are in one grid drawn by one actor; the mapper only
+	// draws the outer faces of the grid
+	mappers.resize(1);
+	actors.resize(1);
+	mappers[0] = vtkSmartPointer<vtkDataSetMapper>::New();
+	mappers[0]->SetInputData(result.grid);
+	mappers[0]->SetScalarModeToUseCellData();
+	mappers[0]->SetLookupTable(result.materialColours);
+	mappers[0]->SetScalarRange(-0.5, result.materialCount - 0.5);
+	mappers[0]->ScalarVisibilityOn();
+
+	actors[0] = vtkSmartPointer<vtkActor>::New();
+	actors[0]->SetMapper(mappers[0]);
+	actors[0]->GetProperty()->SetSpecular(0.5);
+	actors[0]->GetProperty()->SetSpecularPower(5);
+	renderer->AddActor(actors[0]);
+
+	// After a preview only fit the view to the model, keeping any turn the
+	// user has given it meanwhile
+	if (previewShown)
+	{
+		renderer->ResetCamera();
+	}
+	else
+	{
+		resetCamera();
+	}
+	ui->qvtkWidget->GetRenderWindow()->Render();
+}
+
+void MainWindow::abandonLoad()
+{
+	// The old load finishes on its own once it sees the cancel, into a
+	// watcher of its own that drops its result and then itself. The next
+	// load's future replaces the old one on loadWatcher, along with any of
+	// its signals still pending
+	loadProgress->cancel();
+	QFutureWatcher<std::shared_ptr<LoadResult>> *abandoned = new QFutureWatcher<std::shared_ptr<LoadResult>>();
+	connect(abandoned, SIGNAL(finished()), abandoned, SLOT(deleteLater()));
+	abandoned->setFuture(loadWatcher->future());
+	progressTimer->stop();
+	discardLoad();
+}
+
+void MainWindow::discardLoad()
+{
+	// The grid of the load refers to its model, which is about to go
+	removePreview();
+	if (loadGridShown)
+	{
+		actors.clear();
+		mappers.clear();
+		clearModel();
+	}
+	ui->qvtkWidget->GetRenderWindow()->Render();
+	pendingLoad.reset();
+}
+
+void MainWindow::showModel(LoadResult &result)
+{
+	bool gridShownEarly = loadGridShown;
+	removePreview();
+	if (result.model->getIsSTL())
 	{
 		// Allow user to select STL only filters
 		ui->shrinkButton->setEnabled(true);
@@ -297,24 +742,22 @@ void MainWindow::loadModel(QString inputFilename)
 		{
 			actors[0] = NULL;
 			mappers[0] = NULL;
-			reader = NULL;
+			stlSurface = NULL;
 			clearModel();
 		}
 
 		// Visualize
-		reader = vtkSmartPointer<vtkSTLReader>::New();
-		reader->SetFileName(modelFileName.c_str());
-		reader->Update();
+		stlSurface = result.stlSurface;
 
 		// NOTE: datasetmapper is used instead of polydatamapper.
 		// Try to switch back to polydatamapper if there are any bugs.
 
 		//vtkSmartPointer<vtkPolyDataMapper> poly_mapper =
 		//vtkSmartPointer<vtkPolyDataMapper>::New();
-		//poly_mapper->SetInputConnection(reader->GetOutputPort());
+		//poly_mapper->SetInputData(stlSurface);
 
 		mappers[0] = vtkSmartPointer<vtkDataSetMapper>::New();
-		mappers[0]->SetInputConnection(reader->GetOutputPort());
+		mappers[0]->SetInputData(stlSurface);
 
 		actors[0] = vtkSmartPointer<vtkActor>::New();
 		actors[0]->SetMapper(mappers[0]);
@@ -322,222 +765,38 @@ void MainWindow::loadModel(QString inputFilename)
 		actors[0]->GetProperty()->SetSpecular(0.5);
 		actors[0]->GetProperty()->SetSpecularPower(5);
 
-		// Get PolyData of model
-		modPolyData = reader->GetOutput();
-
-		// Get stats
-		modCells = modPolyData->GetNumberOfPolys();
-		modPoints = modPolyData->GetNumberOfPoints();
-
-		// Use a triangle filter to obtain mass and surface area information
-		vtkTriangleFilter *triangleFilter = vtkTriangleFilter::New();
-		triangleFilter->SetInputConnection(reader->GetOutputPort());
-		triangleFilter->Update();
-		vtkMassProperties *massProperty = vtkMassProperties::New();
-		massProperty->SetInputConnection(triangleFilter->GetOutputPort());
-		massProperty->Update();
-		modSurfArea = massProperty->GetSurfaceArea();
-		modVolume = massProperty->GetVolume();
-
-		// Define the strings to be shown in the stats area
-		surfAreaString = QString::number(modSurfArea) + " m^2";
-		volumeString = QString::number(modVolume) + " m^3";
-		cellString = QString::number(modCells);
-		pointString = QString::number(modPoints);
-
 		renderer->AddActor(actors[0]);
 		emit statusUpdateMessage(QString("Loaded STL model"), 0);
 	}
 	else
 	{
-		// Prevent user from selecting STL only filters
-		ui->shrinkButton->setEnabled(false);
-		ui->resetFiltersButton->setEnabled(false);
-		ui->clipButton->setEnabled(false);
-
-		int poly_count = 0;
-		int tetra_count = 0;		// Number of tetrahedrons
-		int pyra_count = 0;			// Number of pyramids
-		int hexa_count = 0;			// Number of hexahedrons
-		int last_used_point_id = 0; // ID of last point used
-		// Get vector of cells from the model
-		std::vector<Cell> modCells = mod1.getCells();
-
-		// Get vector of materials
-		std::vector<Material> modMaterials = mod1.getMaterials();
-
-		// Resize to new model
-		unstructuredGrids.resize(modCells.size());
-		actors.resize(modCells.size());
-		mappers.resize(modCells.size());
-
-		vtkSmartPointer<vtkCellArray> cellArray = vtkSmartPointer<vtkCellArray>::New();
-		vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-
-		if (modelLoaded)
+		// The grid may already be drawn, in which case only the stats are new
+		if (!loadGridShown)
 		{
-			unstructuredGrids.clear();
-			actors.clear();
-			mappers.clear();
-			tetras.clear();
-			pyras.clear();
-			hexas.clear();
-			cellArray->Reset();
-			points->Reset();
-
-			clearModel();
-		}
-
-		// For each cell
-		for (std::vector<Cell>::iterator it = modCells.begin(); it != modCells.end(); ++it)
-		{
-
-			// Get vertices of the cell
-			std::vector<Vector3D> cellVertices = it->getVertices();
-
-			// Tetrahedron
-			if (cellVertices.size() == 4)
-			{
-				tetras.resize(tetra_count + 1);
-
-				// Insert vertices into vtkPoints vector
-				for (int i = 0; i < 4; i++)
-				{
-					points->InsertNextPoint(cellVertices[i].getX(), cellVertices[i].getY(), cellVertices[i].getZ());
-				}
-
-				unstructuredGrids[poly_count] = vtkSmartPointer<vtkUnstructuredGrid>::New();
-				unstructuredGrids[poly_count]->SetPoints(points);
-				tetras[tetra_count] = vtkSmartPointer<vtkTetra>::New();
-
-				// Set points to the tetra
-				for (int i = 0; i < 4; i++)
-				{
-					tetras[tetra_count]->GetPointIds()->SetId(i, last_used_point_id + i);
-				}
-				last_used_point_id += 4;
-
-				cellArray->InsertNextCell(tetras[tetra_count]);
-				unstructuredGrids[poly_count]->SetCells(VTK_TETRA, cellArray);
-				tetra_count++;
-
-				// Pyramid
-			}
-			else if (cellVertices.size() == 5)
-			{
-				pyras.resize(pyra_count + 1);
-				// Insert vertices into vtkPoints vector
-				for (int i = 0; i < 5; i++)
-				{
-					points->InsertNextPoint(cellVertices[i].getX(), cellVertices[i].getY(), cellVertices[i].getZ());
-				}
-
-				unstructuredGrids[poly_count] = vtkSmartPointer<vtkUnstructuredGrid>::New();
-				unstructuredGrids[poly_count]->SetPoints(points);
-				pyras[pyra_count] = vtkSmartPointer<vtkPyramid>::New();
-
-				// Set points to the pyramid
-				for (int i = 0; i < 4; i++)
-				{
-					pyras[pyra_count]->GetPointIds()->SetId(i, last_used_point_id + i);
-				}
-				last_used_point_id += 4;
-
-				cellArray->InsertNextCell(pyras[pyra_count]);
-				unstructuredGrids[poly_count]->SetCells(VTK_PYRAMID, cellArray);
-				pyra_count++;
-
-				// Hexahedron
-			}
-			else if (cellVertices.size() == 8)
-			{
-
-				hexas.resize(hexa_count + 1);
-
-				// Insert vertices into vtkPoints vector
-				for (int i = 0; i < 8; i++)
-				{
-					points->InsertNextPoint(cellVertices[i].getX(), cellVertices[i].getY(), cellVertices[i].getZ());
-				}
-
-				unstructuredGrids[poly_count] = vtkSmartPointer<vtkUnstructuredGrid>::New();
-				// Maybe this needs to go after set points
-				unstructuredGrids[poly_count]->SetPoints(points);
-				hexas[hexa_count] = vtkSmartPointer<vtkHexahedron>::New();
-
-				// Set points to the hexa
-				for (int i = 0; i < 8; i++)
-				{
-					hexas[hexa_count]->GetPointIds()->SetId(i, last_used_point_id + 1 + i);
-				}
-				last_used_point_id += 4;
-
-				cellArray->InsertNextCell(hexas[hexa_count]);
-				unstructuredGrids[poly_count]->SetCells(VTK_HEXAHEDRON, cellArray);
-				hexa_count++;
-			}
-
-			// Create mapper and set the current cell as its input
-			mappers[poly_count] = vtkSmartPointer<vtkDataSetMapper>::New();
-			mappers[poly_count]->SetInputData(unstructuredGrids[poly_count]);
-
-			// Set mapper to actor
-			actors[poly_count] = vtkSmartPointer<vtkActor>::New();
-			actors[poly_count]->SetMapper(mappers[poly_count]);
-			//actors[poly_count]->GetProperty()->SetColor(colors->GetColor3d("Cyan").GetData());
-
-			// Get material of current cell
-			Material mat1 = modCells[poly_count].getMaterial();
-
-			// Get colour as hexadecimal string, convert it to separate r, g and b
-			std::string matColour = mat1.getColour();
-			const char *rgbColour = matColour.c_str();
-			int r, g, b;
-			sscanf(rgbColour, "%02x%02x%02x", &r, &g, &b);
-
-			// Convert it to double and set it to range from 0 to 1
-			double dr = (double)r / 255;
-			double dg = (double)g / 255;
-			double db = (double)b / 255;
-
-			actors[poly_count]->GetProperty()->SetColor(dr, dg, db);
-
-			actors[poly_count]->GetProperty()->SetSpecular(0.5);
-			actors[poly_count]->GetProperty()->SetSpecularPower(5);
-			// Add actor to renderer
-			renderer->AddActor(actors[poly_count]);
-			poly_count++;
+			loadGridShown = true;
+			showGrid(result);
 		}
+		emit statusUpdateMessage(QString("Loaded MOD model"), 0);
+	}
 
-		modPolyData = vtkSmartPointer<vtkPolyData>::New();
-
-		modPolyData->SetPolys(cellArray);
-		modPolyData->SetPoints(points);
-
-		// Use a triangle filter to obtain mass and surface area information
-		vtkTriangleFilter *triangleFilter = vtkTriangleFilter::New();
-		vtkMassProperties *massProperty = vtkMassProperties::New();
-		triangleFilter->SetInputData(modPolyData);
-		triangleFilter->Update();
-		massProperty->SetInputConnection(triangleFilter->GetOutputPort());
-		massProperty->Update();
-		modSurfArea = massProperty->GetSurfaceArea();
-		modVolume = massProperty->GetVolume();
+	// Define the strings to be shown in the stats area
+	surfAreaString = QString::number(result.surfaceArea) + " m^2";
+	volumeString = QString::number(result.volume) + " m^3";
+	cellString = QString::number(result.cellCount);
+	pointString = QString::number(result.pointCount);
 
-		// Store all information in the stats strings
-		surfAreaString = QString::number(modSurfArea) + " m^2";
-		volumeString = QString::number(modVolume) + " m^3";
-		cellString = QString::number(poly_count);
-		pointString = QString::number(mod1.getVertexCount());
+	// The previous model's datasets have been replaced, so it can go
+	loadedModel = std::move(result.model);
 
-		emit statusUpdateMessage(QString("Loaded MOD model"), 0);
-	}
 	// Set flag back to true
 	modelLoaded = true;
 
 	// Enable buttons relating to model viewing
 	setupButtons(modelLoaded);
-	resetCamera();
+	if (!gridShownEarly)
+	{
+		resetCamera();
+	}
 
 	ui->qvtkWidget->GetRenderWindow()->Render();
 
@@ -608,7 +867,7 @@ void MainWindow::handleActionOpen()
 	// Prompt user for a filename
 	inputFileName = QFileDialog::getOpenFileName(this, tr("Open File"),
 												 QDir::currentPath(),
-												 tr("Supported Models (*.mod *.stl);;STL Model (*.stl);;Proprietary Model (*.mod)"));
+												 tr("Supported Models (*.mod *.modb *.stl);;STL Model (*.stl);;Proprietary Model (*.mod *.modb)"));
 
 	if (!inputFileName.isEmpty() && !inputFileName.isNull())
 	{
@@ -636,11 +895,23 @@ void MainWindow::handleActionSave()
 		// Prompt user for a filename
 		QString outputFileName = QFileDialog::getSaveFileName(this, tr("Save File"),
 															  QDir::currentPath(),
-															  tr("Supported Models (*.mod *.stl);;STL Model (*.stl);;Proprietary Model (*.mod)"));
+															  tr("Supported Models (*.mod *.modb *.stl);;STL Model (*.stl);;Proprietary Model (*.mod *.modb)"));
 
 		if (!outputFileName.isEmpty() && !outputFileName.isNull())
 		{
-			if (!QFile::copy(inputFileName, outputFileName))
+			bool saved;
+
+			// Saving a text .mod model as .modb converts it to the binary format
+			if (outputFileName.endsWith(".modb") && inputFileName.endsWith(".mod"))
+			{
+				saved = convertModToBinary(inputFileName.toStdString(), outputFileName.toStdString());
+			}
+			else
+			{
+				saved = QFile::copy(inputFileName, outputFileName);
+			}
+
+			if (!saved)
 			{
 				emit statusUpdateMessage(QString("Error while saving file"), 0);
 			}
@@ -822,9 +1093,9 @@ void MainWindow::on_shrinkButton_clicked()
 												  0, 1, 2, &success);
 	if (success)
 	{
-		// Connect shrink filter to STL reader
+		// Connect shrink filter to STL surface
 		vtkSmartPointer<vtkShrinkFilter> shrinkFilter = vtkSmartPointer<vtkShrinkFilter>::New();
-		shrinkFilter->SetInputConnection(reader->GetOutputPort());
+		shrinkFilter->SetInputData(stlSurface);
 		shrinkFilter->SetShrinkFactor(shrinkFactor);
 		shrinkFilter->Update();
 		mappers[0]->SetInputConnection(shrinkFilter->GetOutputPort());
@@ -892,10 +1163,10 @@ void MainWindow::on_clipButton_clicked()
 		if (!clipFilterEnabled)
 			clipFilter = NULL;
 		clipPlane = NULL;
-		// Connect clip filter to STL reader
+		// Connect clip filter to STL surface
 		clipFilter = vtkSmartPointer<vtkClipDataSet>::New();
 		clipPlane = vtkSmartPointer<vtkPlane>::New();
-		clipFilter->SetInputConnection(reader->GetOutputPort());
+		clipFilter->SetInputData(stlSurface);
 		clipPlane->SetOrigin(0.0, 0.0, 0.0);
 		clipPlane->SetNormal(-1.0, 0.0, 0.0);
 		clipFilter->SetClipFunction(clipPlane.Get());
@@ -1053,9 +1324,11 @@ void MainWindow::on_modColourButton_clicked()
 	if (rgbColours.isValid())
 	{
 
-		// Ensure all actors are properly coloured in case it's a .mod file
+		// Ensure all actors are properly coloured in case it's a .mod file,
+		// whose material colours are mapped from the cell scalars
 		for (int i = 0; i < actors.size(); i++)
 		{
+			mappers[i]->ScalarVisibilityOff();
 			actors[i]->GetProperty()->SetColor(r, g, b);
 		}
 		ui->qvtkWidget->GetRenderWindow()->Render();
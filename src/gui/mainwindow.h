@@ -22,6 +22,12 @@
 #include <QString>
 #include <QAction>
 #include <QActionGroup>
+#include <QFutureWatcher>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QTimer>
+
+#include <memory>
 
 #include "clipdialog.h"
 
@@ -29,6 +35,11 @@ namespace Ui {
     class MainWindow;
 }
 
+class LoadProgress;
+class ModelPreview;
+struct CellBatch;
+struct LoadResult;
+
 /**
  * Main GUI window.
  */
@@ -53,6 +64,27 @@ class MainWindow : public QMainWindow
 
     Ui::MainWindow *ui;
 
+    /**
+     * Background load of a model, its progress, and the widgets that show it
+     */
+    QFutureWatcher<std::shared_ptr<LoadResult>> *loadWatcher = nullptr;
+    std::shared_ptr<LoadProgress> loadProgress;
+    std::shared_ptr<LoadResult> pendingLoad;
+    QTimer *progressTimer = nullptr;
+    QProgressBar *progressBar = nullptr;
+    QPushButton *cancelLoadButton = nullptr;
+
+    /**
+     * Phase of the load last shown in the status bar
+     */
+    const char *shownLoadPhase = nullptr;
+
+    /**
+     * Stages of the load in progress already drawn
+     */
+    bool loadPreviewShown = false;
+    bool loadGridShown = false;
+
     /**
      * Setup function for the window
      */
@@ -74,10 +106,56 @@ class MainWindow : public QMainWindow
     void setupConnects();
 
     /**
-     * Loads model
+     * Setup function for the background loader and its progress widgets
+     */
+    void setupLoader();
+
+    /**
+     * Starts loading model on a worker thread, cancelling any load in
+     * progress; the model is shown once loaded
      */
     void loadModel(QString inputFilename);
 
+    /**
+     * Shows a model loaded by loadModel, replacing the current one
+     */
+    void showModel(LoadResult &result);
+
+    /**
+     * Draws the bounds and sampled vertices of a model still loading,
+     * replacing the current one
+     */
+    void showPreview(const ModelPreview &preview);
+
+    /**
+     * Draws a batch of cells streamed by the load in progress, alongside
+     * those drawn before, without sending any of them to VTK again
+     */
+    void showCellBatch(const CellBatch &batch);
+
+    /**
+     * Removes the preview drawn by showPreview and the batches drawn by
+     * showCellBatch
+     */
+    void removePreview();
+
+    /**
+     * Draws the grid of a .mod model, replacing the preview or the current
+     * model; its stats may still be loading
+     */
+    void showGrid(LoadResult &result);
+
+    /**
+     * Cancels the load in progress without waiting for it, leaving it to
+     * finish on its own, and discards it
+     */
+    void abandonLoad();
+
+    /**
+     * Removes what is drawn of the load in progress, and drops it
+     */
+    void discardLoad();
+
     /**
      * Clears loaded model
      */
@@ -167,6 +245,23 @@ class MainWindow : public QMainWindow
 
   private slots:
 
+    // Loading
+
+    /**
+     * Shows the phase and progress of the load in progress
+     */
+    void handleLoadProgress();
+
+    /**
+     * Cancels the load in progress
+     */
+    void handleCancelLoad();
+
+    /**
+     * Shows the loaded model, unless the load was cancelled
+     */
+    void handleLoadFinished();
+
     // Filters
 
     /**
@@ -208,29 +303,29 @@ class MainWindow : public QMainWindow
 
     // Lighting
     // Note on opacity and specularity sliders:
-    // If a STL model is loaded, there is only one actor,
+    // STL and MOD models are both drawn by a single actor,
     // thus changing the opacity as the slider is moved
     // is not resource expensive.
-    // If a MOD model is loaded, there will be many actors,
-    // thus the opacity is only changed when the value is changed.
+    // If there are several actors, the opacity is only
+    // changed when the value is changed.
 
     /**
-     * Changes opacity of .stl models as the slider is moved
+     * Changes opacity of single-actor models as the slider is moved
      */
     void on_opacitySlider_sliderMoved(int position);
 
     /**
-     * Changes opacity of .mod models after the slider is released
+     * Changes opacity of multi-actor models after the slider is released
      */
     void on_opacitySlider_valueChanged(int value);
 
     /**
-     * Changes specularity of .stl models as the slider is moved
+     * Changes specularity of single-actor models as the slider is moved
      */
     void on_specularitySlider_sliderMoved(int position);
 
     /**
-     * Changes specularity of .mod models after the slider is released
+     * Changes specularity of multi-actor models after the slider is released
      */
     void on_specularitySlider_valueChanged(int value);
 
@@ -0,0 +1,229 @@
+/**
+ * @file modeldataset.cpp
+ * @brief Source file for the VTK datasets built over a model's storage
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "modeldataset.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCellType.h>
+#include <vtkIdTypeArray.h>
+#include <vtkSOADataArrayTemplate.h>
+#include <vtkTypeInt32Array.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkVersion.h>
+
+#include "model.h"
+
+// Cells of one type, in the storage of the model
+struct CellTypeRange
+{
+	unsigned char vtkType;
+	int vertexCount;
+	vtkIdType cellCount;
+	const int *vertexIds;
+	const int *materialIds;
+};
+
+template <class Shape>
+static CellTypeRange getRange(const CellArray<Shape> &cells, unsigned char vtkType)
+{
+	return CellTypeRange{vtkType, Shape::VERTEX_COUNT, cells.size(), cells.getVertexIds(), cells.getMaterialIds()};
+}
+
+template <class Scalar>
+static vtkSmartPointer<vtkPoints> wrapColumns(const BasicVertexArray<Scalar> &vertices)
+{
+	vtkSmartPointer<vtkSOADataArrayTemplate<Scalar>> coordinates =
+		vtkSmartPointer<vtkSOADataArrayTemplate<Scalar>>::New();
+	coordinates->SetNumberOfComponents(3);
+
+	// The columns stay owned by the model: VTK must neither copy nor free them
+	coordinates->SetArray(0, const_cast<Scalar *>(vertices.getX()), vertices.size(), true, true);
+	coordinates->SetArray(1, const_cast<Scalar *>(vertices.getY()), vertices.size(), true, true);
+	coordinates->SetArray(2, const_cast<Scalar *>(vertices.getZ()), vertices.size(), true, true);
+
+	vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+	points->SetData(coordinates);
+	return points;
+}
+
+vtkSmartPointer<vtkPoints> createModelPoints(const VertexStore &vertices)
+{
+	vtkSmartPointer<vtkPoints> points;
+	vertices.visit([&](const auto &vertexArray) { points = wrapColumns(vertexArray); });
+	return points;
+}
+
+// Put perCell values of each cell of the ranges one after the other in a
+// VTK array (getValues giving the values of a range). If only one range
+// has cells, its values are wrapped instead of copied.
+template <class Function>
+static vtkSmartPointer<vtkTypeInt32Array> joinValues(const CellTypeRange *ranges, int rangeCount, Function getValues,
+													 int perCell(const CellTypeRange &))
+{
+	vtkSmartPointer<vtkTypeInt32Array> array = vtkSmartPointer<vtkTypeInt32Array>::New();
+	vtkIdType valueCount = 0;
+	int usedRangeCount = 0;
+	const CellTypeRange *usedRange = nullptr;
+	for (int r = 0; r < rangeCount; r++)
+	{
+		if (ranges[r].cellCount > 0)
+		{
+			valueCount += ranges[r].cellCount * perCell(ranges[r]);
+			usedRangeCount++;
+			usedRange = &ranges[r];
+		}
+	}
+
+	if (usedRangeCount == 1)
+	{
+		// Kept by the model: VTK must neither copy nor free them
+		array->SetArray(const_cast<int *>(getValues(*usedRange)), valueCount, 1);
+		return array;
+	}
+
+	array->SetNumberOfValues(valueCount);
+	vtkIdType position = 0;
+	for (int r = 0; r < rangeCount; r++)
+	{
+		vtkIdType count = ranges[r].cellCount * perCell(ranges[r]);
+		if (count > 0)
+		{
+			std::memcpy(array->GetPointer(position), getValues(ranges[r]), count * sizeof(int));
+			position += count;
+		}
+	}
+	return array;
+}
+
+static int getVertexCount(const CellTypeRange &range)
+{
+	return range.vertexCount;
+}
+
+static int getOne(const CellTypeRange &)
+{
+	return 1;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> createModelGrid(const Model &model)
+{
+	const CellStore &cells = model.getCellStore();
+	const CellTypeRange ranges[3] = {getRange(cells.getTetrahedra(), VTK_TETRA),
+									 getRange(cells.getPyramids(), VTK_PYRAMID),
+									 getRange(cells.getHexahedra(), VTK_HEXAHEDRON)};
+	vtkIdType cellCount = ranges[0].cellCount + ranges[1].cellCount + ranges[2].cellCount;
+
+	// Type of each cell, one run per range
+	vtkSmartPointer<vtkUnsignedCharArray> types = vtkSmartPointer<vtkUnsignedCharArray>::New();
+	types->SetNumberOfValues(cellCount);
+	vtkIdType first = 0;
+	for (const CellTypeRange &range : ranges)
+	{
+		std::fill(types->GetPointer(0) + first, types->GetPointer(0) + first + range.cellCount, range.vtkType);
+		first += range.cellCount;
+	}
+
+	vtkSmartPointer<vtkCellArray> cellArray = vtkSmartPointer<vtkCellArray>::New();
+	vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+	grid->SetPoints(createModelPoints(model.getVertexStore()));
+
+#if VTK_MAJOR_VERSION >= 9
+	// Cells are the offsets of their first vertex into the model's own
+	// connectivity, which is used as is
+	vtkSmartPointer<vtkTypeInt32Array> offsets = vtkSmartPointer<vtkTypeInt32Array>::New();
+	offsets->SetNumberOfValues(cellCount + 1);
+	int *offset = offsets->GetPointer(0);
+	int position = 0;
+	for (const CellTypeRange &range : ranges)
+	{
+		for (vtkIdType i = 0; i < range.cellCount; i++)
+		{
+			*offset++ = position;
+			position += range.vertexCount;
+		}
+	}
+	*offset = position;
+	cellArray->SetData(offsets, joinValues(ranges, 3, [](const CellTypeRange &range) { return range.vertexIds; },
+										   getVertexCount));
+	grid->SetCells(types, cellArray);
+#else
+	// Older versions only take their legacy layout: the vertex count then
+	// the vertex IDs of each cell, as vtkIdType, written in one pass
+	vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+	connectivity->SetNumberOfValues(cellCount + cells.getConnectivitySize());
+	vtkSmartPointer<vtkIdTypeArray> locations = vtkSmartPointer<vtkIdTypeArray>::New();
+	locations->SetNumberOfValues(cellCount);
+	vtkIdType *value = connectivity->GetPointer(0);
+	vtkIdType *location = locations->GetPointer(0);
+	for (const CellTypeRange &range : ranges)
+	{
+		const int *vertexIds = range.vertexIds;
+		for (vtkIdType i = 0; i < range.cellCount; i++)
+		{
+			*location++ = value - connectivity->GetPointer(0);
+			*value++ = range.vertexCount;
+			for (int j = 0; j < range.vertexCount; j++)
+			{
+				*value++ = *vertexIds++;
+			}
+		}
+	}
+	cellArray->SetCells(cellCount, connectivity);
+	grid->SetCells(types, locations, cellArray);
+#endif
+
+	vtkSmartPointer<vtkTypeInt32Array> materials =
+		joinValues(ranges, 3, [](const CellTypeRange &range) { return range.materialIds; }, getOne);
+	materials->SetName("Material");
+	grid->GetCellData()->SetScalars(materials);
+	return grid;
+}
+
+vtkSmartPointer<vtkPolyData> createModelSurface(const Model &model)
+{
+	ArrayView<int> triangles = model.getTriangleView();
+	vtkIdType triangleCount = triangles.size() / 3;
+
+	vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+#if VTK_MAJOR_VERSION >= 9
+	// Every triangle starts three vertices after the previous one, in the
+	// model's own vertex indices
+	vtkSmartPointer<vtkTypeInt32Array> offsets = vtkSmartPointer<vtkTypeInt32Array>::New();
+	offsets->SetNumberOfValues(triangleCount + 1);
+	int *offset = offsets->GetPointer(0);
+	for (vtkIdType i = 0; i <= triangleCount; i++)
+	{
+		offset[i] = 3 * i;
+	}
+	vtkSmartPointer<vtkTypeInt32Array> connectivity = vtkSmartPointer<vtkTypeInt32Array>::New();
+	// Kept by the model: VTK must neither copy nor free them
+	connectivity->SetArray(const_cast<int *>(triangles.data()), 3 * triangleCount, 1);
+	polys->SetData(offsets, connectivity);
+#else
+	// Legacy layout: 3 then the vertex IDs of each triangle
+	vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+	connectivity->SetNumberOfValues(4 * triangleCount);
+	vtkIdType *value = connectivity->GetPointer(0);
+	for (vtkIdType i = 0; i < triangleCount; i++)
+	{
+		*value++ = 3;
+		*value++ = triangles[3 * i];
+		*value++ = triangles[3 * i + 1];
+		*value++ = triangles[3 * i + 2];
+	}
+	polys->SetCells(triangleCount, connectivity);
+#endif
+
+	vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+	surface->SetPoints(createModelPoints(model.getVertexStore()));
+	surface->SetPolys(polys);
+	return surface;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file modeldataset.h
+ * @brief Header file for the VTK datasets built over a model's storage
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef MODELDATASET_H
+#define MODELDATASET_H
+
+#include <vtkSmartPointer.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkUnstructuredGrid.h>
+
+class Model;
+class VertexStore;
+
+/**
+ * Wrap the coordinate columns of vertices as VTK points, in the stored
+ * precision and without copying them. The store must outlive the points
+ * and must not change while they are in use.
+ */
+vtkSmartPointer<vtkPoints> createModelPoints(const VertexStore &vertices);
+
+/**
+ * Build a grid of all cells of model, one type after the other, with the
+ * material of each cell as cell scalars named "Material". The points are
+ * always the model's own coordinates; so are the connectivity and the
+ * materials of a model with a single cell type with VTK 9 and later, other
+ * models taking one bulk copy of them. The model must outlive the grid.
+ */
+vtkSmartPointer<vtkUnstructuredGrid> createModelGrid(const Model &model);
+
+/**
+ * Build a surface of the welded triangles of a STL model. The points are
+ * the model's own coordinates; so are the triangles with VTK 9 and later,
+ * which otherwise take one pass to the legacy layout. The model must
+ * outlive the surface.
+ */
+vtkSmartPointer<vtkPolyData> createModelSurface(const Model &model);
+
+#endif /* MODELDATASET_H */
@@ -0,0 +1,79 @@
+/**
+ * @file idmap.cpp
+ * @brief Source file for the IdMap class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "idmap.h"
+
+void IdMap::assignIdentity(int count)
+{
+    clear();
+    this->count = count;
+}
+
+bool IdMap::assign(const std::int64_t *ids, int count)
+{
+    clear();
+
+    // IDs that are already 0..count-1 need no table
+    bool identity = true;
+    for (int i = 0; i < count && identity; i++)
+    {
+        identity = ids[i] == i;
+    }
+    if (identity)
+    {
+        this->count = count;
+        return true;
+    }
+
+    // Keep the load factor at or below one half
+    std::size_t capacity = 2;
+    this->shift = 63;
+    while (capacity < 2 * (std::size_t)count)
+    {
+        capacity *= 2;
+        this->shift--;
+    }
+    this->ids.assign(ids, ids + count);
+    this->table.assign(capacity, -1);
+
+    std::size_t mask = capacity - 1;
+    for (int i = 0; i < count; i++)
+    {
+        std::size_t slot = getSlot(ids[i]);
+        while (this->table[slot] != -1 && this->ids[this->table[slot]] != ids[i])
+        {
+            slot = (slot + 1) & mask;
+        }
+        if (ids[i] < 0 || this->table[slot] != -1)
+        {
+            clear();
+            return false;
+        }
+        this->table[slot] = i;
+    }
+
+    this->count = count;
+    return true;
+}
+
+void IdMap::clear()
+{
+    this->count = 0;
+    this->ids.clear();
+    this->table.clear();
+    this->shift = 64;
+}
+
+const std::int64_t *IdMap::getIds() const
+{
+    return this->ids.empty() ? nullptr : this->ids.data();
+}
+
+std::size_t IdMap::getMemorySize() const
+{
+    return this->ids.capacity() * sizeof(std::int64_t) + this->table.capacity() * sizeof(int);
+}
@@ -0,0 +1,277 @@
+/**
+ * @file mappedfile.cpp
+ * @brief Source file for the MappedFile class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+    this->data = nullptr;
+    this->size = 0;
+    this->opened = false;
+#ifdef _WIN32
+    this->fileHandle = nullptr;
+    this->mappingHandle = nullptr;
+#endif
+}
+
+MappedFile::MappedFile(const std::string &filename) : MappedFile()
+{
+    open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+// Size of the reads of files that cannot be mapped
+static const std::size_t STREAM_CHUNK_SIZE = 1 << 16;
+
+#ifdef _WIN32
+
+// Read file to its end into buffer, returns true on success
+static bool readStream(HANDLE file, std::vector<char> &buffer)
+{
+    std::size_t size = 0;
+    while (true)
+    {
+        buffer.resize(size + STREAM_CHUNK_SIZE);
+        DWORD count = 0;
+        if (!ReadFile(file, buffer.data() + size, (DWORD)STREAM_CHUNK_SIZE, &count, NULL))
+        {
+            // A pipe whose writer has closed reports its end as an error
+            if (GetLastError() == ERROR_BROKEN_PIPE)
+            {
+                break;
+            }
+            buffer.clear();
+            return false;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+        size += count;
+    }
+    buffer.resize(size);
+    return true;
+}
+
+bool MappedFile::open(const std::string &filename)
+{
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    // Pipes and consoles cannot be mapped, so they are read instead
+    if (GetFileType(file) != FILE_TYPE_DISK)
+    {
+        bool read = readStream(file, this->buffer);
+        CloseHandle(file);
+        if (!read)
+        {
+            return false;
+        }
+        this->data = this->buffer.empty() ? nullptr : this->buffer.data();
+        this->size = this->buffer.size();
+        this->opened = true;
+        return true;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    this->fileHandle = file;
+    this->size = (std::size_t)fileSize.QuadPart;
+    this->opened = true;
+
+    // Empty files cannot be mapped, but are still valid (and empty) files
+    if (this->size == 0)
+    {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        close();
+        return false;
+    }
+    this->mappingHandle = mapping;
+
+    this->data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (this->data == nullptr)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (this->data != nullptr && this->buffer.empty())
+    {
+        UnmapViewOfFile(this->data);
+    }
+    if (this->mappingHandle != nullptr)
+    {
+        CloseHandle((HANDLE)this->mappingHandle);
+    }
+    if (this->fileHandle != nullptr)
+    {
+        CloseHandle((HANDLE)this->fileHandle);
+    }
+    this->data = nullptr;
+    this->mappingHandle = nullptr;
+    this->fileHandle = nullptr;
+    this->size = 0;
+    this->opened = false;
+    std::vector<char>().swap(this->buffer);
+}
+
+#else
+
+// Read file descriptor fd to its end into buffer, returns true on success
+static bool readStream(int fd, std::vector<char> &buffer)
+{
+    std::size_t size = 0;
+    while (true)
+    {
+        buffer.resize(size + STREAM_CHUNK_SIZE);
+        ssize_t count = read(fd, buffer.data() + size, STREAM_CHUNK_SIZE);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            buffer.clear();
+            return false;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+        size += count;
+    }
+    buffer.resize(size);
+    return true;
+}
+
+bool MappedFile::open(const std::string &filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || S_ISDIR(fileStat.st_mode))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // Pipes, terminals and devices cannot be mapped, so they are read instead
+    if (!S_ISREG(fileStat.st_mode))
+    {
+        bool read = readStream(fd, this->buffer);
+        ::close(fd);
+        if (!read)
+        {
+            return false;
+        }
+        this->data = this->buffer.empty() ? nullptr : this->buffer.data();
+        this->size = this->buffer.size();
+        this->opened = true;
+        return true;
+    }
+
+    this->size = (std::size_t)fileStat.st_size;
+    this->opened = true;
+
+    // Empty files cannot be mapped, but are still valid (and empty) files
+    if (this->size > 0)
+    {
+        void *mapping = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            ::close(fd);
+            this->size = 0;
+            this->opened = false;
+            return false;
+        }
+        this->data = (const char *)mapping;
+
+        // Files are parsed front to back, so let the kernel read ahead aggressively
+        madvise(mapping, this->size, MADV_SEQUENTIAL);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (this->data != nullptr && this->buffer.empty())
+    {
+        munmap((void *)this->data, this->size);
+    }
+    this->data = nullptr;
+    this->size = 0;
+    this->opened = false;
+    std::vector<char>().swap(this->buffer);
+}
+
+#endif
+
+bool MappedFile::isOpen() const
+{
+    return this->opened;
+}
+
+const char *MappedFile::begin() const
+{
+    return this->data;
+}
+
+const char *MappedFile::end() const
+{
+    return this->data + this->size;
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return this->size;
+}
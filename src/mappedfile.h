@@ -0,0 +1,99 @@
+/**
+ * @file mappedfile.h
+ * @brief Header file for the MappedFile class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Read-only memory mapping of a whole file.
+ * The contents are accessed in place, without being copied into a buffer.
+ * Files that cannot be mapped, such as pipes and terminals, are read into
+ * a buffer instead and accessed the same way.
+ */
+class MappedFile
+{
+  private:
+    /**
+    * Start of the mapped contents (nullptr for empty or unopened files)
+    */
+    const char *data;
+
+    /**
+    * Size of the mapped contents in bytes
+    */
+    std::size_t size;
+
+    /**
+    * True if the file was opened successfully
+    */
+    bool opened;
+
+    /**
+    * Contents of a file that could not be mapped (empty for mapped files)
+    */
+    std::vector<char> buffer;
+
+#ifdef _WIN32
+    /**
+    * Windows file handle
+    */
+    void *fileHandle;
+
+    /**
+    * Windows file mapping handle
+    */
+    void *mappingHandle;
+#endif
+
+  public:
+    MappedFile();
+    MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    // Mappings own OS resources, so they cannot be copied
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+    * Map the whole file into memory (or read it, if it cannot be mapped),
+    * returns true on success
+    */
+    bool open(const std::string &filename);
+
+    /**
+    * Unmap the file or free its buffer (called automatically on destruction)
+    */
+    void close();
+
+    // Accessors
+
+    /**
+    * Return true if the file is currently mapped
+    */
+    bool isOpen() const;
+
+    /**
+    * Return pointer to the first byte of the file
+    */
+    const char *begin() const;
+
+    /**
+    * Return pointer one past the last byte of the file
+    */
+    const char *end() const;
+
+    /**
+    * Return size of the file in bytes
+    */
+    std::size_t getSize() const;
+};
+
+#endif /* MAPPEDFILE_H */
@@ -0,0 +1,234 @@
+/**
+ * @file massproperties.cpp
+ * @brief Source file for the whole-model mass properties
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "massproperties.h"
+
+#include "cellstore.h"
+#include "loadprogress.h"
+#include "materialtable.h"
+#include "parallel.h"
+#include "vertexstore.h"
+
+// Number of cells per block. Blocks, not threads, fix the order of the
+// additions, so changing this changes the last bits of the results.
+static const int BLOCK_SIZE = 4096;
+
+// Sums over the cells of one material
+struct MaterialSums
+{
+    int materialId;
+    int cellCount;
+    CompensatedSum volume;
+    CompensatedSum mass;
+    CompensatedSum moment[3];
+
+    // Density times the second moment, as xx, yy, zz, xy, yz, zx
+    CompensatedSum secondMoment[6];
+
+    explicit MaterialSums(int materialId = -1) : materialId(materialId), cellCount(0) {}
+
+    void add(const MaterialSums &other)
+    {
+        this->cellCount += other.cellCount;
+        this->volume.add(other.volume);
+        this->mass.add(other.mass);
+        for (int k = 0; k < 3; k++)
+        {
+            this->moment[k].add(other.moment[k]);
+        }
+        for (int j = 0; j < 6; j++)
+        {
+            this->secondMoment[j].add(other.secondMoment[j]);
+        }
+    }
+
+    // Properties of the sums, moments being taken about origin
+    MaterialMassProperties getProperties(Vector3D origin) const
+    {
+        MaterialMassProperties properties;
+        properties.cellCount = this->cellCount;
+        properties.volume = this->volume.getValue();
+        properties.mass = this->mass.getValue();
+        if (properties.mass == 0)
+        {
+            return properties;
+        }
+
+        double mass = properties.mass;
+        double offset[3];
+        for (int k = 0; k < 3; k++)
+        {
+            offset[k] = this->moment[k].getValue() / mass;
+        }
+        properties.centreOfGravity = origin + Vector3D(offset[0], offset[1], offset[2]);
+
+        // Move the second moment to the centre of gravity, then
+        // inertia = trace(S) I - S
+        Matrix3x3 second(this->secondMoment[0].getValue(), this->secondMoment[3].getValue(), this->secondMoment[5].getValue(),
+                         this->secondMoment[3].getValue(), this->secondMoment[1].getValue(), this->secondMoment[4].getValue(),
+                         this->secondMoment[5].getValue(), this->secondMoment[4].getValue(), this->secondMoment[2].getValue());
+        for (int r = 0; r < 3; r++)
+        {
+            for (int q = 0; q < 3; q++)
+            {
+                second.set(r, q, second.get(r, q) - mass * offset[r] * offset[q]);
+            }
+        }
+        properties.inertia = second.trace() * Matrix3x3::identity() - second;
+        properties.inertia.getEigenDecomposition(properties.principalMoments, properties.principalAxes);
+        return properties;
+    }
+};
+
+// Cells first to first + count - 1 of the array of one type
+struct CellBlock
+{
+    char type;
+    int first;
+    int count;
+};
+
+// Per-thread buffers
+struct BlockScratch
+{
+    std::vector<double> volumes;
+    std::vector<Vector3D> moments;
+    std::vector<Matrix3x3> secondMoments;
+
+    // Index of each material in the sums of the current block, or -1
+    std::vector<int> slots;
+};
+
+// Append the blocks of one cell array
+template <class Shape>
+static void addBlocks(const CellArray<Shape> &cells, std::vector<CellBlock> &blocks)
+{
+    for (int first = 0; first < cells.size(); first += BLOCK_SIZE)
+    {
+        int count = cells.size() - first < BLOCK_SIZE ? cells.size() - first : BLOCK_SIZE;
+        blocks.push_back(CellBlock{Shape::TYPE, first, count});
+    }
+}
+
+// Sum one block into per-material sums, in order of first appearance
+template <class Shape, class Scalar>
+static void sumBlock(const CellArray<Shape> &cells, const BasicVertexArray<Scalar> &vertices, const double *densities,
+                     Vector3D origin, const CellBlock &block, BlockScratch &scratch, std::vector<MaterialSums> &sums)
+{
+    computeVolumes(cells, vertices, block.first, block.count, scratch.volumes.data());
+    computeMoments(cells, vertices, block.first, block.count, origin, scratch.moments.data(),
+                   scratch.secondMoments.data());
+
+    for (int i = 0; i < block.count; i++)
+    {
+        int materialId = cells.getMaterialId(block.first + i);
+        int &slot = scratch.slots[materialId];
+        if (slot < 0)
+        {
+            slot = sums.size();
+            sums.push_back(MaterialSums(materialId));
+        }
+
+        double density = densities[materialId];
+        Vector3D moment = scratch.moments[i];
+        MaterialSums &material = sums[slot];
+        material.cellCount++;
+        material.volume.add(scratch.volumes[i]);
+        material.mass.add(density * scratch.volumes[i]);
+        material.moment[0].add(density * moment.getX());
+        material.moment[1].add(density * moment.getY());
+        material.moment[2].add(density * moment.getZ());
+
+        const double *second = scratch.secondMoments[i].data();
+        material.secondMoment[0].add(density * second[0]);
+        material.secondMoment[1].add(density * second[4]);
+        material.secondMoment[2].add(density * second[8]);
+        material.secondMoment[3].add(density * second[1]);
+        material.secondMoment[4].add(density * second[5]);
+        material.secondMoment[5].add(density * second[2]);
+    }
+
+    for (int i = 0; i < sums.size(); i++)
+    {
+        scratch.slots[sums[i].materialId] = -1;
+    }
+}
+
+MassProperties computeMassProperties(const CellStore &cells, const VertexStore &vertices,
+                                     const MaterialTable &materials, int threadCount,
+                                     const LoadProgress *progress)
+{
+    std::vector<CellBlock> blocks;
+    addBlocks(cells.getTetrahedra(), blocks);
+    addBlocks(cells.getPyramids(), blocks);
+    addBlocks(cells.getHexahedra(), blocks);
+
+    threadCount = resolveThreadCount(threadCount);
+    if (threadCount > (int)blocks.size())
+    {
+        threadCount = blocks.size() > 0 ? blocks.size() : 1;
+    }
+
+    // Each thread sums a contiguous run of blocks, keeping each block apart
+    Vector3D origin = vertices.getCentroid();
+    const double *densities = materials.getDensities();
+    std::vector<std::vector<MaterialSums>> blockSums(blocks.size());
+    parallelFor(threadCount, [&](int thread) {
+        BlockScratch scratch;
+        scratch.volumes.resize(BLOCK_SIZE);
+        scratch.moments.resize(BLOCK_SIZE);
+        scratch.secondMoments.resize(BLOCK_SIZE);
+        scratch.slots.assign(materials.size(), -1);
+
+        int firstBlock = (long long)blocks.size() * thread / threadCount;
+        int lastBlock = (long long)blocks.size() * (thread + 1) / threadCount;
+        vertices.visit([&](const auto &vertexArray) {
+            for (int b = firstBlock; b < lastBlock && !isLoadCancelled(progress); b++)
+            {
+                const CellBlock &block = blocks[b];
+                switch (block.type)
+                {
+                case Tetrahedron::TYPE:
+                    sumBlock(cells.getTetrahedra(), vertexArray, densities, origin, block, scratch, blockSums[b]);
+                    break;
+                case Pyramid::TYPE:
+                    sumBlock(cells.getPyramids(), vertexArray, densities, origin, block, scratch, blockSums[b]);
+                    break;
+                case Hexahedron::TYPE:
+                    sumBlock(cells.getHexahedra(), vertexArray, densities, origin, block, scratch, blockSums[b]);
+                    break;
+                }
+            }
+        });
+    });
+
+    if (isLoadCancelled(progress))
+    {
+        return MassProperties();
+    }
+
+    // Combine the blocks in order, then the materials in order
+    std::vector<MaterialSums> materialSums(materials.size());
+    for (int b = 0; b < blocks.size(); b++)
+    {
+        for (const MaterialSums &sums : blockSums[b])
+        {
+            materialSums[sums.materialId].add(sums);
+        }
+    }
+
+    MassProperties properties;
+    MaterialSums total;
+    properties.materials.reserve(materialSums.size());
+    for (int i = 0; i < materialSums.size(); i++)
+    {
+        properties.materials.push_back(materialSums[i].getProperties(origin));
+        total.add(materialSums[i]);
+    }
+    static_cast<MaterialMassProperties &>(properties) = total.getProperties(origin);
+    return properties;
+}
@@ -26,22 +26,22 @@ Material::Material(int id, double density, std::string column, std::string name)
 
 Material::~Material() {}
 
-int Material::getId()
+int Material::getId() const
 {
     return this->id;
 }
 
-double Material::getDensity()
+double Material::getDensity() const
 {
     return this->density;
 }
 
-std::string Material::getColour()
+std::string Material::getColour() const
 {
     return this->colour;
 }
 
-std::string Material::getName()
+std::string Material::getName() const
 {
     return this->name;
 }
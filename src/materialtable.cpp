@@ -0,0 +1,60 @@
+/**
+ * @file materialtable.cpp
+ * @brief Source file for the MaterialTable class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "materialtable.h"
+
+int MaterialTable::size() const
+{
+    return this->materials.size();
+}
+
+void MaterialTable::resize(int count)
+{
+    this->materials.resize(count);
+    this->densities.resize(count, 0.0);
+}
+
+void MaterialTable::clear()
+{
+    this->materials.clear();
+    this->densities.clear();
+}
+
+void MaterialTable::set(int index, const Material &material)
+{
+    if (index >= size())
+    {
+        resize(index + 1);
+    }
+    this->materials[index] = material;
+    this->densities[index] = material.getDensity();
+}
+
+const Material &MaterialTable::get(int index) const
+{
+    return this->materials[index];
+}
+
+double MaterialTable::getDensity(int index) const
+{
+    return this->densities[index];
+}
+
+const double *MaterialTable::getDensities() const
+{
+    return this->densities.data();
+}
+
+ArrayView<Material> MaterialTable::getMaterials() const
+{
+    return ArrayView<Material>(this->materials.data(), this->materials.size());
+}
+
+std::vector<Material> MaterialTable::toVector() const
+{
+    return std::vector<Material>(this->materials.begin(), this->materials.end());
+}
@@ -7,15 +7,98 @@
 
 #include "matrix.h"
 #include "vector3d.h"
-#include <vector>
+#include <cmath>
 
-void Matrix3x3::setDiagonal(Vector3D &v)
+void Matrix3x3::getEigenDecomposition(Vector3D &eigenvalues, Matrix3x3 &eigenvectors) const
 {
-    this->values.resize(9);
-    this->values[1] = this->values[2] = 0.;
-    this->values[3] = this->values[5] = 0.;
-    this->values[6] = this->values[7] = 0.;
-    this->values[0] = v.x;
-    this->values[4] = v.y;
-    this->values[8] = v.z;
-}
\ No newline at end of file
+    // Cyclic Jacobi: rotate away the largest off-diagonal values until
+    // the matrix is diagonal. Converges quadratically and is accurate
+    // for small eigenvalues too, which matters for thin parts.
+    double a[3][3];
+    for (int row = 0; row < 3; row++)
+    {
+        for (int column = row; column < 3; column++)
+        {
+            a[row][column] = a[column][row] = get(row, column);
+        }
+    }
+    Matrix3x3 v = identity();
+
+    for (int sweep = 0; sweep < 50; sweep++)
+    {
+        double offDiagonal = std::fabs(a[0][1]) + std::fabs(a[0][2]) + std::fabs(a[1][2]);
+        if (offDiagonal == 0)
+        {
+            break;
+        }
+
+        for (int p = 0; p < 2; p++)
+        {
+            for (int q = p + 1; q < 3; q++)
+            {
+                // Values below rounding of the diagonal no longer change it
+                if (std::fabs(a[p][q]) <= 1e-18 * (std::fabs(a[p][p]) + std::fabs(a[q][q])))
+                {
+                    a[p][q] = a[q][p] = 0;
+                    continue;
+                }
+
+                // Rotation by angle t = tan(angle) that zeroes a[p][q]
+                double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+                double t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                double c = 1 / std::sqrt(t * t + 1);
+                double s = t * c;
+
+                a[p][p] -= t * a[p][q];
+                a[q][q] += t * a[p][q];
+                a[p][q] = a[q][p] = 0;
+                int r = 3 - p - q;
+                double arp = a[r][p];
+                double arq = a[r][q];
+                a[r][p] = a[p][r] = c * arp - s * arq;
+                a[r][q] = a[q][r] = s * arp + c * arq;
+
+                for (int k = 0; k < 3; k++)
+                {
+                    double vkp = v.get(k, p);
+                    double vkq = v.get(k, q);
+                    v.set(k, p, c * vkp - s * vkq);
+                    v.set(k, q, s * vkp + c * vkq);
+                }
+            }
+        }
+    }
+
+    // Sort by increasing eigenvalue, moving the columns along
+    int order[3] = {0, 1, 2};
+    for (int i = 0; i < 2; i++)
+    {
+        for (int j = i + 1; j < 3; j++)
+        {
+            if (a[order[j]][order[j]] < a[order[i]][order[i]])
+            {
+                int swap = order[i];
+                order[i] = order[j];
+                order[j] = swap;
+            }
+        }
+    }
+
+    eigenvalues = Vector3D(a[order[0]][order[0]], a[order[1]][order[1]], a[order[2]][order[2]]);
+    for (int k = 0; k < 3; k++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            eigenvectors.set(k, i, v.get(k, order[i]));
+        }
+    }
+
+    // Flip the last axis if needed, so that the basis is right-handed
+    if (eigenvectors.determinant() < 0)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            eigenvectors.set(k, 2, -eigenvectors.get(k, 2));
+        }
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * @file modbinary.cpp
+ * @brief Source file for the binary .mod companion format (.modb)
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <cstring>
+#include <string>
+
+#include "modbinary.h"
+#include "mappedfile.h"
+#include "model.h"
+
+static_assert(sizeof(ModBinaryHeader) == 152, "ModBinaryHeader layout changed");
+static_assert(sizeof(ModBinaryMaterial) == 48, "ModBinaryMaterial layout changed");
+static_assert(sizeof(int) == sizeof(std::int32_t), "connectivity is read as int");
+
+/**
+ * Return true if [offset, offset + count * elementSize) lies inside the file
+ * and offset is aligned to alignment bytes
+ */
+static bool isSectionValid(std::uint64_t offset, std::uint64_t count, std::uint64_t elementSize,
+                           std::uint64_t alignment, std::uint64_t fileSize)
+{
+    if (offset % alignment != 0 || offset > fileSize)
+    {
+        return false;
+    }
+    // Written this way to avoid overflow on corrupt counts
+    return count <= (fileSize - offset) / elementSize;
+}
+
+ModBinaryFile::ModBinaryFile()
+{
+    this->data = nullptr;
+    this->header = nullptr;
+}
+
+ModBinaryFile::ModBinaryFile(std::string filename) : ModBinaryFile()
+{
+    open(filename);
+}
+
+ModBinaryFile::~ModBinaryFile() {}
+
+bool ModBinaryFile::open(std::string filename)
+{
+    this->mapping.reset(new MappedFile(filename));
+    if (!this->mapping->isOpen() || !attach(this->mapping->begin(), this->mapping->getSize()))
+    {
+        this->mapping.reset();
+        return false;
+    }
+    return true;
+}
+
+bool ModBinaryFile::attach(const char *data, std::size_t size)
+{
+    this->data = nullptr;
+    this->header = nullptr;
+
+    if (!hasMagic(data, size) || size < sizeof(ModBinaryHeader) || (std::uintptr_t)data % 8 != 0)
+    {
+        return false;
+    }
+
+    const ModBinaryHeader *h = (const ModBinaryHeader *)data;
+    if (h->version != MOD_BINARY_VERSION || h->byteOrderMark != 0x01020304 || h->fileSize != size)
+    {
+        return false;
+    }
+
+    // Every section must lie inside the file
+    if (h->cellCount == UINT64_MAX ||
+        !isSectionValid(h->materialOffset, h->materialCount, sizeof(ModBinaryMaterial), 8, size) ||
+        !isSectionValid(h->stringsOffset, h->stringsSize, 1, 1, size) ||
+        !isSectionValid(h->coordinateOffset, h->vertexCount, 3 * sizeof(double), 8, size) ||
+        !isSectionValid(h->cellTypeOffset, h->cellCount, 1, 1, size) ||
+        !isSectionValid(h->cellMaterialOffset, h->cellCount, sizeof(std::int32_t), 4, size) ||
+        !isSectionValid(h->cellOffsetOffset, h->cellCount + 1, sizeof(std::uint64_t), 8, size) ||
+        !isSectionValid(h->connectivityOffset, h->connectivitySize, sizeof(std::int32_t), 4, size) ||
+        (h->vertexIdCount != 0 && h->vertexIdCount != h->vertexCount) ||
+        (h->cellIdCount != 0 && h->cellIdCount != h->cellCount) ||
+        !isSectionValid(h->vertexIdOffset, h->vertexIdCount, sizeof(std::int64_t), 8, size) ||
+        !isSectionValid(h->cellIdOffset, h->cellIdCount, sizeof(std::int64_t), 8, size))
+    {
+        return false;
+    }
+
+    // Material strings must lie inside the strings section
+    const ModBinaryMaterial *materials = (const ModBinaryMaterial *)(data + h->materialOffset);
+    for (std::uint64_t i = 0; i < h->materialCount; i++)
+    {
+        if (materials[i].colourOffset > h->stringsSize || materials[i].colourLength > h->stringsSize - materials[i].colourOffset ||
+            materials[i].nameOffset > h->stringsSize || materials[i].nameLength > h->stringsSize - materials[i].nameOffset)
+        {
+            return false;
+        }
+    }
+
+    // The last cell must end exactly at the end of the connectivity array
+    const std::uint64_t *cellOffsets = (const std::uint64_t *)(data + h->cellOffsetOffset);
+    if (cellOffsets[0] != 0 || cellOffsets[h->cellCount] != h->connectivitySize)
+    {
+        return false;
+    }
+
+    this->data = data;
+    this->header = h;
+    return true;
+}
+
+bool ModBinaryFile::isValid() const
+{
+    return this->header != nullptr;
+}
+
+std::uint32_t ModBinaryFile::getVersion() const
+{
+    return this->header->version;
+}
+
+std::size_t ModBinaryFile::getMaterialCount() const
+{
+    return (std::size_t)this->header->materialCount;
+}
+
+std::size_t ModBinaryFile::getVertexCount() const
+{
+    return (std::size_t)this->header->vertexCount;
+}
+
+std::size_t ModBinaryFile::getCellCount() const
+{
+    return (std::size_t)this->header->cellCount;
+}
+
+std::size_t ModBinaryFile::getConnectivitySize() const
+{
+    return (std::size_t)this->header->connectivitySize;
+}
+
+Material ModBinaryFile::getMaterial(std::size_t i) const
+{
+    const ModBinaryMaterial *materials = (const ModBinaryMaterial *)(this->data + this->header->materialOffset);
+    const char *strings = this->data + this->header->stringsOffset;
+    const ModBinaryMaterial &m = materials[i];
+
+    return Material(m.id, m.density,
+                    std::string(strings + m.colourOffset, (std::size_t)m.colourLength),
+                    std::string(strings + m.nameOffset, (std::size_t)m.nameLength));
+}
+
+const double *ModBinaryFile::getX() const
+{
+    return (const double *)(this->data + this->header->coordinateOffset);
+}
+
+const double *ModBinaryFile::getY() const
+{
+    return getX() + this->header->vertexCount;
+}
+
+const double *ModBinaryFile::getZ() const
+{
+    return getY() + this->header->vertexCount;
+}
+
+const char *ModBinaryFile::getCellTypes() const
+{
+    return this->data + this->header->cellTypeOffset;
+}
+
+const std::int32_t *ModBinaryFile::getCellMaterialIds() const
+{
+    return (const std::int32_t *)(this->data + this->header->cellMaterialOffset);
+}
+
+const std::uint64_t *ModBinaryFile::getCellOffsets() const
+{
+    return (const std::uint64_t *)(this->data + this->header->cellOffsetOffset);
+}
+
+const std::int32_t *ModBinaryFile::getConnectivity() const
+{
+    return (const std::int32_t *)(this->data + this->header->connectivityOffset);
+}
+
+const std::int64_t *ModBinaryFile::getVertexIds() const
+{
+    if (this->header->vertexIdCount == 0)
+    {
+        return nullptr;
+    }
+    return (const std::int64_t *)(this->data + this->header->vertexIdOffset);
+}
+
+const std::int64_t *ModBinaryFile::getCellIds() const
+{
+    if (this->header->cellIdCount == 0)
+    {
+        return nullptr;
+    }
+    return (const std::int64_t *)(this->data + this->header->cellIdOffset);
+}
+
+bool ModBinaryFile::hasMagic(const char *data, std::size_t size)
+{
+    return size >= 8 && std::memcmp(data, "13CADBIN", 8) == 0;
+}
+
+bool convertModToBinary(std::string modFilename, std::string binaryFilename, int threadCount)
+{
+    // Model silently loads nothing for missing files, so check first
+    MappedFile modFile(modFilename);
+    if (!modFile.isOpen())
+    {
+        return false;
+    }
+    modFile.close();
+
+    Model model(modFilename, threadCount);
+    return model.saveBinary(binaryFilename);
+}
@@ -6,6 +6,8 @@
  */
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -15,62 +17,73 @@
 #include "vector3d.h"
 #include "cell.h"
 #include "model.h"
+#include "cellstreamer.h"
+#include "mappedfile.h"
+#include "modbinary.h"
+#include "modparser.h"
+#include "parallel.h"
+#include "stlparser.h"
 
-Model::Model(std::string filename)
+Model::Model(std::string filename) : Model(filename, 1) {}
+
+Model::Model(std::string filename, int threadCount) : Model(filename, threadCount, nullptr) {}
+
+Model::Model(std::string filename, int threadCount, Arena *arena) : Model(filename, threadCount, arena, Precision::Double) {}
+
+Model::Model(std::string filename, int threadCount, Arena *arena, Precision precision)
+	: Model(filename, threadCount, arena, precision, nullptr) {}
+
+Model::Model(std::string filename, int threadCount, Arena *arena, Precision precision, LoadProgress *progress)
+	: Model(filename, threadCount, arena, precision, progress, nullptr) {}
+
+Model::Model(std::string filename, int threadCount, Arena *arena, Precision precision, LoadProgress *progress,
+			 CellStream *stream)
+	: vertices(arena, precision), materials(arena), cells(arena), triangles(arena),
+	  vertexIdMap(arena), cellIdMap(arena), materialIdMap(arena)
 {
-	std::ifstream modelFile(filename);
-	std::string line;
+	this->filename = filename;
+	this->isSTL = isExtension(filename, ".stl");
+
+	// Map the whole file and read it in place
+	MappedFile modelFile(filename);
+	if (!modelFile.isOpen())
+	{
+		return;
+	}
 
-	// Only parse it if it's not a STL file
-	if (!isExtension(filename, ".stl"))
+	if (this->isSTL)
 	{
-		if (modelFile.is_open())
+		// Triangles with welded vertices, reported as a single step
+		if (progress != nullptr)
 		{
-			this->isSTL = false;
-			// Read file line by line
-			while (std::getline(modelFile, line))
-			{
-				// Check first character
-				switch (line[0])
-				{
-				// Cell case
-				case 'c':
-					parseCell(line);
-					break;
-
-				// Vertex case
-				case 'v':
-					parseVertex(line);
-					break;
-
-				// Material case
-				case 'm':
-					parseMaterial(line);
-					break;
-				}
-			}
-			// Close file
-			modelFile.close();
+			progress->beginPhase("Reading STL file", 1);
+		}
+		StlParser parser(this->vertices, this->triangles);
+		parser.parse(modelFile.begin(), modelFile.end(), resolveThreadCount(threadCount), progress);
+		this->vertexIdMap.assignIdentity(this->vertices.size());
+	}
+	else if (ModBinaryFile::hasMagic(modelFile.begin(), modelFile.getSize()))
+	{
+		// Binary files that fail validation are not loaded at all
+		if (progress != nullptr)
+		{
+			progress->beginPhase("Reading binary file", 1);
+		}
+		ModBinaryFile binaryFile;
+		if (binaryFile.attach(modelFile.begin(), modelFile.getSize()))
+		{
+			loadBinary(binaryFile, resolveThreadCount(threadCount), progress);
 		}
 	}
 	else
 	{
-		this->isSTL = true;
+		parseBuffer(modelFile.begin(), modelFile.end(), resolveThreadCount(threadCount), progress, stream);
+		return;
 	}
-}
-
-std::vector<std::string> Model::splitString(std::string line)
-{
-	std::vector<std::string> strings;
-	std::istringstream f(line);
-	std::string s;
-
-	// Split string into space-separated words
-	while (std::getline(f, s, ' '))
+	if (progress != nullptr)
 	{
-		strings.push_back(s);
+		progress->advance(1);
 	}
-	return strings;
 }
 
 bool Model::isExtension(const std::string &str, const std::string &suffix)
@@ -79,125 +92,360 @@ bool Model::isExtension(const std::string &str, const std::string &suffix)
 		   str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
 }
 
-void Model::parseMaterial(std::string line)
+// Sort and deduplicate ids, then map each to a dense index in ID order
+template <class IdList>
+static void assignSortedIds(IdMap &map, IdList &ids)
 {
+	if (!std::is_sorted(ids.begin(), ids.end()))
+	{
+		std::sort(ids.begin(), ids.end());
+	}
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	map.assign(ids.data(), ids.size());
+}
+
+// Cells placed between two checks for a cancelled load
+static const int CELLS_PER_CANCEL_CHECK = 1 << 16;
 
-	std::vector<std::string> strings = splitString(line);
-	// Strings index:
-	// 0 - m
-	// 1 - ID
-	// 2 - Density
-	// 3 - Colour
-	// 4 - Name
+// Bytes of a chunk parsed between two updates of a cell stream
+static const std::ptrdiff_t STREAM_SLICE_SIZE = 1 << 22;
 
-	int id = std::stoi(strings[1]);
-	double density = std::stod(strings[2]);
-	std::string colour = strings[3];
-	std::string name = strings[4];
+// Cell of a .mod file with its references translated into indices
+struct ResolvedCell
+{
+	std::int64_t id;
+	char type;
+	int materialIndex;
+	int vertexIndices[8];
+};
+
+void Model::parseBuffer(const char *begin, const char *end, int threadCount, LoadProgress *progress,
+						CellStream *stream)
+{
+	// First pass: parse each chunk of lines into its own record lists
+	// Scratch memory of the load, one arena per chunk so that threads do not contend
+	std::vector<const char *> bounds = ModParser::splitIntoChunks(begin, end, threadCount);
+	std::vector<Arena> scratch(threadCount);
+	std::vector<ModParser> parsers;
+	parsers.reserve(threadCount);
+	for (int chunk = 0; chunk < threadCount; chunk++)
+	{
+		parsers.emplace_back(&scratch[chunk]);
+	}
 
-	// Strip the end of line character '\r' from the name string
-	// The reason why this happens is that the name of the material
-	// is the only time a string that happens to be at the end of the line
-	// gets parsed.
-	name.erase(std::remove(name.begin(), name.end(), '\r'), name.end());
+	if (progress != nullptr)
+	{
+		progress->beginPhase("Parsing", end - begin);
+	}
+	if (stream == nullptr)
+	{
+		parallelFor(threadCount, [&](int chunk) {
+			parsers[chunk].parse(bounds[chunk], bounds[chunk + 1], progress);
+		});
+	}
+	else
+	{
+		// Slices end at a line end, so that each is parsed whole
+		CellStreamer streamer(*stream, parsers);
+		parallelFor(threadCount, [&](int chunk) {
+			const char *slice = bounds[chunk];
+			while (slice < bounds[chunk + 1] && !isLoadCancelled(progress))
+			{
+				const char *sliceEnd = bounds[chunk + 1];
+				if (sliceEnd - slice > STREAM_SLICE_SIZE)
+				{
+					sliceEnd = ModParser::findLineEnd(slice + STREAM_SLICE_SIZE, sliceEnd);
+					sliceEnd += sliceEnd != bounds[chunk + 1] ? 1 : 0;
+				}
+				parsers[chunk].parse(slice, sliceEnd, progress);
+				slice = sliceEnd;
+				if (slice < bounds[chunk + 1])
+				{
+					streamer.update(chunk, false);
+				}
+			}
+			streamer.update(chunk, true);
+		});
+	}
+	if (isLoadCancelled(progress))
+	{
+		return;
+	}
 
-	Material m(id, density, colour, name);
+	// Give the material and vertex IDs dense indices, so that the storage
+	// is sized by the number of records rather than by the largest ID
+	typedef std::vector<std::int64_t, ArenaAllocator<std::int64_t>> IdList;
+	IdList materialIds(&scratch[0]);
+	IdList vertexIds(&scratch[0]);
+	for (int chunk = 0; chunk < threadCount; chunk++)
+	{
+		for (const MaterialRecord &record : parsers[chunk].getMaterials())
+		{
+			materialIds.push_back(record.id);
+		}
+		for (const VertexRecord &record : parsers[chunk].getVertices())
+		{
+			vertexIds.push_back(record.id);
+		}
+	}
+	assignSortedIds(this->materialIdMap, materialIds);
+	assignSortedIds(this->vertexIdMap, vertexIds);
+	if (isLoadCancelled(progress))
+	{
+		return;
+	}
+	this->materials.resize(this->materialIdMap.size());
+	this->vertices.resize(this->vertexIdMap.size());
 
-	// Resize materials vector if necessary
-	if (id >= this->materials.size())
+	// Merge materials and vertices in file order, so that the last
+	// definition of an ID wins
+	for (int chunk = 0; chunk < threadCount; chunk++)
 	{
-		this->materials.resize(id + 1);
+		const MaterialRecordList &records = parsers[chunk].getMaterials();
+		for (int i = 0; i < records.size(); i++)
+		{
+			const MaterialRecord &record = records[i];
+			this->materials.set(this->materialIdMap.find(record.id),
+								Material(record.id, record.density, record.colour.toString(), record.name.toString()));
+		}
 	}
 
-	this->materials[id] = m;
-}
+	for (int chunk = 0; chunk < threadCount; chunk++)
+	{
+		const VertexRecordList &records = parsers[chunk].getVertices();
+		for (int i = 0; i < records.size(); i++)
+		{
+			const VertexRecord &record = records[i];
+			this->vertices.set(this->vertexIdMap.find(record.id), record.x, record.y, record.z);
+		}
+	}
+	if (isLoadCancelled(progress))
+	{
+		return;
+	}
 
-void Model::parseVertex(std::string line)
-{
-	std::vector<std::string> strings = splitString(line);
-	// Strings index:
-	// 0 - v
-	// 1 - ID
-	// 2 - x
-	// 3 - y
-	// 4 - z
+	// Second pass: resolve cell references, again one chunk per thread
+	if (progress != nullptr)
+	{
+		long long recordCount = 0;
+		for (const ModParser &parser : parsers)
+		{
+			recordCount += parser.getCells().size();
+		}
+		progress->beginPhase("Resolving cells", recordCount);
+	}
+	typedef std::vector<ResolvedCell, ArenaAllocator<ResolvedCell>> ResolvedCellList;
+	std::vector<ResolvedCellList> chunkCells;
+	chunkCells.reserve(threadCount);
+	for (int chunk = 0; chunk < threadCount; chunk++)
+	{
+		chunkCells.emplace_back(ArenaAllocator<ResolvedCell>(&scratch[chunk]));
+	}
 
-	int id = std::stoi(strings[1]);
-	double x = std::stod(strings[2]);
-	double y = std::stod(strings[3]);
-	double z = std::stod(strings[4]);
+	parallelFor(threadCount, [&](int chunk) {
+		const CellRecordList &records = parsers[chunk].getCells();
+		chunkCells[chunk].reserve(records.size());
 
-	Vector3D v(x, y, z);
+		for (int i = 0; i < records.size(); i++)
+		{
+			const CellRecord &record = records[i];
+			ResolvedCell cell;
+			if (resolveCell(record, cell.materialIndex, cell.vertexIndices))
+			{
+				cell.id = record.id;
+				cell.type = record.type;
+				chunkCells[chunk].push_back(cell);
+			}
+		}
+		if (progress != nullptr)
+		{
+			progress->advance(records.size());
+		}
+	});
+	if (isLoadCancelled(progress))
+	{
+		return;
+	}
 
-	// Resize vertices vector if necessary
-	if (id >= this->vertices.size())
+	// Give the valid cells dense indices, then place them in file order,
+	// remembering which cell each index ended up with
+	IdList cellIds(&scratch[0]);
+	for (int chunk = 0; chunk < threadCount; chunk++)
+	{
+		for (const ResolvedCell &cell : chunkCells[chunk])
+		{
+			cellIds.push_back(cell.id);
+		}
+	}
+	assignSortedIds(this->cellIdMap, cellIds);
+	if (isLoadCancelled(progress))
 	{
-		this->vertices.resize(id + 1);
+		return;
 	}
 
-	this->vertices[id] = v;
+	std::vector<const ResolvedCell *, ArenaAllocator<const ResolvedCell *>> cellsByIndex(
+		this->cellIdMap.size(), nullptr, ArenaAllocator<const ResolvedCell *>(&scratch[0]));
+	for (int chunk = 0; chunk < threadCount; chunk++)
+	{
+		for (const ResolvedCell &cell : chunkCells[chunk])
+		{
+			cellsByIndex[this->cellIdMap.find(cell.id)] = &cell;
+		}
+	}
+	if (isLoadCancelled(progress))
+	{
+		return;
+	}
+
+	// Store the cells grouped by type, in ID order within each type
+	int typeCounts[256] = {0};
+	for (const ResolvedCell *cell : cellsByIndex)
+	{
+		typeCounts[(unsigned char)cell->type]++;
+	}
+	this->cells.reserve(typeCounts['t'], typeCounts['p'], typeCounts['h']);
+	this->cells.resize(cellsByIndex.size());
+	for (int index = 0; index < cellsByIndex.size(); index++)
+	{
+		if (index % CELLS_PER_CANCEL_CHECK == 0 && isLoadCancelled(progress))
+		{
+			return;
+		}
+		const ResolvedCell *cell = cellsByIndex[index];
+		this->cells.add(index, cell->type, cell->materialIndex, cell->vertexIndices);
+	}
 }
 
-void Model::parseCell(std::string line)
+void Model::loadBinary(const ModBinaryFile &file, int threadCount, const LoadProgress *progress)
 {
-	std::vector<std::string> strings = splitString(line);
-	// Strings index:
-	// 0 - c
-	// 1 - ID
-	// 2 - cell type:
-	//	   h - hexahedral
-	//	   p - pyramid
-	//     t - tetrahedral
-	// 3 - Material ID
-	// 4 and onwards - IDs of vertices which define the cell
+	int materialCount = file.getMaterialCount();
+	int vertexCount = file.getVertexCount();
+	int cellCount = file.getCellCount();
 
-	int id = std::stoi(strings[1]);
-	int matId = std::stoi(strings[3]);
-	Material mat = this->materials[matId];
-
-	std::vector<Vector3D> vertices;
+	// File IDs must be distinct, files that repeat one are not loaded
+	std::vector<std::int64_t> materialIds(materialCount);
+	for (int i = 0; i < materialCount; i++)
+	{
+		materialIds[i] = file.getMaterial(i).getId();
+	}
+	bool idsValid = this->materialIdMap.assign(materialIds.data(), materialCount);
+	if (file.getVertexIds() != nullptr)
+	{
+		idsValid = idsValid && this->vertexIdMap.assign(file.getVertexIds(), vertexCount);
+	}
+	else
+	{
+		this->vertexIdMap.assignIdentity(vertexCount);
+	}
+	if (file.getCellIds() != nullptr)
+	{
+		idsValid = idsValid && this->cellIdMap.assign(file.getCellIds(), cellCount);
+	}
+	else
+	{
+		this->cellIdMap.assignIdentity(cellCount);
+	}
+	if (!idsValid)
+	{
+		this->materialIdMap.clear();
+		this->vertexIdMap.clear();
+		this->cellIdMap.clear();
+		return;
+	}
+	if (isLoadCancelled(progress))
+	{
+		return;
+	}
 
-	// Fill vertices ID with the required IDs
-	for (int i = 4; i < strings.size(); i++)
+	this->materials.resize(materialCount);
+	for (int i = 0; i < materialCount; i++)
 	{
-		int vertexId = std::stoi(strings[i]);
-		Vector3D vertex = this->vertices[vertexId];
-		vertices.push_back(vertex);
+		this->materials.set(i, file.getMaterial(i));
 	}
 
-	// Resize cells vector if necessary
-	if (id >= this->cells.size())
+	const double *x = file.getX();
+	const double *y = file.getY();
+	const double *z = file.getZ();
+	this->vertices.assign(x, y, z, vertexCount);
+	if (isLoadCancelled(progress))
 	{
-		this->cells.resize(id + 1);
+		return;
 	}
 
-	// Check cell type
-	// Note: curly braces are to prevent initializators from leaking in
-	// other cases (also causes compiler error)
-	switch (strings[2][0])
+	// Check the cells, each thread taking a contiguous range of indices, and
+	// store the valid ones grouped by type, one column at a time
+	const char *types = file.getCellTypes();
+	const std::int32_t *materialIndices = file.getCellMaterialIds();
+	const std::uint64_t *offsets = file.getCellOffsets();
+	const std::int32_t *connectivity = file.getConnectivity();
+	std::vector<char> validTypes(cellCount, 0);
+
+	parallelFor(threadCount, [&](int thread) {
+		int first = (long long)cellCount * thread / threadCount;
+		int last = (long long)cellCount * (thread + 1) / threadCount;
+
+		for (int index = first; index < last; index++)
+		{
+			if ((index - first) % CELLS_PER_CANCEL_CHECK == 0 && isLoadCancelled(progress))
+			{
+				return;
+			}
+
+			// Cells that do not match their type or reference undefined
+			// vertices or materials are left unused
+			std::uint64_t cellVertexCount = offsets[index + 1] - offsets[index];
+			bool valid = types[index] != 0 && offsets[index] <= offsets[index + 1] && offsets[index + 1] <= file.getConnectivitySize() &&
+						 cellVertexCount == ModParser::getCellVertexCount(types[index]) &&
+						 isCellValid(types[index], materialIndices[index], connectivity + offsets[index], (int)cellVertexCount);
+			validTypes[index] = valid ? types[index] : 0;
+		}
+	});
+	if (isLoadCancelled(progress))
 	{
-	// Hexahedral case
-	case 'h':
+		return;
+	}
+
+	this->cells.assign(validTypes.data(), materialIndices, offsets, connectivity, cellCount, threadCount);
+}
+
+bool Model::resolveCell(const CellRecord &record, int &materialIndex, int *vertexIndices) const
+{
+	materialIndex = this->materialIdMap.find(record.materialId);
+	if (materialIndex < 0)
 	{
-		Hexahedron c(vertices, mat);
-		this->cells[id] = c;
-		break;
+		return false;
 	}
-	// Pyramid case
-	case 'p':
+
+	// Every referenced vertex must exist
+	for (int i = 0; i < record.vertexCount; i++)
 	{
-		Pyramid c(vertices, mat);
-		this->cells[id] = c;
-		break;
+		vertexIndices[i] = this->vertexIdMap.find(record.vertexIds[i]);
+		if (vertexIndices[i] < 0)
+		{
+			return false;
+		}
 	}
-	// Tetrahedral case
-	case 't':
+	return true;
+}
+
+bool Model::isCellValid(char type, int materialId, const int *vertexIds, int vertexCount)
+{
+	if (materialId < 0 || materialId >= this->materials.size())
 	{
-		Tetrahedron c(vertices, mat);
-		this->cells[id] = c;
-		break;
+		return false;
 	}
+
+	// Every referenced vertex must exist
+	for (int i = 0; i < vertexCount; i++)
+	{
+		if (vertexIds[i] < 0 || vertexIds[i] >= this->vertices.size())
+		{
+			return false;
+		}
 	}
+
+	// Check cell type
+	return type == 'h' || type == 'p' || type == 't';
 }
 
 std::string Model::getFilename()
@@ -211,35 +459,220 @@ bool Model::getIsSTL()
 }
 
 std::vector<Material> Model::getMaterials()
+{
+	return this->materials.toVector();
+}
+
+const MaterialTable &Model::getMaterialTable() const
 {
 	return this->materials;
 }
 
+ArrayView<Material> Model::getMaterialView() const
+{
+	return this->materials.getMaterials();
+}
+
 std::vector<Vector3D> Model::getVertices()
+{
+	return this->vertices.toVector();
+}
+
+const VertexStore &Model::getVertexStore() const
 {
 	return this->vertices;
 }
 
-std::vector<Cell> Model::getCells()
+Precision Model::getPrecision() const
+{
+	return this->vertices.getPrecision();
+}
+
+const IdMap &Model::getVertexIdMap() const
+{
+	return this->vertexIdMap;
+}
+
+const IdMap &Model::getCellIdMap() const
+{
+	return this->cellIdMap;
+}
+
+const IdMap &Model::getMaterialIdMap() const
+{
+	return this->materialIdMap;
+}
+
+const CellStore &Model::getCellStore() const
 {
 	return this->cells;
 }
 
-int Model::getMaterialCount()
+std::vector<Cell> Model::getCells()
+{
+	std::vector<Cell> cells(this->cells.getCellCount());
+
+	for (int id = 0; id < cells.size(); id++)
+	{
+		// Skip the invalid cells of binary files
+		if (this->cells.getType(id) == 0)
+		{
+			continue;
+		}
+		const int *vertexIds = this->cells.getVertexIds(id);
+		int materialId = this->cells.getMaterialId(id);
+
+		// Note: curly braces are to prevent initializators from leaking in
+		// other cases (also causes compiler error)
+		switch (this->cells.getType(id))
+		{
+		// Hexahedral case
+		case 'h':
+		{
+			Hexahedron c(vertexIds, &this->vertices, materialId, &this->materials);
+			cells[id] = c;
+			break;
+		}
+		// Pyramid case
+		case 'p':
+		{
+			Pyramid c(vertexIds, &this->vertices, materialId, &this->materials);
+			cells[id] = c;
+			break;
+		}
+		// Tetrahedral case
+		case 't':
+		{
+			Tetrahedron c(vertexIds, &this->vertices, materialId, &this->materials);
+			cells[id] = c;
+			break;
+		}
+		}
+	}
+	return cells;
+}
+
+CellRange Model::getCellView() const
+{
+	return CellRange(&this->cells, &this->vertices, &this->materials);
+}
+
+CellView Model::getCell(int id) const
+{
+	return CellView(&this->cells, &this->vertices, &this->materials, id);
+}
+
+int Model::getMaterialCount() const
 {
 	int count = this->materials.size();
 	return count;
 }
 
-int Model::getVertexCount()
+int Model::getVertexCount() const
 {
 	int count = this->vertices.size();
 	return count;
 }
 
-int Model::getCellCount()
+int Model::getCellCount() const
+{
+	int count = this->cells.getCellCount();
+	return count;
+}
+
+// Run a batch kernel over each cell type and store the results by cell ID
+template <class T, class Kernel>
+static std::vector<T> computeById(const CellStore &cells, Kernel kernel)
+{
+	std::vector<T> byId(cells.getCellCount(), T());
+	auto scatter = [&](const auto &cellArray) {
+		std::vector<T> results(cellArray.size());
+		kernel(cellArray, results.data());
+		for (int i = 0; i < cellArray.size(); i++)
+		{
+			byId[cellArray.getId(i)] = results[i];
+		}
+	};
+	scatter(cells.getTetrahedra());
+	scatter(cells.getPyramids());
+	scatter(cells.getHexahedra());
+	return byId;
+}
+
+std::vector<double> Model::getCellVolumes()
+{
+	std::vector<double> volumes;
+	this->vertices.visit([&](const auto &vertices) {
+		volumes = computeById<double>(this->cells, [&](const auto &cellArray, double *results) {
+			computeVolumes(cellArray, vertices, results);
+		});
+	});
+	return volumes;
+}
+
+std::vector<double> Model::getCellMasses()
+{
+	const double *densities = this->materials.getDensities();
+	std::vector<double> masses;
+	this->vertices.visit([&](const auto &vertices) {
+		masses = computeById<double>(this->cells, [&](const auto &cellArray, double *results) {
+			computeMasses(cellArray, vertices, densities, results);
+		});
+	});
+	return masses;
+}
+
+std::vector<Vector3D> Model::getCellCentres()
 {
-	int count = this->cells.size();
+	std::vector<Vector3D> centres;
+	this->vertices.visit([&](const auto &vertices) {
+		centres = computeById<Vector3D>(this->cells, [&](const auto &cellArray, Vector3D *results) {
+			computeCentres(cellArray, vertices, results);
+		});
+	});
+	return centres;
+}
+
+MassProperties Model::getMassProperties(int threadCount, const LoadProgress *progress) const
+{
+	return computeMassProperties(this->cells, this->vertices, this->materials, threadCount, progress);
+}
+
+FaceAdjacency Model::getFaceAdjacency(int threadCount) const
+{
+	return buildFaceAdjacency(this->cells, threadCount);
+}
+
+BoundarySurface Model::getBoundarySurface(int threadCount, const LoadProgress *progress) const
+{
+	return extractBoundarySurface(this->cells, this->vertices, buildFaceAdjacency(this->cells, threadCount, progress),
+								  threadCount, progress);
+}
+
+const VertexCellIndex &Model::getVertexCellIndex(int threadCount) const
+{
+	return this->vertexCellIndex.get(
+		[&]() { return buildVertexCellIndex(this->cells, this->vertices.size(), threadCount); });
+}
+
+ArrayView<int> Model::getVertexCells(int id) const
+{
+	return getVertexCellIndex().getCells(id);
+}
+
+std::vector<int> Model::getTriangles()
+{
+	return std::vector<int>(this->triangles.begin(), this->triangles.end());
+}
+
+ArrayView<int> Model::getTriangleView() const
+{
+	return ArrayView<int>(this->triangles.data(), this->triangles.size());
+}
+
+int Model::getTriangleCount()
+{
+	int count = this->triangles.size() / 3;
 	return count;
 }
 
@@ -251,23 +684,12 @@ std::string Model::getCellList()
 
 Vector3D Model::getCentre()
 {
-	double x_sum = 0;
-	double y_sum = 0;
-	double z_sum = 0;
-
-	for (int i = 0; i < this->vertices.size(); i++)
-	{
-		x_sum += this->vertices[i].getX();
-		y_sum += this->vertices[i].getY();
-		z_sum += this->vertices[i].getZ();
-	}
-
-	double x = x_sum / this->vertices.size();
-	double y = y_sum / this->vertices.size();
-	double z = z_sum / this->vertices.size();
+	return this->vertices.getCentroid();
+}
 
-	Vector3D centre(x, y, z);
-	return centre;
+bool Model::getBounds(Vector3D &min, Vector3D &max)
+{
+	return this->vertices.getBounds(min, max);
 }
 
 // Copy model to specified filename
@@ -297,10 +719,10 @@ void Model::saveToFile(std::string filename)
 			// 1 - Density
 			// 2 - Colour
 			// 3 - Name
-			mStrings.push_back(std::to_string(this->materials[i].getId()));
-			mStrings.push_back(std::to_string(this->materials[i].getDensity()));
-			mStrings.push_back(this->materials[i].getColour());
-			mStrings.push_back(this->materials[i].getName());
+			mStrings.push_back(std::to_string(this->materials.get(i).getId()));
+			mStrings.push_back(std::to_string(this->materials.get(i).getDensity()));
+			mStrings.push_back(this->materials.get(i).getColour());
+			mStrings.push_back(this->materials.get(i).getName());
 
 			// Save the material to file
 			outFile << "m ";
@@ -327,7 +749,7 @@ void Model::saveToFile(std::string filename)
 			// 1 - x
 			// 2 - y
 			// 3 - z
-			vStrings.push_back(std::to_string(i));
+			vStrings.push_back(std::to_string(this->vertexIdMap.getId(i)));
 			vStrings.push_back(std::to_string(this->vertices[i].getX()));
 			vStrings.push_back(std::to_string(this->vertices[i].getY()));
 			vStrings.push_back(std::to_string(this->vertices[i].getZ()));
@@ -348,11 +770,16 @@ void Model::saveToFile(std::string filename)
 
 		// Save cells
 		outFile << "### CELLS ###\n";
-		for (int i = 0; i < this->cells.size(); i++)
+		for (int i = 0; i < this->cells.getCellCount(); i++)
 		{
+			// Skip the invalid cells of binary files
+			if (this->cells.getType(i) == 0)
+			{
+				continue;
+			}
+
 			// Obtain information about the cell
 			std::vector<std::string> cStrings;
-			std::vector<Vector3D> cVertices = this->cells[i].getVertices();
 			// Strings index:
 			// 0 - ID
 			// 1 - cell type:
@@ -361,17 +788,14 @@ void Model::saveToFile(std::string filename)
 			//     t - tetrahedral
 			// 2 - Material ID
 			// 3 and onwards - IDs of vertices which define the cell
-			cStrings.push_back(std::to_string(i));
-
-			// TODO: Implement vertex index saving in cells, right now only
-			// the coordinates are saved; this causes me to be unable to
-			// save cells properly
-			// // Get vertices c
-			// for (int l = 0; l < cVertices.size(); l++) {
-			// 	cStrings.push_back(std::to_string(cVertices[l].getX()));
-			// 	cStrings.push_back(std::to_string(cVertices[l].getY()));
-			// 	cStrings.push_back(std::to_string(cVertices[l].getZ()));
-			// }
+			cStrings.push_back(std::to_string(this->cellIdMap.getId(i)));
+			cStrings.push_back(std::string(1, this->cells.getType(i)));
+			cStrings.push_back(std::to_string(this->materialIdMap.getId(this->cells.getMaterialId(i))));
+			const int *vertexIds = this->cells.getVertexIds(i);
+			for (int j = 0; j < this->cells.getVertexCount(i); j++)
+			{
+				cStrings.push_back(std::to_string(this->vertexIdMap.getId(vertexIds[j])));
+			}
 
 			// Save the cell to file
 			outFile << "c ";
@@ -386,4 +810,148 @@ void Model::saveToFile(std::string filename)
 
 		outFile.close();
 	}
-}
\ No newline at end of file
+}
+
+// Append padding so that the next section starts at a multiple of 8 bytes
+static void writePadding(std::ofstream &outFile, std::uint64_t &offset)
+{
+	static const char zeros[8] = {0};
+	std::uint64_t padding = (8 - offset % 8) % 8;
+	outFile.write(zeros, padding);
+	offset += padding;
+}
+
+// Write a coordinate column, which the binary format stores in double
+static void writeColumn(std::ofstream &outFile, const double *column, int count)
+{
+	outFile.write((const char *)column, count * sizeof(double));
+}
+
+static void writeColumn(std::ofstream &outFile, const float *column, int count)
+{
+	std::vector<double> widened(column, column + count);
+	writeColumn(outFile, widened.data(), count);
+}
+
+// Save model to specified filename in the binary format
+bool Model::saveBinary(std::string filename)
+{
+	std::ofstream outFile(filename, std::ios::binary);
+	if (!outFile.is_open())
+	{
+		return false;
+	}
+
+	std::uint64_t materialCount = this->materials.size();
+	std::uint64_t vertexCount = this->vertices.size();
+	std::uint64_t cellCount = this->cells.getCellCount();
+
+	// Build the material table and the strings it points to
+	std::vector<ModBinaryMaterial> materialTable(materialCount);
+	std::string strings;
+	for (int i = 0; i < materialCount; i++)
+	{
+		std::string colour = this->materials.get(i).getColour();
+		std::string name = this->materials.get(i).getName();
+
+		ModBinaryMaterial &entry = materialTable[i];
+		entry.id = this->materials.get(i).getId();
+		entry.reserved = 0;
+		entry.density = this->materials.get(i).getDensity();
+		entry.colourOffset = strings.size();
+		entry.colourLength = colour.size();
+		strings += colour;
+		entry.nameOffset = strings.size();
+		entry.nameLength = name.size();
+		strings += name;
+	}
+
+	// Lay out the sections (see modbinary.h)
+	ModBinaryHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, "13CADBIN", 8);
+	header.version = MOD_BINARY_VERSION;
+	header.byteOrderMark = 0x01020304;
+	header.materialCount = materialCount;
+	header.vertexCount = vertexCount;
+	header.cellCount = cellCount;
+	header.connectivitySize = this->cells.getConnectivitySize();
+	header.stringsSize = strings.size();
+
+	std::uint64_t offset = sizeof(header);
+	header.materialOffset = offset;
+	offset += materialCount * sizeof(ModBinaryMaterial);
+	header.stringsOffset = offset;
+	offset += (strings.size() + 7) / 8 * 8;
+	header.coordinateOffset = offset;
+	offset += 3 * vertexCount * sizeof(double);
+	header.cellTypeOffset = offset;
+	offset += (cellCount + 7) / 8 * 8;
+	header.cellMaterialOffset = offset;
+	offset += (cellCount * sizeof(std::int32_t) + 7) / 8 * 8;
+	header.cellOffsetOffset = offset;
+	offset += (cellCount + 1) * sizeof(std::uint64_t);
+	header.connectivityOffset = offset;
+	offset += (header.connectivitySize * sizeof(std::int32_t) + 7) / 8 * 8;
+	header.vertexIdCount = this->vertexIdMap.isIdentity() ? 0 : vertexCount;
+	header.vertexIdOffset = offset;
+	offset += header.vertexIdCount * sizeof(std::int64_t);
+	header.cellIdCount = this->cellIdMap.isIdentity() ? 0 : cellCount;
+	header.cellIdOffset = offset;
+	offset += header.cellIdCount * sizeof(std::int64_t);
+	header.fileSize = offset;
+
+	// Write the sections in order
+	std::uint64_t written = 0;
+	outFile.write((const char *)&header, sizeof(header));
+	outFile.write((const char *)materialTable.data(), materialCount * sizeof(ModBinaryMaterial));
+	outFile.write(strings.data(), strings.size());
+	written = header.stringsOffset + strings.size();
+	writePadding(outFile, written);
+
+	// Coordinates are stored as separate x, y and z columns, like in memory
+	this->vertices.visit([&](const auto &vertices) {
+		writeColumn(outFile, vertices.getX(), vertexCount);
+		writeColumn(outFile, vertices.getY(), vertexCount);
+		writeColumn(outFile, vertices.getZ(), vertexCount);
+	});
+
+	// Cells are stored by index in the file, rebuild the columns from the per-type arrays
+	std::vector<char> types(cellCount);
+	std::vector<std::int32_t> materialIds(cellCount, 0);
+	std::vector<std::uint64_t> offsets(cellCount + 1, 0);
+	std::vector<std::int32_t> connectivity;
+	connectivity.reserve(header.connectivitySize);
+	for (int id = 0; id < cellCount; id++)
+	{
+		types[id] = this->cells.getType(id);
+		if (types[id] != 0)
+		{
+			materialIds[id] = this->cells.getMaterialId(id);
+			connectivity.insert(connectivity.end(), this->cells.getVertexIds(id),
+								this->cells.getVertexIds(id) + this->cells.getVertexCount(id));
+		}
+		offsets[id + 1] = connectivity.size();
+	}
+
+	outFile.write(types.data(), cellCount);
+	written = header.cellTypeOffset + cellCount;
+	writePadding(outFile, written);
+
+	outFile.write((const char *)materialIds.data(), cellCount * sizeof(std::int32_t));
+	written += cellCount * sizeof(std::int32_t);
+	writePadding(outFile, written);
+
+	outFile.write((const char *)offsets.data(), (cellCount + 1) * sizeof(std::uint64_t));
+
+	outFile.write((const char *)connectivity.data(), header.connectivitySize * sizeof(std::int32_t));
+	written = header.connectivityOffset + header.connectivitySize * sizeof(std::int32_t);
+	writePadding(outFile, written);
+
+	// File IDs, only when they are not the indices
+	outFile.write((const char *)this->vertexIdMap.getIds(), header.vertexIdCount * sizeof(std::int64_t));
+	outFile.write((const char *)this->cellIdMap.getIds(), header.cellIdCount * sizeof(std::int64_t));
+
+	outFile.close();
+	return !outFile.fail();
+}
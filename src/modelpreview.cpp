@@ -0,0 +1,120 @@
+/**
+ * @file modelpreview.cpp
+ * @brief Source file for the ModelPreview class
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#include "modelpreview.h"
+
+#include <algorithm>
+
+#include "loadprogress.h"
+#include "mappedfile.h"
+#include "modbinary.h"
+#include "modparser.h"
+
+// Lines looked at after each sampled offset before giving up on it, which
+// bounds the work spent in the cell section of a file
+static const int SAMPLE_LINE_LIMIT = 4;
+
+void ModelPreview::add(const Vector3D &point)
+{
+    if (this->points.empty())
+    {
+        this->min = point;
+        this->max = point;
+    }
+    else
+    {
+        this->min = Vector3D(std::min(this->min.getX(), point.getX()), std::min(this->min.getY(), point.getY()),
+                             std::min(this->min.getZ(), point.getZ()));
+        this->max = Vector3D(std::max(this->max.getX(), point.getX()), std::max(this->max.getY(), point.getY()),
+                             std::max(this->max.getZ(), point.getZ()));
+    }
+    this->points.push_back(point);
+}
+
+static bool isStlFile(const std::string &filename)
+{
+    return filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".stl") == 0;
+}
+
+static void sampleBinary(const ModBinaryFile &file, int sampleCount, const LoadProgress *progress,
+                         ModelPreview &preview)
+{
+    std::size_t vertexCount = file.getVertexCount();
+    std::size_t count = vertexCount < (std::size_t)sampleCount ? vertexCount : sampleCount;
+    for (std::size_t s = 0; s < count && !isLoadCancelled(progress); s++)
+    {
+        std::size_t i = vertexCount * s / count;
+        preview.add(Vector3D(file.getX()[i], file.getY()[i], file.getZ()[i]));
+    }
+}
+
+static void sampleText(const char *begin, const char *end, int sampleCount, const LoadProgress *progress,
+                       ModelPreview &preview)
+{
+    std::size_t size = end - begin;
+    const char *sampledEnd = begin;
+    for (int s = 0; s < sampleCount && !isLoadCancelled(progress); s++)
+    {
+        // Start at the first line beginning at or after the sampled offset
+        const char *lineBegin = begin + size * s / sampleCount;
+        if (lineBegin != begin && lineBegin[-1] != '\n')
+        {
+            lineBegin = ModParser::findLineEnd(lineBegin, end);
+            lineBegin += lineBegin != end ? 1 : 0;
+        }
+
+        // Offsets closer than a line apart would land on the same one
+        lineBegin = std::max(lineBegin, sampledEnd);
+
+        for (int k = 0; k < SAMPLE_LINE_LIMIT && lineBegin < end; k++)
+        {
+            const char *lineEnd = ModParser::findLineEnd(lineBegin, end);
+            const char *next = lineEnd + (lineEnd != end ? 1 : 0);
+
+            VertexRecord record;
+            if (lineEnd - lineBegin > 1 && lineBegin[0] == 'v' && (lineBegin[1] == ' ' || lineBegin[1] == '\t') &&
+                ModParser::readVertex(lineBegin, lineEnd, record))
+            {
+                preview.add(Vector3D(record.x, record.y, record.z));
+                sampledEnd = next;
+                break;
+            }
+            lineBegin = next;
+        }
+    }
+}
+
+ModelPreview readModelPreview(const std::string &filename, int sampleCount, const LoadProgress *progress)
+{
+    ModelPreview preview;
+    if (sampleCount <= 0 || isStlFile(filename))
+    {
+        return preview;
+    }
+
+    MappedFile modelFile(filename);
+    if (!modelFile.isOpen())
+    {
+        return preview;
+    }
+
+    if (ModBinaryFile::hasMagic(modelFile.begin(), modelFile.getSize()))
+    {
+        ModBinaryFile binaryFile;
+        if (binaryFile.attach(modelFile.begin(), modelFile.getSize()))
+        {
+            sampleBinary(binaryFile, sampleCount, progress, preview);
+        }
+    }
+    else
+    {
+        sampleText(modelFile.begin(), modelFile.end(), sampleCount, progress, preview);
+    }
+
+    // A cancelled sample stops part way through and is not worth showing
+    return isLoadCancelled(progress) ? ModelPreview() : preview;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file modparser.cpp
+ * @brief Source file for the ModParser class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "modparser.h"
+#include "modtokenizer.h"
+
+// Number of bytes parsed between two progress reports
+static const long long PROGRESS_STEP = 1 << 20;
+
+void ModParser::parse(const char *begin, const char *end, LoadProgress *progress)
+{
+    const char *lineBegin = begin;
+    const char *reported = begin;
+
+    // Read buffer line by line
+    while (lineBegin < end)
+    {
+        const char *lineEnd = findLineEnd(lineBegin, end);
+
+        // Check first character
+        switch (*lineBegin)
+        {
+        // Cell case
+        case 'c':
+            parseCell(lineBegin, lineEnd);
+            break;
+
+        // Vertex case
+        case 'v':
+            parseVertex(lineBegin, lineEnd);
+            break;
+
+        // Material case
+        case 'm':
+            parseMaterial(lineBegin, lineEnd);
+            break;
+        }
+
+        lineBegin = lineEnd + 1;
+
+        if (progress != nullptr && lineEnd - reported >= PROGRESS_STEP)
+        {
+            progress->advance(lineEnd - reported);
+            reported = lineEnd;
+            if (progress->isCancelled())
+            {
+                return;
+            }
+        }
+    }
+
+    if (progress != nullptr)
+    {
+        progress->advance(end - reported);
+    }
+}
+
+void ModParser::parseMaterial(const char *begin, const char *end)
+{
+    MaterialRecord record;
+    if (readMaterial(begin, end, record))
+    {
+        this->materials.push_back(record);
+    }
+}
+
+void ModParser::parseVertex(const char *begin, const char *end)
+{
+    VertexRecord record;
+    if (readVertex(begin, end, record))
+    {
+        this->vertices.push_back(record);
+    }
+}
+
+void ModParser::parseCell(const char *begin, const char *end)
+{
+    CellRecord record;
+    if (readCell(begin, end, record))
+    {
+        this->cells.push_back(record);
+    }
+}
+
+bool ModParser::readMaterial(const char *begin, const char *end, MaterialRecord &record)
+{
+    StringSpan strings[5];
+    // Strings index:
+    // 0 - m
+    // 1 - ID
+    // 2 - Density
+    // 3 - Colour
+    // 4 - Name
+    // Note: '\r' is treated as a separator, so line endings never end up
+    // in the name of the material
+    if (splitTokens(begin, end, strings, 5) < 5)
+    {
+        return false;
+    }
+
+    if (!parseInteger(strings[1], record.id) || record.id < 0 || !parseDouble(strings[2], record.density))
+    {
+        return false;
+    }
+    record.colour = strings[3];
+    record.name = strings[4];
+    return true;
+}
+
+bool ModParser::readVertex(const char *begin, const char *end, VertexRecord &record)
+{
+    StringSpan strings[5];
+    // Strings index:
+    // 0 - v
+    // 1 - ID
+    // 2 - x
+    // 3 - y
+    // 4 - z
+    if (splitTokens(begin, end, strings, 5) < 5)
+    {
+        return false;
+    }
+
+    long long id;
+    if (!parseInteger(strings[1], id) || id < 0)
+    {
+        return false;
+    }
+    record.id = id;
+    return parseDouble(strings[2], record.x) && parseDouble(strings[3], record.y) && parseDouble(strings[4], record.z);
+}
+
+bool ModParser::readCell(const char *begin, const char *end, CellRecord &record)
+{
+    StringSpan strings[12];
+    // Strings index:
+    // 0 - c
+    // 1 - ID
+    // 2 - cell type:
+    //	   h - hexahedral
+    //	   p - pyramid
+    //     t - tetrahedral
+    // 3 - Material ID
+    // 4 and onwards - IDs of vertices which define the cell
+    int count = splitTokens(begin, end, strings, 12);
+    if (count < 4)
+    {
+        return false;
+    }
+
+    record.type = *strings[2].begin;
+    record.vertexCount = getCellVertexCount(record.type);
+    if (record.vertexCount == 0 || count < 4 + record.vertexCount)
+    {
+        return false;
+    }
+    long long id;
+    if (!parseInteger(strings[1], id) || id < 0 || !parseInteger(strings[3], record.materialId))
+    {
+        return false;
+    }
+    record.id = id;
+
+    for (int i = 0; i < record.vertexCount; i++)
+    {
+        if (!parseInteger(strings[4 + i], id))
+        {
+            return false;
+        }
+        record.vertexIds[i] = id;
+    }
+    return true;
+}
+
+const MaterialRecordList &ModParser::getMaterials() const
+{
+    return this->materials;
+}
+
+const VertexRecordList &ModParser::getVertices() const
+{
+    return this->vertices;
+}
+
+const CellRecordList &ModParser::getCells() const
+{
+    return this->cells;
+}
+
+const char *ModParser::findLineEnd(const char *begin, const char *end)
+{
+    const char *lineEnd = (const char *)std::memchr(begin, '\n', end - begin);
+    return lineEnd == nullptr ? end : lineEnd;
+}
+
+std::vector<const char *> ModParser::splitIntoChunks(const char *begin, const char *end, int chunkCount)
+{
+    std::vector<const char *> bounds;
+    bounds.push_back(begin);
+
+    std::size_t size = end - begin;
+    for (int i = 1; i < chunkCount; i++)
+    {
+        // Move the nominal split point forward to the start of the next line
+        const char *split = begin + size * i / chunkCount;
+        if (split < bounds.back())
+        {
+            split = bounds.back();
+        }
+        if (split > begin && split < end && split[-1] != '\n')
+        {
+            const char *lineEnd = findLineEnd(split, end);
+            split = lineEnd == end ? end : lineEnd + 1;
+        }
+        bounds.push_back(split);
+    }
+
+    bounds.push_back(end);
+    return bounds;
+}
+
+int ModParser::getCellVertexCount(char type)
+{
+    switch (type)
+    {
+    case 'h':
+        return 8;
+    case 'p':
+        return 5;
+    case 't':
+        return 4;
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file modparser.h
+ * @brief Header file for the ModParser class and .mod record types
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef MODPARSER_H
+#define MODPARSER_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "arena.h"
+#include "loadprogress.h"
+#include "modtokenizer.h"
+
+/**
+ * Vertex line ("v ID x y z") as read from the file.
+ */
+struct VertexRecord
+{
+    std::int64_t id;
+    double x;
+    double y;
+    double z;
+};
+
+/**
+ * Material line ("m ID density colour name") as read from the file.
+ * The strings point into the parsed buffer.
+ */
+struct MaterialRecord
+{
+    int id;
+    double density;
+    StringSpan colour;
+    StringSpan name;
+};
+
+/**
+ * Cell line ("c ID type materialID vertexIDs...") as read from the file.
+ * References are kept as IDs and resolved once the whole file is read.
+ * Vertex and cell IDs are 64-bit, material IDs are int like Material's.
+ */
+struct CellRecord
+{
+    std::int64_t id;
+    char type;
+    int materialId;
+    int vertexCount;
+    std::int64_t vertexIds[8];
+};
+
+// Record lists grow in fixed-size segments rather than by reallocation,
+// so that records kept in an arena do not leave old copies behind
+typedef std::deque<MaterialRecord, ArenaAllocator<MaterialRecord>> MaterialRecordList;
+typedef std::deque<VertexRecord, ArenaAllocator<VertexRecord>> VertexRecordList;
+typedef std::deque<CellRecord, ArenaAllocator<CellRecord>> CellRecordList;
+
+/**
+ * Parses a range of .mod lines into plain records without resolving any
+ * cross-references, so that separate chunks of a file can be parsed
+ * independently (and concurrently).
+ */
+class ModParser
+{
+  private:
+    /**
+    * Material records in the order they were read
+    */
+    MaterialRecordList materials;
+
+    /**
+    * Vertex records in the order they were read
+    */
+    VertexRecordList vertices;
+
+    /**
+    * Cell records in the order they were read
+    */
+    CellRecordList cells;
+
+  public:
+    ModParser() {}
+
+    /**
+    * Keep the records in arena (the heap if nullptr), which must outlive the parser
+    */
+    explicit ModParser(Arena *arena) : materials(arena), vertices(arena), cells(arena) {}
+
+    /**
+    * Parse every line in [begin, end), appending to the record lists.
+    * If progress is given, the bytes read are added to it as parsing goes
+    * and parsing stops early once it is cancelled.
+    */
+    void parse(const char *begin, const char *end, LoadProgress *progress = nullptr);
+
+    // Parsing functions (one line each, malformed lines are skipped)
+
+    /**
+    * Parse vertex line
+    */
+    void parseVertex(const char *begin, const char *end);
+
+    /**
+    * Parse material line
+    */
+    void parseMaterial(const char *begin, const char *end);
+
+    /**
+    * Parse cell line
+    */
+    void parseCell(const char *begin, const char *end);
+
+    // Record readers (one line each, return false for malformed lines)
+
+    /**
+    * Read vertex line into a record
+    */
+    static bool readVertex(const char *begin, const char *end, VertexRecord &record);
+
+    /**
+    * Read material line into a record
+    */
+    static bool readMaterial(const char *begin, const char *end, MaterialRecord &record);
+
+    /**
+    * Read cell line into a record
+    */
+    static bool readCell(const char *begin, const char *end, CellRecord &record);
+
+    // Accessors
+
+    /**
+    * Get material records
+    */
+    const MaterialRecordList &getMaterials() const;
+
+    /**
+    * Get vertex records
+    */
+    const VertexRecordList &getVertices() const;
+
+    /**
+    * Get cell records
+    */
+    const CellRecordList &getCells() const;
+
+    // Misc functions
+
+    /**
+    * Return the end of the line starting at begin (the '\n' or end)
+    */
+    static const char *findLineEnd(const char *begin, const char *end);
+
+    /**
+    * Split [begin, end) into chunkCount ranges that start at the beginning
+    * of a line. Returns chunkCount + 1 boundaries.
+    */
+    static std::vector<const char *> splitIntoChunks(const char *begin, const char *end, int chunkCount);
+
+    /**
+    * Return the number of vertices of a cell type ('h', 'p' or 't'), 0 if unknown
+    */
+    static int getCellVertexCount(char type);
+};
+
+#endif /* MODPARSER_H */
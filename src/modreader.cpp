@@ -0,0 +1,148 @@
+/**
+ * @file modreader.cpp
+ * @brief Source file for the ModReader and ModVisitor classes
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "modreader.h"
+#include "modparser.h"
+
+ModVisitor::~ModVisitor() {}
+
+void ModVisitor::visitMaterial(const Material & /* material */) {}
+
+void ModVisitor::visitVertex(std::int64_t /* id */, const Vector3D & /* vertex */) {}
+
+void ModVisitor::visitCell(std::int64_t /* id */, char /* type */, int /* materialId */,
+                           const std::vector<std::int64_t> & /* vertexIds */)
+{
+}
+
+ModReader::ModReader(std::string filename, std::size_t blockSize)
+{
+    this->ownedStream.reset(new std::ifstream(filename, std::ios::binary));
+    this->stream = this->ownedStream.get();
+    this->blockSize = blockSize > 0 ? blockSize : 1;
+}
+
+ModReader::ModReader(std::istream &stream, std::size_t blockSize)
+{
+    this->stream = &stream;
+    this->blockSize = blockSize > 0 ? blockSize : 1;
+}
+
+ModReader::~ModReader() {}
+
+bool ModReader::isOpen()
+{
+    if (this->ownedStream)
+    {
+        return this->ownedStream->is_open();
+    }
+    return this->stream->good();
+}
+
+bool ModReader::read(ModVisitor &visitor)
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    std::vector<char> buffer(this->blockSize);
+    std::vector<std::int64_t> vertexIds;
+    vertexIds.reserve(8);
+
+    // Number of bytes at the front of the buffer left over from the
+    // previous block (an incomplete line)
+    std::size_t carried = 0;
+
+    while (true)
+    {
+        // A line longer than the whole buffer: grow it to fit
+        if (carried == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2);
+        }
+
+        this->stream->read(buffer.data() + carried, buffer.size() - carried);
+        std::size_t filled = carried + (std::size_t)this->stream->gcount();
+        bool finished = !this->stream->good();
+
+        const char *begin = buffer.data();
+        const char *end = begin + filled;
+        const char *lineBegin = begin;
+
+        // Process every complete line in the buffer
+        while (lineBegin < end)
+        {
+            const char *lineEnd = ModParser::findLineEnd(lineBegin, end);
+            if (lineEnd == end && !finished)
+            {
+                break;
+            }
+            parseLine(lineBegin, lineEnd, visitor, vertexIds);
+            lineBegin = lineEnd + 1;
+        }
+
+        if (finished)
+        {
+            break;
+        }
+
+        // Move the incomplete last line to the front of the buffer
+        carried = end - lineBegin;
+        std::memmove(buffer.data(), lineBegin, carried);
+    }
+
+    return !this->stream->bad();
+}
+
+void ModReader::parseLine(const char *begin, const char *end, ModVisitor &visitor,
+                          std::vector<std::int64_t> &vertexIds)
+{
+    // Check first character
+    switch (*begin)
+    {
+    // Cell case
+    case 'c':
+    {
+        CellRecord record;
+        if (ModParser::readCell(begin, end, record))
+        {
+            vertexIds.assign(record.vertexIds, record.vertexIds + record.vertexCount);
+            visitor.visitCell(record.id, record.type, record.materialId, vertexIds);
+        }
+        break;
+    }
+
+    // Vertex case
+    case 'v':
+    {
+        VertexRecord record;
+        if (ModParser::readVertex(begin, end, record))
+        {
+            const Vector3D vertex(record.x, record.y, record.z);
+            visitor.visitVertex(record.id, vertex);
+        }
+        break;
+    }
+
+    // Material case
+    case 'm':
+    {
+        MaterialRecord record;
+        if (ModParser::readMaterial(begin, end, record))
+        {
+            const Material material(record.id, record.density, record.colour.toString(), record.name.toString());
+            visitor.visitMaterial(material);
+        }
+        break;
+    }
+    }
+}
@@ -0,0 +1,315 @@
+/**
+ * @file modtokenizer.h
+ * @brief Allocation-free tokenizing and number conversion for .mod files
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef MODTOKENIZER_H
+#define MODTOKENIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <string>
+
+/**
+ * Non-owning view of a range of characters, [begin, end).
+ */
+struct StringSpan
+{
+    const char *begin;
+    const char *end;
+
+    /**
+    * Return number of characters in the span
+    */
+    std::size_t size() const { return (std::size_t)(end - begin); }
+
+    /**
+    * Return true if the span has no characters
+    */
+    bool empty() const { return begin == end; }
+
+    /**
+    * Copy the span into a std::string
+    */
+    std::string toString() const { return std::string(begin, end); }
+};
+
+/**
+ * Return true for the characters that separate words in a .mod line.
+ * '\r' is included so that files with Windows line endings parse cleanly.
+ */
+inline bool isSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Return true if c is a decimal digit
+ */
+inline bool isDigit(char c)
+{
+    return (unsigned)(c - '0') < 10u;
+}
+
+/**
+ * Split [begin, end) into separator-delimited words without copying them.
+ * At most maxTokens words are stored; the return value is the number stored.
+ */
+inline int splitTokens(const char *begin, const char *end, StringSpan *tokens, int maxTokens)
+{
+    int count = 0;
+    const char *p = begin;
+
+    while (count < maxTokens)
+    {
+        while (p != end && isSeparator(*p))
+        {
+            ++p;
+        }
+        if (p == end)
+        {
+            break;
+        }
+
+        const char *wordBegin = p;
+        while (p != end && !isSeparator(*p))
+        {
+            ++p;
+        }
+        tokens[count].begin = wordBegin;
+        tokens[count].end = p;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Convert a whole token to an integer, in the manner of std::from_chars.
+ * Returns false (leaving value untouched) if the token is not a valid
+ * integer or does not fit in a long long.
+ */
+inline bool parseInteger(const StringSpan &token, long long &value)
+{
+    const char *p = token.begin;
+    bool negative = false;
+
+    if (p != token.end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (p == token.end)
+    {
+        return false;
+    }
+
+    unsigned long long magnitude = 0;
+    const unsigned long long limit = negative ? (unsigned long long)LLONG_MAX + 1 : (unsigned long long)LLONG_MAX;
+    for (; p != token.end; ++p)
+    {
+        if (!isDigit(*p))
+        {
+            return false;
+        }
+        unsigned digit = (unsigned)(*p - '0');
+        if (magnitude > (limit - digit) / 10)
+        {
+            return false;
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+
+    value = negative ? (long long)(0 - magnitude) : (long long)magnitude;
+    return true;
+}
+
+/**
+ * Convert a whole token to an int (see parseInteger(const StringSpan &, long long &))
+ */
+inline bool parseInteger(const StringSpan &token, int &value)
+{
+    long long wide;
+    if (!parseInteger(token, wide) || wide < INT_MIN || wide > INT_MAX)
+    {
+        return false;
+    }
+    value = (int)wide;
+    return true;
+}
+
+/**
+ * Fallback for parseDouble: NUL-terminate the token and hand it to strtod.
+ */
+inline bool parseDoubleSlow(const StringSpan &token, double &value)
+{
+    char buffer[64];
+    std::string longToken;
+    const char *text;
+    std::size_t length = token.size();
+
+    if (length == 0)
+    {
+        return false;
+    }
+
+    // Tokens are not NUL-terminated in the mapped file, so copy them first
+    if (length < sizeof(buffer))
+    {
+        std::memcpy(buffer, token.begin, length);
+        buffer[length] = '\0';
+        text = buffer;
+    }
+    else
+    {
+        longToken.assign(token.begin, token.end);
+        text = longToken.c_str();
+    }
+
+    char *parsedEnd;
+    double parsed = std::strtod(text, &parsedEnd);
+    if (parsedEnd != text + length)
+    {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+/**
+ * Convert a whole token to a double, in the manner of std::from_chars.
+ * Plain decimals with up to 19 significant digits and small exponents
+ * (the usual case for exported models) are converted exactly without
+ * touching the C library; anything else falls back to strtod.
+ */
+inline bool parseDouble(const StringSpan &token, double &value)
+{
+    // Powers of ten that are exactly representable as doubles
+    static const double exactPowers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char *p = token.begin;
+    const char *end = token.end;
+    bool negative = false;
+
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+
+    // Integer part
+    for (; p != end && isDigit(*p); ++p)
+    {
+        anyDigits = true;
+        if (mantissa != 0 || *p != '0')
+        {
+            if (significantDigits < 19)
+            {
+                mantissa = mantissa * 10 + (std::uint64_t)(*p - '0');
+            }
+            else
+            {
+                exponent++;
+            }
+            significantDigits++;
+        }
+    }
+
+    // Fractional part
+    if (p != end && *p == '.')
+    {
+        ++p;
+        for (; p != end && isDigit(*p); ++p)
+        {
+            anyDigits = true;
+            if (mantissa != 0 || *p != '0')
+            {
+                if (significantDigits < 19)
+                {
+                    mantissa = mantissa * 10 + (std::uint64_t)(*p - '0');
+                    exponent--;
+                }
+                significantDigits++;
+            }
+            else
+            {
+                exponent--;
+            }
+        }
+    }
+
+    if (!anyDigits)
+    {
+        // Not a plain decimal (e.g. "inf" or "nan")
+        return parseDoubleSlow(token, value);
+    }
+
+    // Exponent part
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool negativeExponent = false;
+        if (p != end && (*p == '-' || *p == '+'))
+        {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+        if (p == end || !isDigit(*p))
+        {
+            return false;
+        }
+        int explicitExponent = 0;
+        for (; p != end && isDigit(*p); ++p)
+        {
+            // Clamp absurd exponents, strtod will produce 0 or inf for them
+            if (explicitExponent < 100000)
+            {
+                explicitExponent = explicitExponent * 10 + (*p - '0');
+            }
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (p != end)
+    {
+        return false;
+    }
+
+    if (mantissa == 0)
+    {
+        value = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    // Fast path (Clinger): both the mantissa and the power of ten are exact
+    // doubles, so a single multiplication or division is correctly rounded
+    if (significantDigits <= 19 && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double result = (double)mantissa;
+        if (exponent < 0)
+        {
+            result /= exactPowers[-exponent];
+        }
+        else
+        {
+            result *= exactPowers[exponent];
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    return parseDoubleSlow(token, value);
+}
+
+#endif /* MODTOKENIZER_H */
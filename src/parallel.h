@@ -0,0 +1,98 @@
+/**
+ * @file parallel.h
+ * @brief Minimal helpers for running work on several threads
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <vector>
+
+/**
+ * Return the number of threads to use for a request of threadCount threads.
+ * Values of 0 or less mean "one per hardware thread".
+ */
+inline int resolveThreadCount(int threadCount)
+{
+    if (threadCount > 0)
+    {
+        return threadCount;
+    }
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 0 ? (int)hardwareThreads : 1;
+}
+
+/**
+ * Call function(task) for every task in [0, taskCount), one thread per task.
+ * Task 0 runs on the calling thread, so a single task never spawns a thread.
+ */
+template <typename Function>
+void parallelFor(int taskCount, Function function)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(taskCount > 1 ? taskCount - 1 : 0);
+
+    for (int task = 1; task < taskCount; task++)
+    {
+        threads.emplace_back(function, task);
+    }
+    if (taskCount > 0)
+    {
+        function(0);
+    }
+    for (int i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+}
+
+/**
+ * Replace values[0] to values[count - 1] by their exclusive prefix sums
+ * (values[i] becomes the sum of the values before it) on threadCount
+ * threads, and return the sum of all values. Each thread sums one block,
+ * the block sums are scanned in order, then each thread scans its block
+ * again from the sum of the blocks before it.
+ */
+template <typename T>
+T parallelExclusiveScan(T *values, int count, int threadCount)
+{
+    threadCount = resolveThreadCount(threadCount);
+    if (threadCount > count)
+    {
+        threadCount = count > 0 ? count : 1;
+    }
+
+    std::vector<T> blockSums(threadCount + 1, 0);
+    parallelFor(threadCount, [&](int thread) {
+        int first = (long long)count * thread / threadCount;
+        int last = (long long)count * (thread + 1) / threadCount;
+        T sum = 0;
+        for (int i = first; i < last; i++)
+        {
+            sum += values[i];
+        }
+        blockSums[thread + 1] = sum;
+    });
+    for (int thread = 0; thread < threadCount; thread++)
+    {
+        blockSums[thread + 1] += blockSums[thread];
+    }
+
+    parallelFor(threadCount, [&](int thread) {
+        int first = (long long)count * thread / threadCount;
+        int last = (long long)count * (thread + 1) / threadCount;
+        T sum = blockSums[thread];
+        for (int i = first; i < last; i++)
+        {
+            T value = values[i];
+            values[i] = sum;
+            sum += value;
+        }
+    });
+    return blockSums[threadCount];
+}
+
+#endif /* PARALLEL_H */
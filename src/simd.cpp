@@ -0,0 +1,55 @@
+/**
+ * @file simd.cpp
+ * @brief Source file for the runtime detection of SIMD instruction sets
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "simd.h"
+
+static SimdLevel detectSimdLevel()
+{
+#if SIMD_DISPATCH
+    // Also checks that the operating system saves the wider registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel getSimdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+SimdLevel resolveSimdLevel(SimdLevel level)
+{
+    return level < getSimdLevel() ? level : getSimdLevel();
+}
+
+const char *getSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::SSE2:
+        return "SSE2";
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
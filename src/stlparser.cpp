@@ -0,0 +1,408 @@
+/**
+ * @file stlparser.cpp
+ * @brief Source file for the StlParser class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "stlparser.h"
+#include "modtokenizer.h"
+#include "parallel.h"
+
+// Binary STL layout: 80 byte header, uint32 triangle count, then 50 bytes
+// per triangle (normal, three corners as little-endian floats, attribute)
+static const std::size_t STL_HEADER_SIZE = 84;
+static const std::size_t STL_TRIANGLE_SIZE = 50;
+
+// Binary files with fewer corners are welded on a single thread
+static const std::size_t STL_PARALLEL_CORNERS = 1 << 15;
+
+// Corners read between two checks for a cancelled load
+static const std::size_t STL_CORNERS_PER_CANCEL_CHECK = 1 << 16;
+
+// Corners read ahead to prefetch their hash table slot
+static const std::size_t STL_PREFETCH_DISTANCE = 16;
+
+/**
+ * Hash of a single precision position
+ */
+static inline std::uint32_t hashPosition(const float *position)
+{
+    std::uint32_t bits[3];
+    std::memcpy(bits, position, sizeof(bits));
+    std::uint64_t h = bits[0] * 0x9E3779B97F4A7C15ULL;
+    h ^= bits[1] + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+    h ^= bits[2] + 0x85EBCA77C2B2AE63ULL + (h << 6) + (h >> 2);
+    h ^= h >> 29;
+    return (std::uint32_t)(h ^ (h >> 32));
+}
+
+/**
+ * Read corner c (three per triangle) of the binary STL triangles at data
+ * into position, with -0 read as +0 so that both weld together
+ */
+static inline void readCorner(const char *data, std::size_t c, float *position)
+{
+    // Skip the 12 byte normal, the file's normals are recomputed by renderers anyway
+    std::memcpy(position, data + (c / 3) * STL_TRIANGLE_SIZE + 12 + (c % 3) * 12, 3 * sizeof(float));
+    position[0] += 0.0f;
+    position[1] += 0.0f;
+    position[2] += 0.0f;
+}
+
+PositionTable::PositionTable(std::size_t expectedCount)
+{
+    // Room for twice as many, so that the load factor starts at one half
+    std::size_t size = 1024;
+    while (size < 2 * expectedCount)
+    {
+        size *= 2;
+    }
+    this->slots.assign(size, -1);
+    this->keys.reserve(3 * expectedCount);
+    this->values.reserve(expectedCount);
+}
+
+void PositionTable::prefetch(const float *position) const
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&this->slots[hashPosition(position) & (this->slots.size() - 1)]);
+#else
+    (void)position;
+#endif
+}
+
+int PositionTable::insert(const float *position, int value)
+{
+    std::size_t mask = this->slots.size() - 1;
+    std::size_t slot = hashPosition(position) & mask;
+
+    // Linear probing
+    while (this->slots[slot] != -1)
+    {
+        const float *key = &this->keys[3 * this->slots[slot]];
+        if (key[0] == position[0] && key[1] == position[1] && key[2] == position[2])
+        {
+            return this->values[this->slots[slot]];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    this->slots[slot] = this->values.size();
+    this->keys.insert(this->keys.end(), position, position + 3);
+    this->values.push_back(value);
+
+    // Keep the load factor at or below one half
+    if (2 * this->values.size() > this->slots.size())
+    {
+        grow();
+    }
+    return value;
+}
+
+void PositionTable::grow()
+{
+    this->slots.assign(this->slots.size() * 2, -1);
+    std::size_t mask = this->slots.size() - 1;
+
+    for (int i = 0; i < this->values.size(); i++)
+    {
+        std::size_t slot = hashPosition(&this->keys[3 * i]) & mask;
+        while (this->slots[slot] != -1)
+        {
+            slot = (slot + 1) & mask;
+        }
+        this->slots[slot] = i;
+    }
+}
+
+StlParser::StlParser(VertexStore &vertices, std::vector<int, ArenaAllocator<int>> &triangles)
+    : vertices(vertices), triangles(triangles), progress(nullptr)
+{
+}
+
+bool StlParser::isBinary(const char *begin, std::size_t size)
+{
+    if (size >= STL_HEADER_SIZE)
+    {
+        std::uint32_t count;
+        std::memcpy(&count, begin + 80, sizeof(count));
+        if (STL_HEADER_SIZE + (std::uint64_t)count * STL_TRIANGLE_SIZE == size)
+        {
+            return true;
+        }
+    }
+
+    // ASCII files start with "solid" (binary headers sometimes do too,
+    // which is why the size check comes first)
+    const char *p = begin;
+    const char *end = begin + size;
+    while (p != end && (isSeparator(*p) || *p == '\n'))
+    {
+        ++p;
+    }
+    return !(end - p >= 5 && std::memcmp(p, "solid", 5) == 0);
+}
+
+void StlParser::parse(const char *begin, const char *end, int threadCount, const LoadProgress *progress)
+{
+    this->vertices.clear();
+    this->triangles.clear();
+    this->table = PositionTable();
+    this->progress = progress;
+
+    if (isBinary(begin, end - begin))
+    {
+        parseBinary(begin, end, threadCount);
+    }
+    else
+    {
+        parseAscii(begin, end);
+    }
+
+    // Only the welded vertices are kept, and none of a cancelled read,
+    // whose triangles may still hold unresolved indices
+    this->table = PositionTable();
+    if (isLoadCancelled(progress))
+    {
+        this->vertices.clear();
+        this->triangles.clear();
+    }
+    this->progress = nullptr;
+}
+
+int StlParser::weld(float x, float y, float z)
+{
+    // -0 and +0 are the same position
+    float position[3] = {x + 0.0f, y + 0.0f, z + 0.0f};
+    int index = this->table.insert(position, this->vertices.size());
+    if (index == this->vertices.size())
+    {
+        this->vertices.push_back(position[0], position[1], position[2]);
+    }
+    return index;
+}
+
+void StlParser::parseBinary(const char *begin, const char *end, int threadCount)
+{
+    if (end - begin < STL_HEADER_SIZE)
+    {
+        return;
+    }
+
+    // Trust the file size over the header count for truncated files
+    std::uint32_t headerCount;
+    std::memcpy(&headerCount, begin + 80, sizeof(headerCount));
+    std::size_t available = (end - begin - STL_HEADER_SIZE) / STL_TRIANGLE_SIZE;
+    std::size_t triangleCount = headerCount < available ? headerCount : available;
+
+    const char *data = begin + STL_HEADER_SIZE;
+    std::size_t cornerCount = 3 * triangleCount;
+    int threads = cornerCount < STL_PARALLEL_CORNERS ? 1 : threadCount;
+    this->triangles.resize(cornerCount);
+    int *corners = this->triangles.data();
+
+    // On one thread, weld the corners in file order as they are read
+    if (threads == 1)
+    {
+        // Shared models typically have about half as many vertices as triangles
+        this->table = PositionTable(triangleCount / 2);
+        this->vertices.reserve(triangleCount / 2);
+        for (std::size_t c = 0; c < cornerCount; c++)
+        {
+            if (c % STL_CORNERS_PER_CANCEL_CHECK == 0 && isLoadCancelled(this->progress))
+            {
+                return;
+            }
+
+            // Lookups miss the cache on large files, so start them early
+            float position[3];
+            if (c + STL_PREFETCH_DISTANCE < cornerCount)
+            {
+                readCorner(data, c + STL_PREFETCH_DISTANCE, position);
+                this->table.prefetch(position);
+            }
+            readCorner(data, c, position);
+            corners[c] = weld(position[0], position[1], position[2]);
+        }
+        return;
+    }
+
+    // Split the corners by hash into one partition per thread, so that equal
+    // positions land in the same partition, keeping file order within each
+    std::vector<std::size_t> partitionBegin(threads + 1, 0);
+    std::vector<int> order(cornerCount);
+    partitionBegin[threads] = cornerCount;
+    std::vector<std::size_t> counts((std::size_t)threads * threads, 0);
+    auto partitionOf = [&](std::size_t c) {
+        float position[3];
+        readCorner(data, c, position);
+        return (int)(((std::uint64_t)hashPosition(position) * threads) >> 32);
+    };
+    parallelFor(threads, [&](int thread) {
+        std::size_t first = cornerCount * thread / threads;
+        std::size_t last = cornerCount * (thread + 1) / threads;
+        for (std::size_t c = first; c < last; c++)
+        {
+            counts[(std::size_t)thread * threads + partitionOf(c)]++;
+        }
+    });
+    if (isLoadCancelled(this->progress))
+    {
+        return;
+    }
+
+    // Each thread's corners of a partition go after those of the threads before it
+    std::size_t offset = 0;
+    for (int partition = 0; partition < threads; partition++)
+    {
+        partitionBegin[partition] = offset;
+        for (int thread = 0; thread < threads; thread++)
+        {
+            std::size_t count = counts[(std::size_t)thread * threads + partition];
+            counts[(std::size_t)thread * threads + partition] = offset;
+            offset += count;
+        }
+    }
+
+    parallelFor(threads, [&](int thread) {
+        std::size_t first = cornerCount * thread / threads;
+        std::size_t last = cornerCount * (thread + 1) / threads;
+        for (std::size_t c = first; c < last; c++)
+        {
+            order[counts[(std::size_t)thread * threads + partitionOf(c)]++] = (int)c;
+        }
+    });
+    if (isLoadCancelled(this->progress))
+    {
+        return;
+    }
+
+    // Weld each partition on its own thread, straight from the file. The
+    // first corner at each position keeps its own index, the others get
+    // -1 - the index of that first corner
+    parallelFor(threads, [&](int partition) {
+        PositionTable table((partitionBegin[partition + 1] - partitionBegin[partition]) / 6);
+        for (std::size_t k = partitionBegin[partition]; k < partitionBegin[partition + 1]; k++)
+        {
+            if ((k - partitionBegin[partition]) % STL_CORNERS_PER_CANCEL_CHECK == 0 &&
+                isLoadCancelled(this->progress))
+            {
+                return;
+            }
+
+            float position[3];
+            if (k + STL_PREFETCH_DISTANCE < partitionBegin[partition + 1])
+            {
+                readCorner(data, order[k + STL_PREFETCH_DISTANCE], position);
+                table.prefetch(position);
+            }
+            int corner = order[k];
+            readCorner(data, corner, position);
+            int first = table.insert(position, corner);
+            corners[corner] = first == corner ? corner : -1 - first;
+        }
+    });
+    std::vector<int>().swap(order);
+    if (isLoadCancelled(this->progress))
+    {
+        return;
+    }
+
+    // Number the first corners in file order, each thread continuing from
+    // the count of the threads before it, and store their positions
+    std::vector<int> firstCounts(threads + 1, 0);
+    parallelFor(threads, [&](int thread) {
+        std::size_t first = cornerCount * thread / threads;
+        std::size_t last = cornerCount * (thread + 1) / threads;
+        for (std::size_t c = first; c < last; c++)
+        {
+            firstCounts[thread + 1] += corners[c] >= 0;
+        }
+    });
+    for (int thread = 0; thread < threads; thread++)
+    {
+        firstCounts[thread + 1] += firstCounts[thread];
+    }
+    this->vertices.resize(firstCounts[threads]);
+    parallelFor(threads, [&](int thread) {
+        std::size_t first = cornerCount * thread / threads;
+        std::size_t last = cornerCount * (thread + 1) / threads;
+        int next = firstCounts[thread];
+        for (std::size_t c = first; c < last; c++)
+        {
+            if (corners[c] >= 0)
+            {
+                float position[3];
+                readCorner(data, c, position);
+                this->vertices.set(next, position[0], position[1], position[2]);
+                corners[c] = next++;
+            }
+        }
+    });
+
+    // The other corners take the vertex of the first corner at their position
+    parallelFor(threads, [&](int thread) {
+        std::size_t first = cornerCount * thread / threads;
+        std::size_t last = cornerCount * (thread + 1) / threads;
+        for (std::size_t c = first; c < last; c++)
+        {
+            if (corners[c] < 0)
+            {
+                corners[c] = corners[-1 - corners[c]];
+            }
+        }
+    });
+}
+
+void StlParser::parseAscii(const char *begin, const char *end)
+{
+    const char *lineBegin = begin;
+    int cornerCount = 0;
+    std::size_t lineCount = 0;
+
+    // Read buffer line by line, only "vertex x y z" lines matter
+    while (lineBegin < end)
+    {
+        if (lineCount++ % STL_CORNERS_PER_CANCEL_CHECK == 0 && isLoadCancelled(this->progress))
+        {
+            return;
+        }
+
+        const char *lineEnd = (const char *)std::memchr(lineBegin, '\n', end - lineBegin);
+        if (lineEnd == nullptr)
+        {
+            lineEnd = end;
+        }
+
+        // Blank and whitespace-only lines have no tokens at all
+        StringSpan strings[4];
+        int tokenCount = splitTokens(lineBegin, lineEnd, strings, 4);
+        double x, y, z;
+        if (tokenCount == 4 && strings[0].size() == 6 &&
+            std::memcmp(strings[0].begin, "vertex", 6) == 0 &&
+            parseDouble(strings[1], x) && parseDouble(strings[2], y) && parseDouble(strings[3], z))
+        {
+            this->triangles.push_back(weld((float)x, (float)y, (float)z));
+            cornerCount++;
+        }
+
+        // Facets with other than three vertices are dropped
+        if (tokenCount >= 1 && strings[0].size() == 8 && std::memcmp(strings[0].begin, "endfacet", 8) == 0)
+        {
+            if (cornerCount != 3)
+            {
+                this->triangles.resize(this->triangles.size() - cornerCount);
+            }
+            cornerCount = 0;
+        }
+
+        lineBegin = lineEnd + 1;
+    }
+
+    // Unterminated last facet
+    this->triangles.resize(this->triangles.size() - this->triangles.size() % 3);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file stlparser.h
+ * @brief Header file for the StlParser class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#ifndef STLPARSER_H
+#define STLPARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "arena.h"
+#include "loadprogress.h"
+#include "vector3d.h"
+#include "vertexstore.h"
+
+/**
+ * Open-addressing hash table from single precision positions to indices,
+ * with linear probing. The slots hold entry numbers, and the keys and
+ * values of the entries are kept in insertion order, which keeps the
+ * slots small and recently added positions close together in memory.
+ */
+class PositionTable
+{
+  private:
+    /**
+    * Entry of each slot (-1 for empty slots), size is a power of two
+    */
+    std::vector<int> slots;
+
+    /**
+    * Position of every entry, three floats each
+    */
+    std::vector<float> keys;
+
+    /**
+    * Value of every entry
+    */
+    std::vector<int> values;
+
+    /**
+    * Double the slots and reinsert every entry
+    */
+    void grow();
+
+  public:
+    /**
+    * Make an empty table with room for expectedCount positions
+    */
+    explicit PositionTable(std::size_t expectedCount = 0);
+
+    /**
+    * Start loading the slot of position into the cache, ahead of insert
+    */
+    void prefetch(const float *position) const;
+
+    /**
+    * Return the value stored for position, or store value for it and
+    * return value if the position is new
+    */
+    int insert(const float *position, int value);
+};
+
+/**
+ * Reads binary and ASCII STL files into an indexed triangle list.
+ * Triangle corners with exactly the same single precision position (the
+ * precision STL files store, -0 and +0 being the same) are welded into a
+ * single vertex using open-addressing hash tables. Vertices are numbered
+ * in the order they first appear in the file.
+ */
+class StlParser
+{
+  private:
+    /**
+    * Welded vertices (output)
+    */
+    VertexStore &vertices;
+
+    /**
+    * Vertex indices, three per triangle (output)
+    */
+    std::vector<int, ArenaAllocator<int>> &triangles;
+
+    /**
+    * Vertex index of every welded position, when welding on one thread
+    */
+    PositionTable table;
+
+    /**
+    * Progress of the load being read, checked for cancellation (may be nullptr)
+    */
+    const LoadProgress *progress;
+
+    /**
+    * Return the index of the vertex at position (x, y, z), adding it if new
+    */
+    int weld(float x, float y, float z);
+
+    /**
+    * Read a binary STL in place. Large files are welded on threadCount
+    * threads: corners are split by hash into one partition per thread, each
+    * welded with its own table, then the vertices are numbered in file order
+    */
+    void parseBinary(const char *begin, const char *end, int threadCount);
+
+    /**
+    * Read an ASCII STL
+    */
+    void parseAscii(const char *begin, const char *end);
+
+  public:
+    StlParser(VertexStore &vertices, std::vector<int, ArenaAllocator<int>> &triangles);
+
+    /**
+    * Read a whole STL file held in memory. Reading stops part way once
+    * progress, if not nullptr, is cancelled, leaving no vertices or
+    * triangles.
+    */
+    void parse(const char *begin, const char *end, int threadCount, const LoadProgress *progress = nullptr);
+
+    /**
+    * Return true if the buffer holds a binary (rather than ASCII) STL file
+    */
+    static bool isBinary(const char *begin, std::size_t size);
+};
+
+#endif /* STLPARSER_H */
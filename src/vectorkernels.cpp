@@ -0,0 +1,662 @@
+/**
+ * @file vectorkernels.cpp
+ * @brief Source file for the batch kernels over coordinate columns
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "vectorkernels.h"
+
+#include <cmath>
+
+// Keep multiplications and additions separate in every kernel (AVX-512
+// implies FMA), so that results do not depend on the instruction set
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+// Scalar loops, also used for the vectors left over by the SIMD loops
+
+template <class Scalar>
+static void dotsScalar(const Scalar *ax, const Scalar *ay, const Scalar *az, const Scalar *bx, const Scalar *by,
+                       const Scalar *bz, int count, double *dots)
+{
+    for (int i = 0; i < count; i++)
+    {
+        dotProduct<double>(ax[i], ay[i], az[i], bx[i], by[i], bz[i], dots[i]);
+    }
+}
+
+template <class Scalar>
+static void crossesScalar(const Scalar *ax, const Scalar *ay, const Scalar *az, const Scalar *bx, const Scalar *by,
+                          const Scalar *bz, int count, double *x, double *y, double *z)
+{
+    for (int i = 0; i < count; i++)
+    {
+        crossProduct<double>(ax[i], ay[i], az[i], bx[i], by[i], bz[i], x[i], y[i], z[i]);
+    }
+}
+
+template <class Scalar>
+static void distancesScalar(const Scalar *x, const Scalar *y, const Scalar *z, int count, const double *point,
+                            double *distances)
+{
+    for (int i = 0; i < count; i++)
+    {
+        double dx = x[i] - point[0];
+        double dy = y[i] - point[1];
+        double dz = z[i] - point[2];
+        double squared;
+        dotProduct(dx, dy, dz, dx, dy, dz, squared);
+        distances[i] = std::sqrt(squared);
+    }
+}
+
+template <class Scalar>
+static void transformScalar(const Scalar *x, const Scalar *y, const Scalar *z, int count, const double *m,
+                            const double *d, Scalar *outX, Scalar *outY, Scalar *outZ)
+{
+    for (int i = 0; i < count; i++)
+    {
+        double vx = x[i];
+        double vy = y[i];
+        double vz = z[i];
+        affineTransform(m, d, vx, vy, vz);
+        outX[i] = vx;
+        outY[i] = vy;
+        outZ[i] = vz;
+    }
+}
+
+// Widen min and max to count values
+template <class Scalar>
+static void columnBoundsScalar(const Scalar *column, int count, double &min, double &max)
+{
+    for (int i = 0; i < count; i++)
+    {
+        double value = column[i];
+        min = value < min ? value : min;
+        max = value > max ? value : max;
+    }
+}
+
+template <class Scalar>
+static void boundsScalar(const Scalar *x, const Scalar *y, const Scalar *z, int count, double *min, double *max)
+{
+    columnBoundsScalar(x, count, min[0], max[0]);
+    columnBoundsScalar(y, count, min[1], max[1]);
+    columnBoundsScalar(z, count, min[2], max[2]);
+}
+
+#if SIMD_DISPATCH
+
+// Minimum and maximum instructions return their second operand when
+// either is NaN, so min(value, bound) keeps the bound like the scalar
+// comparisons do
+
+// SSE2: two vectors per iteration, one per lane
+
+__attribute__((target("sse2"))) static inline __m128d loadSse2(const double *column)
+{
+    return _mm_loadu_pd(column);
+}
+
+__attribute__((target("sse2"))) static inline __m128d loadSse2(const float *column)
+{
+    return _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)column));
+}
+
+__attribute__((target("sse2"))) static inline void storeSse2(double *column, __m128d value)
+{
+    _mm_storeu_pd(column, value);
+}
+
+__attribute__((target("sse2"))) static inline void storeSse2(float *column, __m128d value)
+{
+    _mm_storel_pi((__m64 *)column, _mm_cvtpd_ps(value));
+}
+
+template <class Scalar>
+__attribute__((target("sse2"))) static void dotsSse2(const Scalar *ax, const Scalar *ay, const Scalar *az,
+                                                     const Scalar *bx, const Scalar *by, const Scalar *bz, int count,
+                                                     double *dots)
+{
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d dot;
+        dotProduct(loadSse2(ax + i), loadSse2(ay + i), loadSse2(az + i), loadSse2(bx + i), loadSse2(by + i),
+                   loadSse2(bz + i), dot);
+        storeSse2(dots + i, dot);
+    }
+    dotsScalar(ax + i, ay + i, az + i, bx + i, by + i, bz + i, count - i, dots + i);
+}
+
+template <class Scalar>
+__attribute__((target("sse2"))) static void crossesSse2(const Scalar *ax, const Scalar *ay, const Scalar *az,
+                                                        const Scalar *bx, const Scalar *by, const Scalar *bz,
+                                                        int count, double *x, double *y, double *z)
+{
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d cx, cy, cz;
+        crossProduct(loadSse2(ax + i), loadSse2(ay + i), loadSse2(az + i), loadSse2(bx + i), loadSse2(by + i),
+                     loadSse2(bz + i), cx, cy, cz);
+        storeSse2(x + i, cx);
+        storeSse2(y + i, cy);
+        storeSse2(z + i, cz);
+    }
+    crossesScalar(ax + i, ay + i, az + i, bx + i, by + i, bz + i, count - i, x + i, y + i, z + i);
+}
+
+template <class Scalar>
+__attribute__((target("sse2"))) static void distancesSse2(const Scalar *x, const Scalar *y, const Scalar *z, int count,
+                                                          const double *point, double *distances)
+{
+    __m128d px = _mm_set1_pd(point[0]);
+    __m128d py = _mm_set1_pd(point[1]);
+    __m128d pz = _mm_set1_pd(point[2]);
+
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d dx = loadSse2(x + i) - px;
+        __m128d dy = loadSse2(y + i) - py;
+        __m128d dz = loadSse2(z + i) - pz;
+        __m128d squared;
+        dotProduct(dx, dy, dz, dx, dy, dz, squared);
+        storeSse2(distances + i, _mm_sqrt_pd(squared));
+    }
+    distancesScalar(x + i, y + i, z + i, count - i, point, distances + i);
+}
+
+template <class Scalar>
+__attribute__((target("sse2"))) static void transformSse2(const Scalar *x, const Scalar *y, const Scalar *z, int count,
+                                                          const double *m, const double *d, Scalar *outX,
+                                                          Scalar *outY, Scalar *outZ)
+{
+    __m128d mv[9], dv[3];
+    for (int j = 0; j < 9; j++)
+    {
+        mv[j] = _mm_set1_pd(m[j]);
+    }
+    for (int k = 0; k < 3; k++)
+    {
+        dv[k] = _mm_set1_pd(d[k]);
+    }
+
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d vx = loadSse2(x + i);
+        __m128d vy = loadSse2(y + i);
+        __m128d vz = loadSse2(z + i);
+        affineTransform(mv, dv, vx, vy, vz);
+        storeSse2(outX + i, vx);
+        storeSse2(outY + i, vy);
+        storeSse2(outZ + i, vz);
+    }
+    transformScalar(x + i, y + i, z + i, count - i, m, d, outX + i, outY + i, outZ + i);
+}
+
+template <class Scalar>
+__attribute__((target("sse2"))) static void boundsSse2(const Scalar *x, const Scalar *y, const Scalar *z, int count,
+                                                       double *min, double *max)
+{
+    const Scalar *columns[3] = {x, y, z};
+    int i = count - count % 2;
+    for (int k = 0; k < 3; k++)
+    {
+        __m128d low = _mm_set1_pd(min[k]);
+        __m128d high = _mm_set1_pd(max[k]);
+        for (int j = 0; j < i; j += 2)
+        {
+            __m128d value = loadSse2(columns[k] + j);
+            low = _mm_min_pd(value, low);
+            high = _mm_max_pd(value, high);
+        }
+
+        double lows[2], highs[2];
+        _mm_storeu_pd(lows, low);
+        _mm_storeu_pd(highs, high);
+        columnBoundsScalar(lows, 2, min[k], max[k]);
+        columnBoundsScalar(highs, 2, min[k], max[k]);
+    }
+    boundsScalar(x + i, y + i, z + i, count - i, min, max);
+}
+
+// AVX2: four vectors per iteration, one per lane
+
+__attribute__((target("avx2"))) static inline __m256d loadAvx2(const double *column)
+{
+    return _mm256_loadu_pd(column);
+}
+
+__attribute__((target("avx2"))) static inline __m256d loadAvx2(const float *column)
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(column));
+}
+
+__attribute__((target("avx2"))) static inline void storeAvx2(double *column, __m256d value)
+{
+    _mm256_storeu_pd(column, value);
+}
+
+__attribute__((target("avx2"))) static inline void storeAvx2(float *column, __m256d value)
+{
+    _mm_storeu_ps(column, _mm256_cvtpd_ps(value));
+}
+
+template <class Scalar>
+__attribute__((target("avx2"))) static void dotsAvx2(const Scalar *ax, const Scalar *ay, const Scalar *az,
+                                                     const Scalar *bx, const Scalar *by, const Scalar *bz, int count,
+                                                     double *dots)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d dot;
+        dotProduct(loadAvx2(ax + i), loadAvx2(ay + i), loadAvx2(az + i), loadAvx2(bx + i), loadAvx2(by + i),
+                   loadAvx2(bz + i), dot);
+        storeAvx2(dots + i, dot);
+    }
+    dotsScalar(ax + i, ay + i, az + i, bx + i, by + i, bz + i, count - i, dots + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx2"))) static void crossesAvx2(const Scalar *ax, const Scalar *ay, const Scalar *az,
+                                                        const Scalar *bx, const Scalar *by, const Scalar *bz,
+                                                        int count, double *x, double *y, double *z)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d cx, cy, cz;
+        crossProduct(loadAvx2(ax + i), loadAvx2(ay + i), loadAvx2(az + i), loadAvx2(bx + i), loadAvx2(by + i),
+                     loadAvx2(bz + i), cx, cy, cz);
+        storeAvx2(x + i, cx);
+        storeAvx2(y + i, cy);
+        storeAvx2(z + i, cz);
+    }
+    crossesScalar(ax + i, ay + i, az + i, bx + i, by + i, bz + i, count - i, x + i, y + i, z + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx2"))) static void distancesAvx2(const Scalar *x, const Scalar *y, const Scalar *z, int count,
+                                                          const double *point, double *distances)
+{
+    __m256d px = _mm256_set1_pd(point[0]);
+    __m256d py = _mm256_set1_pd(point[1]);
+    __m256d pz = _mm256_set1_pd(point[2]);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d dx = loadAvx2(x + i) - px;
+        __m256d dy = loadAvx2(y + i) - py;
+        __m256d dz = loadAvx2(z + i) - pz;
+        __m256d squared;
+        dotProduct(dx, dy, dz, dx, dy, dz, squared);
+        storeAvx2(distances + i, _mm256_sqrt_pd(squared));
+    }
+    distancesScalar(x + i, y + i, z + i, count - i, point, distances + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx2"))) static void transformAvx2(const Scalar *x, const Scalar *y, const Scalar *z, int count,
+                                                          const double *m, const double *d, Scalar *outX,
+                                                          Scalar *outY, Scalar *outZ)
+{
+    __m256d mv[9], dv[3];
+    for (int j = 0; j < 9; j++)
+    {
+        mv[j] = _mm256_set1_pd(m[j]);
+    }
+    for (int k = 0; k < 3; k++)
+    {
+        dv[k] = _mm256_set1_pd(d[k]);
+    }
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d vx = loadAvx2(x + i);
+        __m256d vy = loadAvx2(y + i);
+        __m256d vz = loadAvx2(z + i);
+        affineTransform(mv, dv, vx, vy, vz);
+        storeAvx2(outX + i, vx);
+        storeAvx2(outY + i, vy);
+        storeAvx2(outZ + i, vz);
+    }
+    transformScalar(x + i, y + i, z + i, count - i, m, d, outX + i, outY + i, outZ + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx2"))) static void boundsAvx2(const Scalar *x, const Scalar *y, const Scalar *z, int count,
+                                                       double *min, double *max)
+{
+    const Scalar *columns[3] = {x, y, z};
+    int i = count - count % 4;
+    for (int k = 0; k < 3; k++)
+    {
+        __m256d low = _mm256_set1_pd(min[k]);
+        __m256d high = _mm256_set1_pd(max[k]);
+        for (int j = 0; j < i; j += 4)
+        {
+            __m256d value = loadAvx2(columns[k] + j);
+            low = _mm256_min_pd(value, low);
+            high = _mm256_max_pd(value, high);
+        }
+
+        double lows[4], highs[4];
+        _mm256_storeu_pd(lows, low);
+        _mm256_storeu_pd(highs, high);
+        columnBoundsScalar(lows, 4, min[k], max[k]);
+        columnBoundsScalar(highs, 4, min[k], max[k]);
+    }
+    boundsScalar(x + i, y + i, z + i, count - i, min, max);
+}
+
+// AVX-512: eight vectors per iteration, one per lane. Conversions, square
+// roots, minimums and maximums are written as zero-masked instructions
+// with every lane enabled: they are the same instructions, without the
+// undefined source operand that the unmasked intrinsics start from
+
+__attribute__((target("avx512f"))) static inline __m512d loadAvx512(const double *column)
+{
+    return _mm512_loadu_pd(column);
+}
+
+__attribute__((target("avx512f"))) static inline __m512d loadAvx512(const float *column)
+{
+    return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(column));
+}
+
+__attribute__((target("avx512f"))) static inline void storeAvx512(double *column, __m512d value)
+{
+    _mm512_storeu_pd(column, value);
+}
+
+__attribute__((target("avx512f"))) static inline void storeAvx512(float *column, __m512d value)
+{
+    _mm256_storeu_ps(column, _mm512_maskz_cvtpd_ps(0xFF, value));
+}
+
+template <class Scalar>
+__attribute__((target("avx512f"))) static void dotsAvx512(const Scalar *ax, const Scalar *ay, const Scalar *az,
+                                                          const Scalar *bx, const Scalar *by, const Scalar *bz,
+                                                          int count, double *dots)
+{
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d dot;
+        dotProduct(loadAvx512(ax + i), loadAvx512(ay + i), loadAvx512(az + i), loadAvx512(bx + i),
+                   loadAvx512(by + i), loadAvx512(bz + i), dot);
+        storeAvx512(dots + i, dot);
+    }
+    dotsScalar(ax + i, ay + i, az + i, bx + i, by + i, bz + i, count - i, dots + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx512f"))) static void crossesAvx512(const Scalar *ax, const Scalar *ay, const Scalar *az,
+                                                             const Scalar *bx, const Scalar *by, const Scalar *bz,
+                                                             int count, double *x, double *y, double *z)
+{
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d cx, cy, cz;
+        crossProduct(loadAvx512(ax + i), loadAvx512(ay + i), loadAvx512(az + i), loadAvx512(bx + i),
+                     loadAvx512(by + i), loadAvx512(bz + i), cx, cy, cz);
+        storeAvx512(x + i, cx);
+        storeAvx512(y + i, cy);
+        storeAvx512(z + i, cz);
+    }
+    crossesScalar(ax + i, ay + i, az + i, bx + i, by + i, bz + i, count - i, x + i, y + i, z + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx512f"))) static void distancesAvx512(const Scalar *x, const Scalar *y, const Scalar *z,
+                                                               int count, const double *point, double *distances)
+{
+    __m512d px = _mm512_set1_pd(point[0]);
+    __m512d py = _mm512_set1_pd(point[1]);
+    __m512d pz = _mm512_set1_pd(point[2]);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d dx = loadAvx512(x + i) - px;
+        __m512d dy = loadAvx512(y + i) - py;
+        __m512d dz = loadAvx512(z + i) - pz;
+        __m512d squared;
+        dotProduct(dx, dy, dz, dx, dy, dz, squared);
+        storeAvx512(distances + i, _mm512_maskz_sqrt_pd(0xFF, squared));
+    }
+    distancesScalar(x + i, y + i, z + i, count - i, point, distances + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx512f"))) static void transformAvx512(const Scalar *x, const Scalar *y, const Scalar *z,
+                                                               int count, const double *m, const double *d,
+                                                               Scalar *outX, Scalar *outY, Scalar *outZ)
+{
+    __m512d mv[9], dv[3];
+    for (int j = 0; j < 9; j++)
+    {
+        mv[j] = _mm512_set1_pd(m[j]);
+    }
+    for (int k = 0; k < 3; k++)
+    {
+        dv[k] = _mm512_set1_pd(d[k]);
+    }
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d vx = loadAvx512(x + i);
+        __m512d vy = loadAvx512(y + i);
+        __m512d vz = loadAvx512(z + i);
+        affineTransform(mv, dv, vx, vy, vz);
+        storeAvx512(outX + i, vx);
+        storeAvx512(outY + i, vy);
+        storeAvx512(outZ + i, vz);
+    }
+    transformScalar(x + i, y + i, z + i, count - i, m, d, outX + i, outY + i, outZ + i);
+}
+
+template <class Scalar>
+__attribute__((target("avx512f"))) static void boundsAvx512(const Scalar *x, const Scalar *y, const Scalar *z,
+                                                            int count, double *min, double *max)
+{
+    const Scalar *columns[3] = {x, y, z};
+    int i = count - count % 8;
+    for (int k = 0; k < 3; k++)
+    {
+        __m512d low = _mm512_set1_pd(min[k]);
+        __m512d high = _mm512_set1_pd(max[k]);
+        for (int j = 0; j < i; j += 8)
+        {
+            __m512d value = loadAvx512(columns[k] + j);
+            low = _mm512_maskz_min_pd(0xFF, value, low);
+            high = _mm512_maskz_max_pd(0xFF, value, high);
+        }
+
+        double lows[8], highs[8];
+        _mm512_storeu_pd(lows, low);
+        _mm512_storeu_pd(highs, high);
+        columnBoundsScalar(lows, 8, min[k], max[k]);
+        columnBoundsScalar(highs, 8, min[k], max[k]);
+    }
+    boundsScalar(x + i, y + i, z + i, count - i, min, max);
+}
+
+#endif
+
+template <class Scalar>
+void computeDots(const Scalar *ax, const Scalar *ay, const Scalar *az, const Scalar *bx, const Scalar *by,
+                 const Scalar *bz, int count, double *dots, SimdLevel level)
+{
+    switch (resolveSimdLevel(level))
+    {
+#if SIMD_DISPATCH
+    case SimdLevel::AVX512:
+        dotsAvx512(ax, ay, az, bx, by, bz, count, dots);
+        break;
+    case SimdLevel::AVX2:
+        dotsAvx2(ax, ay, az, bx, by, bz, count, dots);
+        break;
+    case SimdLevel::SSE2:
+        dotsSse2(ax, ay, az, bx, by, bz, count, dots);
+        break;
+#endif
+    default:
+        dotsScalar(ax, ay, az, bx, by, bz, count, dots);
+        break;
+    }
+}
+
+template <class Scalar>
+void computeCrosses(const Scalar *ax, const Scalar *ay, const Scalar *az, const Scalar *bx, const Scalar *by,
+                    const Scalar *bz, int count, double *x, double *y, double *z, SimdLevel level)
+{
+    switch (resolveSimdLevel(level))
+    {
+#if SIMD_DISPATCH
+    case SimdLevel::AVX512:
+        crossesAvx512(ax, ay, az, bx, by, bz, count, x, y, z);
+        break;
+    case SimdLevel::AVX2:
+        crossesAvx2(ax, ay, az, bx, by, bz, count, x, y, z);
+        break;
+    case SimdLevel::SSE2:
+        crossesSse2(ax, ay, az, bx, by, bz, count, x, y, z);
+        break;
+#endif
+    default:
+        crossesScalar(ax, ay, az, bx, by, bz, count, x, y, z);
+        break;
+    }
+}
+
+template <class Scalar>
+void computeNorms(const Scalar *x, const Scalar *y, const Scalar *z, int count, double *norms, SimdLevel level)
+{
+    // Subtracting the origin changes no bits of the squares
+    computeDistances(x, y, z, count, Vector3D(), norms, level);
+}
+
+template <class Scalar>
+void computeDistances(const Scalar *x, const Scalar *y, const Scalar *z, int count, Vector3D point,
+                      double *distances, SimdLevel level)
+{
+    const double p[3] = {point.getX(), point.getY(), point.getZ()};
+    switch (resolveSimdLevel(level))
+    {
+#if SIMD_DISPATCH
+    case SimdLevel::AVX512:
+        distancesAvx512(x, y, z, count, p, distances);
+        break;
+    case SimdLevel::AVX2:
+        distancesAvx2(x, y, z, count, p, distances);
+        break;
+    case SimdLevel::SSE2:
+        distancesSse2(x, y, z, count, p, distances);
+        break;
+#endif
+    default:
+        distancesScalar(x, y, z, count, p, distances);
+        break;
+    }
+}
+
+template <class Scalar>
+void transformVectors(const Scalar *x, const Scalar *y, const Scalar *z, int count, const Matrix3x3 &matrix,
+                      Vector3D offset, Scalar *outX, Scalar *outY, Scalar *outZ, SimdLevel level)
+{
+    const double *m = matrix.data();
+    const double d[3] = {offset.getX(), offset.getY(), offset.getZ()};
+    switch (resolveSimdLevel(level))
+    {
+#if SIMD_DISPATCH
+    case SimdLevel::AVX512:
+        transformAvx512(x, y, z, count, m, d, outX, outY, outZ);
+        break;
+    case SimdLevel::AVX2:
+        transformAvx2(x, y, z, count, m, d, outX, outY, outZ);
+        break;
+    case SimdLevel::SSE2:
+        transformSse2(x, y, z, count, m, d, outX, outY, outZ);
+        break;
+#endif
+    default:
+        transformScalar(x, y, z, count, m, d, outX, outY, outZ);
+        break;
+    }
+}
+
+template <class Scalar>
+bool computeBounds(const Scalar *x, const Scalar *y, const Scalar *z, int count, Vector3D &min, Vector3D &max,
+                   SimdLevel level)
+{
+    if (count <= 0)
+    {
+        return false;
+    }
+
+    // Start from the first vector, as the scalar comparisons would
+    double low[3] = {(double)x[0], (double)y[0], (double)z[0]};
+    double high[3] = {low[0], low[1], low[2]};
+    switch (resolveSimdLevel(level))
+    {
+#if SIMD_DISPATCH
+    case SimdLevel::AVX512:
+        boundsAvx512(x, y, z, count, low, high);
+        break;
+    case SimdLevel::AVX2:
+        boundsAvx2(x, y, z, count, low, high);
+        break;
+    case SimdLevel::SSE2:
+        boundsSse2(x, y, z, count, low, high);
+        break;
+#endif
+    default:
+        boundsScalar(x, y, z, count, low, high);
+        break;
+    }
+
+    min = Vector3D(low[0], low[1], low[2]);
+    max = Vector3D(high[0], high[1], high[2]);
+    return true;
+}
+
+template void computeDots<float>(const float *, const float *, const float *, const float *, const float *,
+                                 const float *, int, double *, SimdLevel);
+template void computeDots<double>(const double *, const double *, const double *, const double *, const double *,
+                                  const double *, int, double *, SimdLevel);
+template void computeCrosses<float>(const float *, const float *, const float *, const float *, const float *,
+                                    const float *, int, double *, double *, double *, SimdLevel);
+template void computeCrosses<double>(const double *, const double *, const double *, const double *, const double *,
+                                     const double *, int, double *, double *, double *, SimdLevel);
+template void computeNorms<float>(const float *, const float *, const float *, int, double *, SimdLevel);
+template void computeNorms<double>(const double *, const double *, const double *, int, double *, SimdLevel);
+template void computeDistances<float>(const float *, const float *, const float *, int, Vector3D, double *,
+                                      SimdLevel);
+template void computeDistances<double>(const double *, const double *, const double *, int, Vector3D, double *,
+                                       SimdLevel);
+template void transformVectors<float>(const float *, const float *, const float *, int, const Matrix3x3 &, Vector3D,
+                                      float *, float *, float *, SimdLevel);
+template void transformVectors<double>(const double *, const double *, const double *, int, const Matrix3x3 &,
+                                       Vector3D, double *, double *, double *, SimdLevel);
+template bool computeBounds<float>(const float *, const float *, const float *, int, Vector3D &, Vector3D &,
+                                   SimdLevel);
+template bool computeBounds<double>(const double *, const double *, const double *, int, Vector3D &, Vector3D &,
+                                    SimdLevel);
@@ -0,0 +1,167 @@
+/**
+ * @file vertexarray.cpp
+ * @brief Source file for the BasicVertexArray class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "vertexarray.h"
+
+#include "matrix.h"
+#include "vectorkernels.h"
+
+template <class Scalar>
+const std::size_t BasicVertexArray<Scalar>::ALIGNMENT;
+
+// Number of independent partial results kept by reductions, so that the
+// compiler can keep them in vector lanes without reassociating additions
+static const int LANES = 4;
+
+template <class Scalar>
+BasicVertexArray<Scalar>::BasicVertexArray(const std::vector<Vector3D> &vertices)
+{
+    reserve(vertices.size());
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        push_back(vertices[i]);
+    }
+}
+
+template <class Scalar>
+void BasicVertexArray<Scalar>::resize(int count)
+{
+    this->x.resize(count, 0);
+    this->y.resize(count, 0);
+    this->z.resize(count, 0);
+}
+
+template <class Scalar>
+void BasicVertexArray<Scalar>::reserve(int count)
+{
+    this->x.reserve(count);
+    this->y.reserve(count);
+    this->z.reserve(count);
+}
+
+template <class Scalar>
+void BasicVertexArray<Scalar>::clear()
+{
+    this->x.clear();
+    this->y.clear();
+    this->z.clear();
+}
+
+template <class Scalar>
+void BasicVertexArray<Scalar>::assign(const double *x, const double *y, const double *z, int count)
+{
+    this->x.assign(x, x + count);
+    this->y.assign(y, y + count);
+    this->z.assign(z, z + count);
+}
+
+template <class Scalar>
+std::size_t BasicVertexArray<Scalar>::getMemorySize() const
+{
+    return 3 * this->x.capacity() * sizeof(Scalar);
+}
+
+template <class Scalar>
+std::vector<Vector3D> BasicVertexArray<Scalar>::toVector() const
+{
+    std::vector<Vector3D> vertices(size());
+    for (int i = 0; i < size(); i++)
+    {
+        vertices[i] = get(i);
+    }
+    return vertices;
+}
+
+// Sum of a column in double precision, one pass
+template <class Scalar>
+static double columnSum(const Scalar *__restrict column, int count)
+{
+    double sums[LANES] = {0};
+
+    int i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        for (int lane = 0; lane < LANES; lane++)
+        {
+            sums[lane] += column[i + lane];
+        }
+    }
+    for (; i < count; i++)
+    {
+        sums[0] += column[i];
+    }
+
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+template <class Scalar>
+bool BasicVertexArray<Scalar>::getBounds(Vector3D &min, Vector3D &max) const
+{
+    return computeBounds(this->x.data(), this->y.data(), this->z.data(), size(), min, max);
+}
+
+template <class Scalar>
+Vector3D BasicVertexArray<Scalar>::getCentroid() const
+{
+    if (empty())
+    {
+        return Vector3D();
+    }
+
+    double count = size();
+    return Vector3D(columnSum(this->x.data(), size()) / count,
+                    columnSum(this->y.data(), size()) / count,
+                    columnSum(this->z.data(), size()) / count);
+}
+
+template <class Scalar>
+void BasicVertexArray<Scalar>::translate(Vector3D offset)
+{
+    Scalar *__restrict x = this->x.data();
+    Scalar *__restrict y = this->y.data();
+    Scalar *__restrict z = this->z.data();
+    double dx = offset.getX();
+    double dy = offset.getY();
+    double dz = offset.getZ();
+    int count = size();
+
+    // In double, rounded once to Scalar, as transform does
+    for (int i = 0; i < count; i++)
+    {
+        x[i] = (Scalar)(x[i] + dx);
+        y[i] = (Scalar)(y[i] + dy);
+        z[i] = (Scalar)(z[i] + dz);
+    }
+}
+
+template <class Scalar>
+void BasicVertexArray<Scalar>::scale(double factor)
+{
+    Scalar *__restrict x = this->x.data();
+    Scalar *__restrict y = this->y.data();
+    Scalar *__restrict z = this->z.data();
+    int count = size();
+
+    // In double, rounded once to Scalar, as transform does
+    for (int i = 0; i < count; i++)
+    {
+        x[i] = (Scalar)(x[i] * factor);
+        y[i] = (Scalar)(y[i] * factor);
+        z[i] = (Scalar)(z[i] * factor);
+    }
+}
+
+template <class Scalar>
+void BasicVertexArray<Scalar>::transform(const double matrix[9], Vector3D offset)
+{
+    Matrix3x3 m(matrix[0], matrix[1], matrix[2], matrix[3], matrix[4], matrix[5], matrix[6], matrix[7], matrix[8]);
+    transformVectors(this->x.data(), this->y.data(), this->z.data(), size(), m, offset, this->x.data(),
+                     this->y.data(), this->z.data());
+}
+
+template class BasicVertexArray<float>;
+template class BasicVertexArray<double>;
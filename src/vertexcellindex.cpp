@@ -0,0 +1,98 @@
+/**
+ * @file vertexcellindex.cpp
+ * @brief Source file for the VertexCellIndex class and its parallel construction
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "vertexcellindex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "cellstore.h"
+#include "parallel.h"
+
+VertexCellIndex::VertexCellIndex(std::vector<int> offsets, std::vector<int> cells)
+    : offsets(std::move(offsets)), cells(std::move(cells))
+{
+}
+
+// Call function(vertexId) once for every distinct vertex of cell id
+template <class Function>
+static void forEachCellVertex(const CellStore &cells, int id, Function function)
+{
+    const int *vertexIds = cells.getVertexIds(id);
+    int vertexCount = cells.getVertexCount(id);
+    for (int j = 0; j < vertexCount; j++)
+    {
+        bool isRepeated = false;
+        for (int k = 0; k < j; k++)
+        {
+            isRepeated = isRepeated || vertexIds[k] == vertexIds[j];
+        }
+        if (!isRepeated)
+        {
+            function(vertexIds[j]);
+        }
+    }
+}
+
+VertexCellIndex buildVertexCellIndex(const CellStore &cells, int vertexCount, int threadCount)
+{
+    int cellCount = cells.getCellCount();
+    threadCount = resolveThreadCount(threadCount);
+
+    // Cells and vertices are split in the same number of contiguous ranges
+    auto rangeStart = [&](int count, int thread) { return (int)((long long)count * thread / threadCount); };
+
+    // Count the cells of each vertex; counts are then reused as the next
+    // free entry of each row
+    std::unique_ptr<std::atomic<int>[]> counts(new std::atomic<int>[vertexCount]);
+    parallelFor(threadCount, [&](int thread) {
+        for (int v = rangeStart(vertexCount, thread); v < rangeStart(vertexCount, thread + 1); v++)
+        {
+            counts[v].store(0, std::memory_order_relaxed);
+        }
+    });
+    parallelFor(threadCount, [&](int thread) {
+        for (int id = rangeStart(cellCount, thread); id < rangeStart(cellCount, thread + 1); id++)
+        {
+            forEachCellVertex(cells, id, [&](int v) { counts[v].fetch_add(1, std::memory_order_relaxed); });
+        }
+    });
+
+    std::vector<int> offsets(vertexCount + 1);
+    parallelFor(threadCount, [&](int thread) {
+        for (int v = rangeStart(vertexCount, thread); v < rangeStart(vertexCount, thread + 1); v++)
+        {
+            offsets[v] = counts[v].load(std::memory_order_relaxed);
+        }
+    });
+    offsets[vertexCount] = parallelExclusiveScan(offsets.data(), vertexCount, threadCount);
+    parallelFor(threadCount, [&](int thread) {
+        for (int v = rangeStart(vertexCount, thread); v < rangeStart(vertexCount, thread + 1); v++)
+        {
+            counts[v].store(offsets[v], std::memory_order_relaxed);
+        }
+    });
+
+    // Fill the rows in any order, then sort them
+    std::vector<int> entries(offsets[vertexCount]);
+    parallelFor(threadCount, [&](int thread) {
+        for (int id = rangeStart(cellCount, thread); id < rangeStart(cellCount, thread + 1); id++)
+        {
+            forEachCellVertex(cells, id, [&](int v) { entries[counts[v].fetch_add(1, std::memory_order_relaxed)] = id; });
+        }
+    });
+    parallelFor(threadCount, [&](int thread) {
+        for (int v = rangeStart(vertexCount, thread); v < rangeStart(vertexCount, thread + 1); v++)
+        {
+            std::sort(entries.begin() + offsets[v], entries.begin() + offsets[v + 1]);
+        }
+    });
+
+    return VertexCellIndex(std::move(offsets), std::move(entries));
+}
@@ -0,0 +1,81 @@
+/**
+ * @file vertexstore.cpp
+ * @brief Source file for the VertexStore class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "vertexstore.h"
+
+void VertexStore::resize(int count)
+{
+    visit([&](auto &vertices) { vertices.resize(count); });
+}
+
+void VertexStore::reserve(int count)
+{
+    visit([&](auto &vertices) { vertices.reserve(count); });
+}
+
+void VertexStore::clear()
+{
+    visit([&](auto &vertices) { vertices.clear(); });
+}
+
+void VertexStore::assign(const double *x, const double *y, const double *z, int count)
+{
+    visit([&](auto &vertices) { vertices.assign(x, y, z, count); });
+}
+
+const BasicVertexArray<double> *VertexStore::getDoubleArray() const
+{
+    return this->precision == Precision::Double ? &this->doubleVertices : nullptr;
+}
+
+const BasicVertexArray<float> *VertexStore::getSingleArray() const
+{
+    return this->precision == Precision::Single ? &this->singleVertices : nullptr;
+}
+
+std::size_t VertexStore::getMemorySize() const
+{
+    std::size_t memorySize = 0;
+    visit([&](const auto &vertices) { memorySize = vertices.getMemorySize(); });
+    return memorySize;
+}
+
+std::vector<Vector3D> VertexStore::toVector() const
+{
+    std::vector<Vector3D> result;
+    visit([&](const auto &vertices) { result = vertices.toVector(); });
+    return result;
+}
+
+bool VertexStore::getBounds(Vector3D &min, Vector3D &max) const
+{
+    bool found = false;
+    visit([&](const auto &vertices) { found = vertices.getBounds(min, max); });
+    return found;
+}
+
+Vector3D VertexStore::getCentroid() const
+{
+    Vector3D centroid;
+    visit([&](const auto &vertices) { centroid = vertices.getCentroid(); });
+    return centroid;
+}
+
+void VertexStore::translate(Vector3D offset)
+{
+    visit([&](auto &vertices) { vertices.translate(offset); });
+}
+
+void VertexStore::scale(double factor)
+{
+    visit([&](auto &vertices) { vertices.scale(factor); });
+}
+
+void VertexStore::transform(const double matrix[9], Vector3D offset)
+{
+    visit([&](auto &vertices) { vertices.transform(matrix, offset); });
+}
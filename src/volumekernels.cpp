@@ -0,0 +1,164 @@
+/**
+ * @file volumekernels.cpp
+ * @brief Source file for the hexahedron volume batch kernels
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include "volumekernels.h"
+
+// Keep multiplications and additions separate in every kernel (AVX-512
+// implies FMA), so that results do not depend on the instruction set
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+// Scalar loop, also used for the cells left over by the SIMD loops
+template <class Scalar>
+static void hexahedronVolumesScalar(const int *vertexIds, int count, const Scalar *x, const Scalar *y, const Scalar *z,
+                                    double *volumes)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const int *ids = vertexIds + 8 * i;
+        double px[8], py[8], pz[8];
+        for (int j = 0; j < 8; j++)
+        {
+            px[j] = x[ids[j]];
+            py[j] = y[ids[j]];
+            pz[j] = z[ids[j]];
+        }
+        hexahedronVolume(px, py, pz, volumes[i]);
+    }
+}
+
+#if SIMD_DISPATCH
+
+// Gathers are written as masked gathers into zeroed registers: they are
+// the same instructions, without the undefined source operand that the
+// unmasked intrinsics start from
+
+// AVX2: four hexahedra per iteration, one per lane
+
+__attribute__((target("avx2"))) static inline __m256d gatherAvx2(const double *column, __m128i index)
+{
+    __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), column, index, all, 8);
+}
+
+__attribute__((target("avx2"))) static inline __m256d gatherAvx2(const float *column, __m128i index)
+{
+    __m128 all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    return _mm256_cvtps_pd(_mm_mask_i32gather_ps(_mm_setzero_ps(), column, index, all, 4));
+}
+
+template <class Scalar>
+__attribute__((target("avx2"))) static void hexahedronVolumesAvx2(const int *vertexIds, int count, const Scalar *x,
+                                                                  const Scalar *y, const Scalar *z, double *volumes)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Transpose the vertex IDs of the four cells, so that index[j]
+        // holds vertex j of every cell
+        const __m256i *rows = (const __m256i *)(vertexIds + 8 * i);
+        __m256i r0 = _mm256_loadu_si256(rows);
+        __m256i r1 = _mm256_loadu_si256(rows + 1);
+        __m256i r2 = _mm256_loadu_si256(rows + 2);
+        __m256i r3 = _mm256_loadu_si256(rows + 3);
+        __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+        __m256i t1 = _mm256_unpackhi_epi32(r0, r1);
+        __m256i t2 = _mm256_unpacklo_epi32(r2, r3);
+        __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+        __m256i u[4] = {_mm256_unpacklo_epi64(t0, t2), _mm256_unpackhi_epi64(t0, t2),
+                        _mm256_unpacklo_epi64(t1, t3), _mm256_unpackhi_epi64(t1, t3)};
+
+        __m256d px[8], py[8], pz[8];
+        for (int j = 0; j < 8; j++)
+        {
+            __m128i index = j < 4 ? _mm256_castsi256_si128(u[j]) : _mm256_extracti128_si256(u[j - 4], 1);
+            px[j] = gatherAvx2(x, index);
+            py[j] = gatherAvx2(y, index);
+            pz[j] = gatherAvx2(z, index);
+        }
+
+        __m256d volume;
+        hexahedronVolume(px, py, pz, volume);
+        _mm256_storeu_pd(volumes + i, volume);
+    }
+    hexahedronVolumesScalar(vertexIds + 8 * i, count - i, x, y, z, volumes + i);
+}
+
+// AVX-512: eight hexahedra per iteration, one per lane
+
+__attribute__((target("avx512f"))) static inline __m512d gatherAvx512(const double *column, __m256i index)
+{
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, index, column, 8);
+}
+
+__attribute__((target("avx512f"))) static inline __m512d gatherAvx512(const float *column, __m256i index)
+{
+    __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    return _mm512_maskz_cvtps_pd(0xFF, _mm256_mask_i32gather_ps(_mm256_setzero_ps(), column, index, all, 4));
+}
+
+template <class Scalar>
+__attribute__((target("avx512f"))) static void hexahedronVolumesAvx512(const int *vertexIds, int count, const Scalar *x,
+                                                                       const Scalar *y, const Scalar *z, double *volumes)
+{
+    // Offsets of vertex 0 of each of the eight cells
+    const __m256i stride = _mm256_setr_epi32(0, 8, 16, 24, 32, 40, 48, 56);
+    const __m256i all = _mm256_set1_epi32(-1);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const int *ids = vertexIds + 8 * i;
+        __m512d px[8], py[8], pz[8];
+        for (int j = 0; j < 8; j++)
+        {
+            __m256i index = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), ids + j, stride, all, 4);
+            px[j] = gatherAvx512(x, index);
+            py[j] = gatherAvx512(y, index);
+            pz[j] = gatherAvx512(z, index);
+        }
+
+        __m512d volume;
+        hexahedronVolume(px, py, pz, volume);
+        _mm512_storeu_pd(volumes + i, volume);
+    }
+    hexahedronVolumesScalar(vertexIds + 8 * i, count - i, x, y, z, volumes + i);
+}
+
+#endif
+
+template <class Scalar>
+void computeHexahedronVolumes(const int *vertexIds, int count, const Scalar *x, const Scalar *y, const Scalar *z,
+                              double *volumes, SimdLevel level)
+{
+    switch (resolveSimdLevel(level))
+    {
+#if SIMD_DISPATCH
+    case SimdLevel::AVX512:
+        hexahedronVolumesAvx512(vertexIds, count, x, y, z, volumes);
+        break;
+    case SimdLevel::AVX2:
+        hexahedronVolumesAvx2(vertexIds, count, x, y, z, volumes);
+        break;
+#endif
+    default:
+        hexahedronVolumesScalar(vertexIds, count, x, y, z, volumes);
+        break;
+    }
+}
+
+template void computeHexahedronVolumes<float>(const int *, int, const float *, const float *, const float *, double *,
+                                              SimdLevel);
+template void computeHexahedronVolumes<double>(const int *, int, const double *, const double *, const double *,
+                                               double *, SimdLevel);
@@ -0,0 +1,71 @@
+/**
+ * @file test_arena.cpp
+ * @brief Unit tests for the Arena class and arena-backed models
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <vector>
+#include "arena.h"
+#include "model.h"
+
+TEST(allocateTest, arenaBase) {
+    Arena arena(4096);
+
+    char *a = (char *)arena.allocate(10, 1);
+    double *b = (double *)arena.allocate(3 * sizeof(double), 64);
+    ASSERT_EQ((std::size_t)b % 64, 0);
+    ASSERT_GE((char *)b, a + 10);
+    ASSERT_EQ(arena.getBlockCount(), 1);
+    ASSERT_EQ(arena.getBytesAllocated(), 10 + 3 * sizeof(double));
+
+    // Large requests get their own block
+    arena.allocate(8192, 8);
+    ASSERT_EQ(arena.getBlockCount(), 2);
+
+    arena.release();
+    ASSERT_EQ(arena.getBlockCount(), 0);
+    ASSERT_EQ(arena.getBytesReserved(), 0);
+}
+
+TEST(allocatorTest, arenaBase) {
+    Arena arena;
+    std::vector<int, ArenaAllocator<int>> values((ArenaAllocator<int>(&arena)));
+    for (int i = 0; i < 1000; i++)
+    {
+        values.push_back(i);
+    }
+
+    ASSERT_EQ(values[999], 999);
+    ASSERT_GE(arena.getBytesAllocated(), 1000 * sizeof(int));
+
+    // Without an arena the allocator uses the heap
+    std::vector<double, ArenaAllocator<double, 64>> heapValues(5, 1.0);
+    ASSERT_EQ((std::size_t)heapValues.data() % 64, 0);
+    ASSERT_EQ(heapValues.get_allocator().getArena(), nullptr);
+}
+
+TEST(arenaModelTest, arenaBase) {
+    Arena arena;
+    Model heapModel("tests/ExampleModel.mod", 2);
+    Model arenaModel("tests/ExampleModel.mod", 2, &arena);
+
+    // All storage of the model comes from the arena
+    ASSERT_GT(arena.getBytesAllocated(), 0);
+
+    ASSERT_EQ(arenaModel.getMaterials(), heapModel.getMaterials());
+    ASSERT_EQ(arenaModel.getVertices(), heapModel.getVertices());
+    ASSERT_EQ(arenaModel.getCellCount(), heapModel.getCellCount());
+    ASSERT_EQ(arenaModel.getCellVolumes(), heapModel.getCellVolumes());
+    ASSERT_EQ(arenaModel.getCellMasses(), heapModel.getCellMasses());
+
+    std::vector<Cell> heapCells = heapModel.getCells();
+    std::vector<Cell> arenaCells = arenaModel.getCells();
+    for (int i = 0; i < heapCells.size(); i++)
+    {
+        ASSERT_EQ(arenaCells[i].getVertexIds(), heapCells[i].getVertexIds());
+        ASSERT_EQ(arenaCells[i].getMaterialId(), heapCells[i].getMaterialId());
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * @file test_boundarysurface.cpp
+ * @brief Unit tests for the BoundarySurface class and its parallel extraction
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "boundarysurface.h"
+#include "cellstore.h"
+#include "faceadjacency.h"
+#include "model.h"
+#include "vertexstore.h"
+
+// Helper that adds an n x n x n grid of unit hexahedra and its vertices,
+// cell (i, j, k) taking ID (k * n + j) * n + i and material k % 2
+static void addHexGrid(CellStore &cells, VertexStore &vertices, int n)
+{
+    int side = n + 1;
+    for (int k = 0; k < side; k++)
+    {
+        for (int j = 0; j < side; j++)
+        {
+            for (int i = 0; i < side; i++)
+            {
+                vertices.push_back(i, j, k);
+            }
+        }
+    }
+    for (int k = 0; k < n; k++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                int v0 = (k * side + j) * side + i;
+                int v3 = v0 + side;
+                int v4 = v0 + side * side;
+                int v7 = v3 + side * side;
+                int vertexIds[8] = {v0, v0 + 1, v3 + 1, v3, v4, v4 + 1, v7 + 1, v7};
+                cells.add((k * n + j) * n + i, 'h', k % 2, vertexIds);
+            }
+        }
+    }
+}
+
+static BoundarySurface extract(const CellStore &cells, const VertexStore &vertices, int threadCount)
+{
+    return extractBoundarySurface(cells, vertices, buildFaceAdjacency(cells, threadCount), threadCount);
+}
+
+TEST(gridTest, boundarySurface) {
+    CellStore cells;
+    VertexStore vertices;
+    addHexGrid(cells, vertices, 3);
+    BoundarySurface surface = extract(cells, vertices, 2);
+
+    ASSERT_EQ(surface.getFaceCount(), 6 * 9);
+    ASSERT_EQ(surface.getQuadCount(), 6 * 9);
+    ASSERT_EQ(surface.getTriangleCount(), 0);
+    ASSERT_EQ(surface.getVertexIds().size(), 4 * 6 * 9);
+    ASSERT_DOUBLE_EQ(surface.getArea(), 6 * 9);
+
+    // Every face is on the outside of the grid and faces outwards
+    Vector3D centre(1.5, 1.5, 1.5);
+    for (int i = 0; i < surface.getFaceCount(); i++)
+    {
+        ArrayView<int> vertexIds = surface.getVertexIds(i);
+        ASSERT_EQ(vertexIds.size(), 4);
+        Vector3D a = vertices.get(vertexIds[0]);
+        Vector3D normal = (vertices.get(vertexIds[1]) - a).cross(vertices.get(vertexIds[2]) - a);
+        ASSERT_GT(normal.dot(a - centre), 0) << i;
+        ASSERT_NE(surface.getCellId(i), 13);
+        ASSERT_EQ(surface.getMaterialId(i), cells.getMaterialId(surface.getCellId(i)));
+    }
+
+    // Faces follow their cells
+    for (int i = 1; i < surface.getFaceCount(); i++)
+    {
+        ASSERT_LE(surface.getCellId(i - 1), surface.getCellId(i));
+    }
+}
+
+TEST(mixedTest, boundarySurface) {
+    // Unit cube with a pyramid on its top face and an unused ID between
+    VertexStore vertices;
+    double positions[9][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1},
+                              {1, 0, 1}, {1, 1, 1}, {0, 1, 1}, {0.5, 0.5, 2}};
+    for (const double *position : positions)
+    {
+        vertices.push_back(position[0], position[1], position[2]);
+    }
+    CellStore cells;
+    int hexahedron[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    int pyramid[5] = {4, 5, 6, 7, 8};
+    cells.add(0, 'h', 1, hexahedron);
+    cells.add(2, 'p', 0, pyramid);
+
+    BoundarySurface surface = extract(cells, vertices, 1);
+    ASSERT_EQ(surface.getQuadCount(), 5);
+    ASSERT_EQ(surface.getTriangleCount(), 4);
+    ASSERT_EQ(surface.getOffsets().back(), 5 * 4 + 4 * 3);
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(surface.getCellId(i), 0);
+        ASSERT_EQ(surface.getMaterialId(i), 1);
+    }
+    for (int i = 5; i < 9; i++)
+    {
+        ASSERT_EQ(surface.getCellId(i), 2);
+        ASSERT_EQ(surface.getMaterialId(i), 0);
+        ASSERT_EQ(surface.getVertexCount(i), 3);
+        ASSERT_EQ(surface.getVertexIds(i)[2], 8);
+    }
+
+    // Five unit squares and four triangles of base 1 and slant height
+    // sqrt(1.25)
+    ASSERT_NEAR(surface.getArea(), 5 + 2 * std::sqrt(1.25), 1e-12);
+}
+
+TEST(threadTest, boundarySurface) {
+    CellStore cells;
+    VertexStore vertices;
+    addHexGrid(cells, vertices, 24);
+    BoundarySurface reference = extract(cells, vertices, 1);
+    ASSERT_EQ(reference.getFaceCount(), 6 * 24 * 24);
+    ASSERT_NEAR(reference.getArea(), 6 * 24 * 24, 1e-9);
+
+    for (int threadCount : {2, 3, 8, 0})
+    {
+        BoundarySurface surface = extract(cells, vertices, threadCount);
+        ASSERT_EQ(surface.getOffsets(), reference.getOffsets()) << threadCount;
+        ASSERT_EQ(surface.getVertexIds(), reference.getVertexIds()) << threadCount;
+        ASSERT_EQ(surface.getCellIds(), reference.getCellIds()) << threadCount;
+        ASSERT_EQ(surface.getMaterialIds(), reference.getMaterialIds()) << threadCount;
+        ASSERT_EQ(surface.getArea(), reference.getArea()) << threadCount;
+    }
+}
+
+TEST(modelTest, boundarySurface) {
+    Model model("tests/ExampleModel.mod");
+    BoundarySurface surface = model.getBoundarySurface();
+    FaceAdjacency adjacency = model.getFaceAdjacency();
+    ASSERT_EQ(surface.getFaceCount(), adjacency.getBoundaryFaceCount());
+    ASSERT_GT(surface.getArea(), 0);
+    for (int i = 0; i < surface.getFaceCount(); i++)
+    {
+        ASSERT_LT(surface.getMaterialId(i), model.getMaterialCount());
+        for (int vertexId : surface.getVertexIds(i))
+        {
+            ASSERT_LT(vertexId, model.getVertexCount());
+        }
+    }
+}
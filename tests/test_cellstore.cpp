@@ -0,0 +1,166 @@
+/**
+ * @file test_cellstore.cpp
+ * @brief Unit tests for the CellStore class and the per-type cell kernels
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "cellstore.h"
+#include "model.h"
+
+// Helper that writes a model with one cell of each type and a gap in the cell IDs
+static void writeMixedModel(const char *filename)
+{
+    std::ofstream out(filename);
+    out << "m 0 8940 b87333 cu\n"
+        << "m 1 2700 d0d5db al\n"
+        << "v 0 0 0 0\nv 1 2 0 0\nv 2 2 2 0\nv 3 0 2 0\n"
+        << "v 4 0 0 2\nv 5 2 0 2\nv 6 2 2 2\nv 7 0 2 2\nv 8 1 1 4\n"
+        << "c 0 t 1 0 1 3 4\n"
+        << "c 1 p 0 4 5 6 7 8\n"
+        << "c 3 h 1 0 1 2 3 4 5 6 7\n";
+}
+
+TEST(cellStoreTest, cellStoreBase) {
+    CellStore store;
+    int tetrahedron[] = {0, 1, 2, 3};
+    int hexahedron[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    store.add(4, 'h', 1, hexahedron);
+    store.add(1, 't', 0, tetrahedron);
+
+    ASSERT_EQ(store.getCellCount(), 5);
+    ASSERT_EQ(store.getType(0), 0);
+    ASSERT_EQ(store.getType(1), 't');
+    ASSERT_EQ(store.getType(4), 'h');
+    ASSERT_EQ(store.getMaterialId(4), 1);
+    ASSERT_EQ(store.getVertexCount(1), 4);
+    ASSERT_EQ(store.getVertexIds(4)[7], 7);
+    ASSERT_EQ(store.getTetrahedra().size(), 1);
+    ASSERT_EQ(store.getHexahedra().getId(0), 4);
+    ASSERT_EQ(store.getConnectivitySize(), 12);
+
+    // Whole arrays, as handed to VTK without copying
+    ASSERT_EQ(store.getHexahedra().getVertexIds(), store.getHexahedra().getVertexIds(0));
+    ASSERT_EQ(store.getHexahedra().getVertexIds()[5], 5);
+    ASSERT_EQ(store.getHexahedra().getMaterialIds()[0], 1);
+    ASSERT_EQ(store.getTetrahedra().getMaterialIds()[0], 0);
+}
+
+TEST(assignTest, cellStoreBase) {
+
+    // Columns as in a binary file, with unused and unknown types
+    std::vector<char> types;
+    std::vector<std::int32_t> materialIds;
+    std::vector<std::uint64_t> offsets(1, 0);
+    std::vector<std::int32_t> connectivity;
+    const char pattern[] = {'h', 't', 0, 'p', 'h', 'x', 't'};
+    for (int id = 0; id < 70; id++)
+    {
+        char type = pattern[id % 7];
+        int vertexCount = type == 'h' ? 8 : type == 'p' ? 5 : type == 't' ? 4 : 0;
+        types.push_back(type);
+        materialIds.push_back(id % 3);
+        for (int j = 0; j < vertexCount; j++)
+        {
+            connectivity.push_back(id * 10 + j);
+        }
+        offsets.push_back(connectivity.size());
+    }
+
+    // The same cells whatever the number of threads, as if added one by one
+    CellStore expected;
+    for (int id = 0; id < 70; id++)
+    {
+        std::vector<int> vertexIds(connectivity.begin() + offsets[id], connectivity.begin() + offsets[id + 1]);
+        expected.add(id, types[id], materialIds[id], vertexIds.data());
+    }
+    for (int threadCount = 1; threadCount <= 8; threadCount++)
+    {
+        CellStore store;
+        store.add(0, 't', 0, connectivity.data());
+        store.assign(types.data(), materialIds.data(), offsets.data(), connectivity.data(), 70, threadCount);
+
+        ASSERT_EQ(store.getCellCount(), 70);
+        ASSERT_EQ(store.getTetrahedra().size(), 20);
+        ASSERT_EQ(store.getPyramids().size(), 10);
+        ASSERT_EQ(store.getHexahedra().size(), 20);
+        ASSERT_EQ(store.getConnectivitySize(), expected.getConnectivitySize());
+        for (int id = 0; id < 70; id++)
+        {
+            ASSERT_EQ(store.getType(id), expected.getType(id));
+            ASSERT_EQ(store.getMaterialId(id), expected.getMaterialId(id));
+            ASSERT_EQ(store.getVertexCount(id), expected.getVertexCount(id));
+            for (int j = 0; j < store.getVertexCount(id); j++)
+            {
+                ASSERT_EQ(store.getVertexIds(id)[j], expected.getVertexIds(id)[j]);
+            }
+        }
+        for (int i = 0; i < 20; i++)
+        {
+            ASSERT_EQ(store.getHexahedra().getId(i), expected.getHexahedra().getId(i));
+        }
+    }
+}
+
+TEST(getCellsTest, cellStoreTypes) {
+    writeMixedModel("MixedModel.mod");
+    Model mod("MixedModel.mod");
+    std::vector<Cell> cells = mod.getCells();
+
+    // The gap in the IDs is compacted away
+    ASSERT_EQ(cells.size(), 3);
+    ASSERT_EQ(cells[0].getType(), 't');
+    ASSERT_EQ(cells[1].getType(), 'p');
+    ASSERT_EQ(cells[2].getType(), 'h');
+    ASSERT_EQ(mod.getCellIdMap().getId(2), 3);
+
+    // Volumes come from the real cell types, not the base class
+    ASSERT_NEAR(cells[0].getVolume(), 8.0 / 6, 1e-12);
+    ASSERT_NEAR(cells[1].getVolume(), 8.0 / 3, 1e-12);
+
+    std::remove("MixedModel.mod");
+}
+
+TEST(kernelTest, cellStoreBase) {
+    writeMixedModel("MixedModel.mod");
+    Model mod("MixedModel.mod");
+    std::vector<Cell> cells = mod.getCells();
+
+    std::vector<double> volumes = mod.getCellVolumes();
+    std::vector<double> masses = mod.getCellMasses();
+    std::vector<Vector3D> centres = mod.getCellCentres();
+
+    // Text files give dense cells, with no empty entries
+    ASSERT_EQ(volumes.size(), cells.size());
+    for (int i = 0; i < cells.size(); i++)
+    {
+        ASSERT_NE(cells[i].getType(), 0);
+        ASSERT_EQ(volumes[i], cells[i].getVolume());
+        ASSERT_EQ(masses[i], cells[i].getMass());
+        ASSERT_EQ(centres[i], cells[i].getCentre());
+    }
+
+    std::remove("MixedModel.mod");
+}
+
+TEST(materialTableTest, cellStoreBase) {
+    writeMixedModel("MixedModel.mod");
+    Model mod("MixedModel.mod");
+    std::vector<Cell> cells = mod.getCells();
+
+    // Cells resolve their material through the model's table
+    ASSERT_EQ(cells[0].getMaterialId(), 1);
+    ASSERT_EQ(cells[1].getMaterialId(), 0);
+    ASSERT_EQ(cells[2].getMaterialId(), 1);
+    ASSERT_EQ(cells[0].getMaterial(), mod.getMaterialTable().get(1));
+    ASSERT_EQ(cells[1].getMaterial().getName(), "cu");
+    ASSERT_NEAR(cells[0].getMass(), 2700 * 8.0 / 6, 1e-9);
+
+    std::remove("MixedModel.mod");
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_cellstream.cpp
+ * @brief Unit tests for the CellStream class and cells streamed by a load
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "cellstream.h"
+#include "model.h"
+
+// Helper that counts the cells of batches
+static int countCells(const std::vector<CellBatch> &batches)
+{
+    int count = 0;
+    for (const CellBatch &batch : batches)
+    {
+        count += batch.size();
+    }
+    return count;
+}
+
+TEST(pushTest, cellStream) {
+    CellStream stream(10);
+    ASSERT_EQ(stream.getRoom(), 10);
+    ASSERT_TRUE(stream.take().empty());
+
+    CellBatch batch;
+    batch.types.assign(4, 't');
+    batch.colours.assign(4, 0xb87333);
+    batch.points.assign(4 * 4 * 3, 0.5f);
+    stream.push(std::move(batch));
+    ASSERT_EQ(stream.getRoom(), 6);
+
+    // Batches are taken once
+    std::vector<CellBatch> taken = stream.take();
+    ASSERT_EQ(taken.size(), 1);
+    ASSERT_EQ(taken[0].size(), 4);
+    ASSERT_EQ(taken[0].points.size(), 48);
+    ASSERT_TRUE(stream.take().empty());
+    ASSERT_EQ(stream.getRoom(), 6);
+}
+
+TEST(loadTest, cellStream) {
+    for (int threadCount = 1; threadCount <= 4; threadCount++)
+    {
+        // Vertices come first in the file, so every cell is streamed, with
+        // the model's own positions and material colour
+        CellStream stream(1000);
+        Model model("tests/ExampleModel.mod", threadCount, nullptr, Precision::Double, nullptr, &stream);
+        ASSERT_EQ(model.getCellCount(), 100);
+        std::vector<CellBatch> batches = stream.take();
+        ASSERT_EQ(countCells(batches), 100);
+        ASSERT_EQ(batches[0].types[0], 'h');
+        ASSERT_EQ(batches[0].colours[0], 0xb87333);
+        ASSERT_EQ(batches[0].points.size() % 3, 0);
+        Vector3D first = model.getVertexStore().get(model.getVertexIdMap().find(0));
+        ASSERT_FLOAT_EQ(batches[0].points[0], first.getX());
+        ASSERT_FLOAT_EQ(batches[0].points[1], first.getY());
+        ASSERT_FLOAT_EQ(batches[0].points[2], first.getZ());
+    }
+
+    // The stream takes no more than its limit, the model still gets everything
+    CellStream limited(10);
+    Model model("tests/ExampleModel.mod", 2, nullptr, Precision::Double, nullptr, &limited);
+    ASSERT_EQ(model.getCellCount(), 100);
+    ASSERT_EQ(countCells(limited.take()), 10);
+    ASSERT_EQ(limited.getRoom(), 0);
+}
+
+TEST(orderTest, cellStream) {
+    // A cell before its vertices, in a slice of the file parsed before
+    // theirs, then cells with sparse and undefined vertex IDs
+    {
+        std::ofstream file("ExampleStreamOrder.mod", std::ios::binary);
+        file << "m 0 8940 b87333 cu\n";
+        file << "c 0 t 0 0 1 2 3\n";
+        std::string comment = "# " + std::string(1021, '-') + "\n";
+        for (int i = 0; i < 6 * 1024; i++)
+        {
+            file << comment;
+        }
+        file << "v 0 0 0 0\nv 1 1 0 0\nv 2 0 1 0\nv 3 0 0 1\n";
+        file << "v 5000000000 0 0 2\n";
+        file << "c 1 t 0 1 2 3 5000000000\n";
+        file << "c 2 t 0 1 2 3 9\n";
+    }
+    CellStream stream(100);
+    Model model("ExampleStreamOrder.mod", 1, nullptr, Precision::Double, nullptr, &stream);
+    std::remove("ExampleStreamOrder.mod");
+
+    // Only the cell whose vertices are read by the time it is sent is
+    // streamed, the finished load resolving the first one as well
+    ASSERT_EQ(model.getCellCount(), 2);
+    std::vector<CellBatch> batches = stream.take();
+    ASSERT_EQ(countCells(batches), 1);
+    ASSERT_EQ(batches[0].points.size(), 12);
+    ASSERT_FLOAT_EQ(batches[0].points[9], 0);
+    ASSERT_FLOAT_EQ(batches[0].points[11], 2);
+}
@@ -0,0 +1,155 @@
+/**
+ * @file test_faceadjacency.cpp
+ * @brief Unit tests for the FaceAdjacency class and its parallel construction
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include "cell.h"
+#include "cellstore.h"
+#include "faceadjacency.h"
+#include "model.h"
+
+// Helper that adds an n x n x n grid of hexahedra, cell (i, j, k) taking
+// ID firstId + step * ((k * n + j) * n + i)
+static void addHexGrid(CellStore &cells, int n, int firstId, int step)
+{
+    int side = n + 1;
+    for (int k = 0; k < n; k++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                int v0 = (k * side + j) * side + i;
+                int v3 = v0 + side;
+                int v4 = v0 + side * side;
+                int v7 = v3 + side * side;
+                int vertexIds[8] = {v0, v0 + 1, v3 + 1, v3, v4, v4 + 1, v7 + 1, v7};
+                cells.add(firstId + step * ((k * n + j) * n + i), 'h', 0, vertexIds);
+            }
+        }
+    }
+}
+
+// Every neighbour must list the cell back
+static void expectSymmetric(const FaceAdjacency &adjacency)
+{
+    for (int id = 0; id < adjacency.getCellCount(); id++)
+    {
+        for (int face = 0; face < adjacency.getFaceCount(id); face++)
+        {
+            int neighbour = adjacency.getNeighbour(id, face);
+            if (neighbour < 0)
+            {
+                continue;
+            }
+            int backLinks = 0;
+            for (int other = 0; other < adjacency.getFaceCount(neighbour); other++)
+            {
+                backLinks += adjacency.getNeighbour(neighbour, other) == id;
+            }
+            EXPECT_EQ(backLinks, 1) << id << " " << neighbour;
+        }
+    }
+}
+
+TEST(gridTest, faceAdjacency) {
+    CellStore cells;
+    addHexGrid(cells, 3, 0, 1);
+    FaceAdjacency adjacency = buildFaceAdjacency(cells, 2);
+
+    ASSERT_EQ(adjacency.getCellCount(), 27);
+    ASSERT_EQ(adjacency.getFaceCount(), 27 * 6);
+    ASSERT_EQ(adjacency.getBoundaryFaceCount(), 6 * 9);
+    ASSERT_EQ(adjacency.getNonManifoldFaceCount(), 0);
+    expectSymmetric(adjacency);
+
+    // Centre cell: every face is shared, in the order of Hexahedron::FACES
+    const int *neighbours = adjacency.getNeighbours(13);
+    ASSERT_EQ(adjacency.getFaceCount(13), 6);
+    ASSERT_EQ(neighbours[0], 4);  // below
+    ASSERT_EQ(neighbours[1], 22); // above
+    ASSERT_EQ(neighbours[2], 10); // -y
+    ASSERT_EQ(neighbours[3], 14); // +x
+    ASSERT_EQ(neighbours[4], 16); // +y
+    ASSERT_EQ(neighbours[5], 12); // -x
+
+    // Corner cell: three boundary faces
+    ASSERT_EQ(adjacency.getNeighbour(0, 0), FaceAdjacency::BOUNDARY);
+    ASSERT_EQ(adjacency.getNeighbour(0, 1), 9);
+    ASSERT_EQ(adjacency.getNeighbour(0, 5), FaceAdjacency::BOUNDARY);
+}
+
+TEST(mixedTest, faceAdjacency) {
+    // Hexahedron, pyramid on its top face, tetrahedron on a pyramid side,
+    // with unused IDs in between
+    CellStore cells;
+    int hexahedron[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    int pyramid[5] = {4, 5, 6, 7, 8};
+    int tetrahedron[4] = {4, 8, 5, 9};
+    cells.add(1, 'h', 0, hexahedron);
+    cells.add(3, 'p', 0, pyramid);
+    cells.add(4, 't', 0, tetrahedron);
+
+    FaceAdjacency adjacency = buildFaceAdjacency(cells, 0);
+    ASSERT_EQ(adjacency.getCellCount(), 5);
+    ASSERT_EQ(adjacency.getFaceCount(0), 0);
+    ASSERT_EQ(adjacency.getFaceCount(2), 0);
+    ASSERT_EQ(adjacency.getFaceCount(), 6 + 5 + 4);
+    ASSERT_EQ(adjacency.getBoundaryFaceCount(), 5 + 3 + 3);
+
+    ASSERT_EQ(adjacency.getNeighbour(1, 1), 3);
+    ASSERT_EQ(adjacency.getNeighbour(3, 0), 1);
+    ASSERT_EQ(adjacency.getNeighbour(3, 1), 4);
+    ASSERT_EQ(adjacency.getNeighbour(4, 0), 3);
+    ASSERT_EQ(adjacency.getNeighbour(3, 2), FaceAdjacency::BOUNDARY);
+    expectSymmetric(adjacency);
+}
+
+TEST(nonManifoldTest, faceAdjacency) {
+    // Three tetrahedra on the same triangle
+    CellStore cells;
+    int first[4] = {0, 1, 2, 3};
+    int second[4] = {0, 2, 1, 4};
+    int third[4] = {1, 0, 2, 5};
+    cells.add(0, 't', 0, first);
+    cells.add(1, 't', 0, second);
+    cells.add(2, 't', 0, third);
+
+    FaceAdjacency adjacency = buildFaceAdjacency(cells, 1);
+    ASSERT_EQ(adjacency.getNonManifoldFaceCount(), 3);
+    ASSERT_EQ(adjacency.getBoundaryFaceCount(), 9);
+    ASSERT_EQ(adjacency.getNeighbour(0, 0), FaceAdjacency::NON_MANIFOLD);
+    ASSERT_EQ(adjacency.getNeighbour(1, 0), FaceAdjacency::NON_MANIFOLD);
+}
+
+TEST(threadTest, faceAdjacency) {
+    // Sparse IDs, so that threads get uneven shares of faces
+    CellStore cells;
+    addHexGrid(cells, 12, 5, 3);
+    FaceAdjacency reference = buildFaceAdjacency(cells, 1);
+    ASSERT_EQ(reference.getBoundaryFaceCount(), 6 * 144);
+    expectSymmetric(reference);
+
+    for (int threadCount : {2, 3, 8, 0})
+    {
+        FaceAdjacency adjacency = buildFaceAdjacency(cells, threadCount);
+        ASSERT_EQ(adjacency.getOffsets(), reference.getOffsets()) << threadCount;
+        ASSERT_EQ(adjacency.getEntries(), reference.getEntries()) << threadCount;
+    }
+}
+
+TEST(modelTest, faceAdjacency) {
+    Model model("tests/ExampleModel.mod");
+    FaceAdjacency adjacency = model.getFaceAdjacency();
+    ASSERT_EQ(adjacency.getCellCount(), model.getCellCount());
+    ASSERT_GT(adjacency.getBoundaryFaceCount(), 0);
+    ASSERT_LT(adjacency.getBoundaryFaceCount(), adjacency.getFaceCount());
+    expectSymmetric(adjacency);
+
+    FaceAdjacency empty = Model().getFaceAdjacency();
+    ASSERT_EQ(empty.getCellCount(), 0);
+    ASSERT_EQ(empty.getFaceCount(), 0);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file test_idmap.cpp
+ * @brief Unit tests for the IdMap class and sparse model IDs
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "idmap.h"
+#include "model.h"
+
+// Helper that writes a tetrahedron numbered like a global exporter would
+static void writeSparseModel(const char *filename)
+{
+    std::ofstream out(filename);
+    out << "m 70 8940 b87333 cu\n"
+        << "v 4000000000 0 0 0\nv 12 1 0 0\nv 900000 0 1 0\nv 5 0 0 1\n"
+        << "c 3000000000 t 70 4000000000 12 900000 5\n"
+        << "c 17 t 70 5 12 900000 4000000000\n"
+        << "c 18 t 71 5 12 900000 4000000000\n";
+}
+
+TEST(identityTest, idMapBase) {
+    IdMap map;
+    std::vector<std::int64_t> ids = {0, 1, 2, 3};
+    ASSERT_TRUE(map.assign(ids.data(), ids.size()));
+
+    ASSERT_TRUE(map.isIdentity());
+    ASSERT_EQ(map.getMemorySize(), 0);
+    ASSERT_EQ(map.find(2), 2);
+    ASSERT_EQ(map.find(4), -1);
+    ASSERT_EQ(map.find(-1), -1);
+    ASSERT_EQ(map.getId(3), 3);
+}
+
+TEST(sparseTest, idMapBase) {
+    IdMap map;
+    std::vector<std::int64_t> ids;
+    for (int i = 0; i < 1000; i++)
+    {
+        ids.push_back(7 + (std::int64_t)i * 4000000007);
+    }
+    ASSERT_TRUE(map.assign(ids.data(), ids.size()));
+
+    ASSERT_FALSE(map.isIdentity());
+    ASSERT_EQ(map.size(), 1000);
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_EQ(map.find(ids[i]), i);
+        ASSERT_EQ(map.getId(i), ids[i]);
+        ASSERT_EQ(map.find(ids[i] + 1), -1);
+    }
+
+    // Repeated IDs are rejected
+    ids.push_back(ids[10]);
+    ASSERT_FALSE(map.assign(ids.data(), ids.size()));
+    ASSERT_EQ(map.size(), 0);
+}
+
+TEST(sparseModelTest, idMapBase) {
+    writeSparseModel("SparseModel.mod");
+    Model mod("SparseModel.mod");
+
+    // Storage is sized by the number of records, in ID order
+    ASSERT_EQ(mod.getVertexCount(), 4);
+    ASSERT_EQ(mod.getMaterialCount(), 1);
+    ASSERT_EQ(mod.getCellCount(), 2);
+    ASSERT_EQ(mod.getVertexIdMap().getId(0), 5);
+    ASSERT_EQ(mod.getVertexIdMap().getId(3), 4000000000);
+    ASSERT_EQ(mod.getVertexStore().get(mod.getVertexIdMap().find(900000)), Vector3D(0, 1, 0));
+    ASSERT_EQ(mod.getCellIdMap().getId(0), 17);
+    ASSERT_EQ(mod.getCellIdMap().getId(1), 3000000000);
+    ASSERT_EQ(mod.getCell(1).getMaterial().getId(), 70);
+    ASSERT_NEAR(mod.getCell(1).getVolume(), 1.0 / 6, 1e-12);
+
+    // The file IDs survive saving in both formats
+    mod.saveToFile("SparseSaved.mod");
+    mod.saveBinary("SparseSaved.modb");
+    Model saved("SparseSaved.mod");
+    Model binary("SparseSaved.modb");
+    for (const Model *copy : {&saved, &binary})
+    {
+        ASSERT_EQ(copy->getCellCount(), 2);
+        ASSERT_EQ(copy->getVertexIdMap().getId(3), 4000000000);
+        ASSERT_EQ(copy->getCellIdMap().getId(1), 3000000000);
+        ASSERT_EQ(copy->getCell(0).getVertex(0), mod.getCell(0).getVertex(0));
+        ASSERT_EQ(copy->getCell(1).getMaterial().getId(), 70);
+    }
+
+    std::remove("SparseModel.mod");
+    std::remove("SparseSaved.mod");
+    std::remove("SparseSaved.modb");
+}
@@ -0,0 +1,210 @@
+/**
+ * @file test_massproperties.cpp
+ * @brief Unit tests for the compensated sums and the whole-model mass properties
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "cell.h"
+#include "massproperties.h"
+#include "model.h"
+
+// Helper that writes a row of count unit cubes along x, alternating
+// between a dense and a light material, with a pyramid on top of the first
+static void writeCubeRow(const char *filename, int count)
+{
+    std::ofstream out(filename);
+    out << "m 0 8000 b87333 heavy\nm 1 1000 d0d5db light\n";
+    for (int i = 0; i <= count; i++)
+    {
+        out << "v " << 4 * i << " " << i << " 0 0\n"
+            << "v " << 4 * i + 1 << " " << i << " 1 0\n"
+            << "v " << 4 * i + 2 << " " << i << " 0 1\n"
+            << "v " << 4 * i + 3 << " " << i << " 1 1\n";
+    }
+    int apex = 4 * (count + 1);
+    out << "v " << apex << " 0.5 0.5 2\n";
+    for (int i = 0; i < count; i++)
+    {
+        int a = 4 * i;
+        int b = 4 * (i + 1);
+        out << "c " << i << " h " << i % 2 << " " << a << " " << b << " " << b + 1 << " " << a + 1 << " "
+            << a + 2 << " " << b + 2 << " " << b + 3 << " " << a + 3 << "\n";
+    }
+    out << "c " << count << " p 1 2 6 7 3 " << apex << "\n";
+}
+
+// Helper that writes an nx x ny x nz block of unit hexahedra of density 500,
+// rotated about z by angle and moved to offset
+static void writeRotatedBlock(const char *filename, int nx, int ny, int nz, double angle, double offset)
+{
+    std::ofstream out(filename);
+    out.precision(17);
+    out << "m 0 500 b87333 block\n";
+    for (int k = 0; k <= nz; k++)
+    {
+        for (int j = 0; j <= ny; j++)
+        {
+            for (int i = 0; i <= nx; i++)
+            {
+                int id = (k * (ny + 1) + j) * (nx + 1) + i;
+                double x = std::cos(angle) * i - std::sin(angle) * j;
+                double y = std::sin(angle) * i + std::cos(angle) * j;
+                out << "v " << id << " " << x + offset << " " << y + offset << " " << k + offset << "\n";
+            }
+        }
+    }
+    int cellId = 0;
+    for (int k = 0; k < nz; k++)
+    {
+        for (int j = 0; j < ny; j++)
+        {
+            for (int i = 0; i < nx; i++)
+            {
+                int v0 = (k * (ny + 1) + j) * (nx + 1) + i;
+                int v3 = v0 + nx + 1;
+                int v4 = v0 + (nx + 1) * (ny + 1);
+                int v7 = v3 + (nx + 1) * (ny + 1);
+                out << "c " << cellId++ << " h 0 " << v0 << " " << v0 + 1 << " " << v3 + 1 << " " << v3 << " "
+                    << v4 << " " << v4 + 1 << " " << v7 + 1 << " " << v7 << "\n";
+            }
+        }
+    }
+}
+
+TEST(compensatedTest, massProperties) {
+    // Plain summation loses every small term
+    CompensatedSum sum;
+    double plain = 0;
+    sum.add(1e16);
+    plain += 1e16;
+    for (int i = 0; i < 1000; i++)
+    {
+        sum.add(1.0);
+        plain += 1.0;
+    }
+    sum.add(-1e16);
+    plain += -1e16;
+    ASSERT_EQ(sum.getValue(), 1000);
+    ASSERT_NE(plain, 1000);
+
+    CompensatedSum other;
+    other.add(0.1);
+    sum.add(other);
+    ASSERT_DOUBLE_EQ(sum.getValue(), 1000.1);
+}
+
+TEST(centroidTest, massProperties) {
+    // Centroid of a pyramid is a quarter of the way up from its base
+    Vector3D pyramid[5] = {Vector3D(0, 0, 0), Vector3D(2, 0, 0), Vector3D(2, 2, 0), Vector3D(0, 2, 0),
+                           Vector3D(1, 1, 3)};
+    Vector3D centroid = (1 / Pyramid::computeVolume(pyramid)) * Pyramid::computeMoment(pyramid);
+    ASSERT_NEAR(centroid.getX(), 1, 1e-14);
+    ASSERT_NEAR(centroid.getY(), 1, 1e-14);
+    ASSERT_NEAR(centroid.getZ(), 0.75, 1e-14);
+
+    // Hexahedron with a sloping top z = 1 + x, whose centroid is not the mean of its vertices
+    Vector3D hexahedron[8] = {Vector3D(0, 0, 0), Vector3D(1, 0, 0), Vector3D(1, 1, 0), Vector3D(0, 1, 0),
+                              Vector3D(0, 0, 1), Vector3D(1, 0, 2), Vector3D(1, 1, 2), Vector3D(0, 1, 1)};
+    double volume = Hexahedron::computeVolume(hexahedron);
+    centroid = (1 / volume) * Hexahedron::computeMoment(hexahedron);
+    ASSERT_NEAR(volume, 1.5, 1e-14);
+    ASSERT_NEAR(centroid.getX(), 5.0 / 9, 1e-14);
+    ASSERT_NEAR(centroid.getY(), 0.5, 1e-14);
+    ASSERT_NEAR(centroid.getZ(), (7.0 / 6) / 1.5, 1e-14);
+}
+
+TEST(modelTest, massProperties) {
+    const char *filename = "test_massproperties.mod";
+    writeCubeRow(filename, 9);
+    Model mod(filename, 1);
+    MassProperties properties = mod.getMassProperties(1);
+
+    // Five heavy and four light cubes, and a light pyramid of volume 1/3
+    ASSERT_EQ(properties.cellCount, 10);
+    ASSERT_NEAR(properties.volume, 9 + 1.0 / 3, 1e-12);
+    ASSERT_NEAR(properties.mass, 5 * 8000 + 4 * 1000 + 1000.0 / 3, 1e-9);
+    ASSERT_EQ(properties.materials.size(), 2);
+    ASSERT_EQ(properties.materials[0].cellCount, 5);
+    ASSERT_NEAR(properties.materials[0].volume, 5, 1e-12);
+    ASSERT_NEAR(properties.materials[0].centreOfGravity.getX(), 4.5, 1e-12);
+    ASSERT_NEAR(properties.materials[1].mass, 4000 + 1000.0 / 3, 1e-9);
+
+    // Centre of gravity: x from the cubes at 0.5, 1.5, ... and the pyramid at 0.5
+    double momentX = 8000 * (0.5 + 2.5 + 4.5 + 6.5 + 8.5) + 1000 * (1.5 + 3.5 + 5.5 + 7.5) + 1000.0 / 3 * 0.5;
+    double momentZ = 44000 * 0.5 + 1000.0 / 3 * 1.25;
+    ASSERT_NEAR(properties.centreOfGravity.getX(), momentX / properties.mass, 1e-12);
+    ASSERT_NEAR(properties.centreOfGravity.getY(), 0.5, 1e-12);
+    ASSERT_NEAR(properties.centreOfGravity.getZ(), momentZ / properties.mass, 1e-12);
+
+    // Same totals as the per-cell masses
+    std::vector<double> masses = mod.getCellMasses();
+    double mass = 0;
+    for (double cellMass : masses)
+    {
+        mass += cellMass;
+    }
+    ASSERT_NEAR(properties.mass, mass, 1e-9);
+
+    std::remove(filename);
+}
+
+TEST(inertiaTest, massProperties) {
+    // Box of 4 x 2 x 1 unit cells far from the origin, turned by 30 degrees
+    const char *filename = "test_massproperties_inertia.mod";
+    double angle = std::acos(-1.0) / 6;
+    writeRotatedBlock(filename, 4, 2, 1, angle, 1e5);
+    Model mod(filename, 1);
+    MassProperties properties = mod.getMassProperties(1);
+
+    // Solid box: I = m (b^2 + c^2) / 12 about each axis
+    double mass = 500 * 8;
+    ASSERT_NEAR(properties.mass, mass, 1e-8);
+    ASSERT_NEAR(properties.principalMoments.getX(), mass * (4 + 1) / 12, 1e-6);
+    ASSERT_NEAR(properties.principalMoments.getY(), mass * (16 + 1) / 12, 1e-6);
+    ASSERT_NEAR(properties.principalMoments.getZ(), mass * (16 + 4) / 12, 1e-6);
+
+    // Smallest moment along the long side of the box, largest along z
+    ASSERT_NEAR(std::fabs(properties.principalAxes.get(0, 0)), std::cos(angle), 1e-9);
+    ASSERT_NEAR(std::fabs(properties.principalAxes.get(1, 0)), std::sin(angle), 1e-9);
+    ASSERT_NEAR(std::fabs(properties.principalAxes.get(2, 2)), 1, 1e-9);
+
+    // Centre of gravity at the middle of the box, despite the offset
+    ASSERT_NEAR(properties.centreOfGravity.getX(), 1e5 + 2 * std::cos(angle) - std::sin(angle), 1e-9);
+    ASSERT_NEAR(properties.centreOfGravity.getZ(), 1e5 + 0.5, 1e-9);
+
+    // Products of inertia appear in the tensor of the rotated box
+    double ixx = mass * (16 * std::sin(angle) * std::sin(angle) + 4 * std::cos(angle) * std::cos(angle) + 1) / 12;
+    ASSERT_NEAR(properties.inertia.get(0, 0), ixx, 1e-6);
+    ASSERT_NEAR(properties.inertia.get(0, 1), properties.inertia.get(1, 0), 1e-9);
+    ASSERT_NE(properties.inertia.get(0, 1), 0);
+
+    std::remove(filename);
+}
+
+TEST(threadTest, massProperties) {
+    // Enough cells for several blocks, in both precisions
+    const char *filename = "test_massproperties_threads.mod";
+    writeCubeRow(filename, 20000);
+    Precision precisions[] = {Precision::Double, Precision::Single};
+    for (Precision precision : precisions)
+    {
+        Model mod(filename, 0, nullptr, precision);
+        MassProperties reference = mod.getMassProperties(1);
+        for (int threadCount = 2; threadCount <= 8; threadCount += 3)
+        {
+            MassProperties properties = mod.getMassProperties(threadCount);
+            ASSERT_EQ(properties.volume, reference.volume);
+            ASSERT_EQ(properties.mass, reference.mass);
+            ASSERT_EQ(properties.centreOfGravity.getX(), reference.centreOfGravity.getX());
+            ASSERT_EQ(properties.centreOfGravity.getZ(), reference.centreOfGravity.getZ());
+            ASSERT_EQ(properties.materials[1].mass, reference.materials[1].mass);
+            ASSERT_EQ(properties.inertia, reference.inertia);
+        }
+    }
+    std::remove(filename);
+}
@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 #include "material.h"
+#include "materialtable.h"
 
 // Test parameters
 Material m1(1, 5, "brown", "bronze");
@@ -42,4 +43,16 @@ TEST(mutatorTest, materialBase) {
 TEST(equalityTest, materialBase) {
     Material mEqual(1, 5, "brown", "bronze");
     ASSERT_EQ(m1, mEqual);
-}
\ No newline at end of file
+}
+
+TEST(tableTest, materialBase) {
+    MaterialTable table;
+    table.set(2, m1);
+
+    ASSERT_EQ(table.size(), 3);
+    ASSERT_EQ(table.get(2), m1);
+    ASSERT_EQ(table.get(0), Material());
+    ASSERT_EQ(table.getDensity(2), 5);
+    ASSERT_EQ(table.getDensities()[0], 0);
+    ASSERT_EQ(table.toVector()[2], m1);
+}
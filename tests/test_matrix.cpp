@@ -0,0 +1,92 @@
+/**
+ * @file test_matrix.cpp
+ * @brief Unit tests for the Matrix3x3 class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "matrix.h"
+#include "vector3d.h"
+
+// Arithmetic is usable in constant expressions
+static constexpr Matrix3x3 A(2, 1, 0, 0, 3, 1, 1, 0, 4);
+static_assert(A.determinant() == 25, "determinant");
+static_assert(A.transpose().get(0, 2) == 1, "transpose");
+static_assert((A * Matrix3x3::identity()) == A, "identity");
+static_assert((A + A).get(1, 1) == 6, "addition");
+static_assert(A.trace() == 9, "trace");
+
+TEST(arithmeticTest, matrixBase) {
+    Matrix3x3 b(1, 2, 3, 4, 5, 6, 7, 8, 10);
+    Matrix3x3 product = A * b;
+    ASSERT_EQ(product.get(0, 0), 6);
+    ASSERT_EQ(product.get(1, 2), 28);
+    ASSERT_EQ(product.get(2, 1), 34);
+    ASSERT_EQ((A * b).transpose(), b.transpose() * A.transpose());
+    ASSERT_EQ((2 * A).get(2, 2), 8);
+
+    Vector3D v = A * Vector3D(1, 2, 3);
+    ASSERT_EQ(v.getX(), 4);
+    ASSERT_EQ(v.getY(), 9);
+    ASSERT_EQ(v.getZ(), 13);
+
+    Vector3D diagonal(1, 2, 3);
+    Matrix3x3 d;
+    d.setDiagonal(diagonal);
+    ASSERT_EQ(d, Matrix3x3::diagonal(1, 2, 3));
+}
+
+TEST(inverseTest, matrixBase) {
+    Matrix3x3 inverse;
+    ASSERT_TRUE(A.getInverse(inverse));
+    Matrix3x3 product = A * inverse;
+    for (int r = 0; r < 3; r++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            ASSERT_NEAR(product.get(r, c), r == c ? 1 : 0, 1e-15);
+        }
+    }
+
+    // Singular matrices leave the result alone
+    Matrix3x3 singular(1, 2, 3, 2, 4, 6, 0, 1, 1);
+    ASSERT_FALSE(singular.getInverse(inverse));
+    ASSERT_NEAR((A * inverse).get(0, 0), 1, 1e-15);
+}
+
+TEST(eigenTest, matrixBase) {
+    // Rotate a known diagonal matrix and decompose it again
+    double angle = 0.7;
+    Matrix3x3 rx(1, 0, 0, 0, std::cos(angle), -std::sin(angle), 0, std::sin(angle), std::cos(angle));
+    Matrix3x3 rz(std::cos(2 * angle), -std::sin(2 * angle), 0, std::sin(2 * angle), std::cos(2 * angle), 0, 0, 0, 1);
+    Matrix3x3 rotation = rz * rx;
+    Matrix3x3 symmetric = rotation * Matrix3x3::diagonal(5, 1e-6, 2) * rotation.transpose();
+
+    Vector3D eigenvalues;
+    Matrix3x3 eigenvectors;
+    symmetric.getEigenDecomposition(eigenvalues, eigenvectors);
+    ASSERT_NEAR(eigenvalues.getX(), 1e-6, 1e-14);
+    ASSERT_NEAR(eigenvalues.getY(), 2, 1e-14);
+    ASSERT_NEAR(eigenvalues.getZ(), 5, 1e-14);
+    ASSERT_NEAR(eigenvectors.determinant(), 1, 1e-14);
+
+    // V diag V^T gives back the matrix, and the columns are the rotated axes
+    Matrix3x3 rebuilt = eigenvectors * Matrix3x3::diagonal(eigenvalues.getX(), eigenvalues.getY(), eigenvalues.getZ()) *
+                        eigenvectors.transpose();
+    for (int r = 0; r < 3; r++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            ASSERT_NEAR(rebuilt.get(r, c), symmetric.get(r, c), 1e-14);
+        }
+        ASSERT_NEAR(std::fabs(eigenvectors.get(r, 2)), std::fabs(rotation.get(r, 0)), 1e-14);
+    }
+
+    // Already diagonal, repeated eigenvalues
+    Matrix3x3::diagonal(3, 1, 3).getEigenDecomposition(eigenvalues, eigenvectors);
+    ASSERT_EQ(eigenvalues.getX(), 1);
+    ASSERT_EQ(eigenvalues.getZ(), 3);
+    ASSERT_EQ(std::fabs(eigenvectors.get(1, 0)), 1);
+}
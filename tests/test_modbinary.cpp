@@ -0,0 +1,113 @@
+/**
+ * @file test_modbinary.cpp
+ * @brief Unit tests for the binary .mod companion format
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "modbinary.h"
+#include "model.h"
+
+// Helper that reads a whole file into a string
+static std::string readFile(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST(roundTripTest, modBinaryBase) {
+    Model text("tests/ExampleModel.mod");
+    ASSERT_TRUE(text.saveBinary("ExampleModel.modb"));
+
+    Model binary("ExampleModel.modb");
+
+    ASSERT_FALSE(binary.getIsSTL());
+    ASSERT_EQ(binary.getMaterialCount(), text.getMaterialCount());
+    ASSERT_EQ(binary.getVertexCount(), text.getVertexCount());
+    ASSERT_EQ(binary.getCellCount(), text.getCellCount());
+
+    std::vector<Material> textMaterials = text.getMaterials();
+    std::vector<Material> binaryMaterials = binary.getMaterials();
+    for (int i = 0; i < textMaterials.size(); i++)
+    {
+        ASSERT_EQ(binaryMaterials[i], textMaterials[i]);
+    }
+
+    std::vector<Vector3D> textVertices = text.getVertices();
+    std::vector<Vector3D> binaryVertices = binary.getVertices();
+    for (int i = 0; i < textVertices.size(); i++)
+    {
+        ASSERT_EQ(binaryVertices[i], textVertices[i]);
+    }
+
+    std::vector<Cell> textCells = text.getCells();
+    std::vector<Cell> binaryCells = binary.getCells();
+    for (int i = 0; i < textCells.size(); i++)
+    {
+        std::vector<Vector3D> textCellVertices = textCells[i].getVertices();
+        std::vector<Vector3D> binaryCellVertices = binaryCells[i].getVertices();
+        ASSERT_EQ(binaryCellVertices.size(), textCellVertices.size());
+        for (int j = 0; j < textCellVertices.size(); j++)
+        {
+            ASSERT_EQ(binaryCellVertices[j], textCellVertices[j]);
+        }
+    }
+
+    // Saving the binary model again reproduces the file byte for byte
+    ASSERT_TRUE(binary.saveBinary("ExampleModelCopy.modb"));
+    ASSERT_EQ(readFile("ExampleModelCopy.modb"), readFile("ExampleModel.modb"));
+
+    std::remove("ExampleModel.modb");
+    std::remove("ExampleModelCopy.modb");
+}
+
+TEST(viewTest, modBinaryBase) {
+    ASSERT_TRUE(convertModToBinary("tests/ExampleModel.mod", "ExampleModel.modb"));
+
+    ModBinaryFile file("ExampleModel.modb");
+
+    ASSERT_TRUE(file.isValid());
+    ASSERT_EQ(file.getVersion(), MOD_BINARY_VERSION);
+    ASSERT_EQ(file.getMaterialCount(), 1);
+    ASSERT_EQ(file.getVertexCount(), 220);
+    ASSERT_EQ(file.getCellCount(), 100);
+    ASSERT_EQ(file.getConnectivitySize(), 800);
+
+    ASSERT_EQ(file.getMaterial(0), Material(0, 8940, "b87333", "cu"));
+    ASSERT_NEAR(file.getY()[0], -0.3, 0.009);
+    ASSERT_NEAR(file.getY()[1], -0.4, 0.009);
+    ASSERT_EQ(file.getCellTypes()[0], 'h');
+    ASSERT_EQ(file.getCellMaterialIds()[0], 0);
+    ASSERT_EQ(file.getCellOffsets()[1], 8);
+    ASSERT_EQ(file.getConnectivity()[2], 3);
+    ASSERT_EQ(file.getConnectivity()[3], 2);
+
+    std::remove("ExampleModel.modb");
+}
+
+TEST(invalidFileTest, modBinaryBase) {
+    ASSERT_TRUE(convertModToBinary("tests/ExampleModel.mod", "ExampleModel.modb"));
+    std::string contents = readFile("ExampleModel.modb");
+    std::remove("ExampleModel.modb");
+
+    // Truncated file
+    std::ofstream truncated("Truncated.modb", std::ios::binary);
+    truncated.write(contents.data(), contents.size() / 2);
+    truncated.close();
+
+    ModBinaryFile file("Truncated.modb");
+    ASSERT_FALSE(file.isValid());
+
+    Model model("Truncated.modb");
+    ASSERT_EQ(model.getCellCount(), 0);
+    std::remove("Truncated.modb");
+
+    // Missing input
+    ASSERT_FALSE(convertModToBinary("tests/DoesNotExist.mod", "Missing.modb"));
+}
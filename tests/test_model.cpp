@@ -6,10 +6,19 @@
  */
 
 #include <gtest/gtest.h>
+#include "loadprogress.h"
 #include "model.h"
 #include "material.h"
+#include "modparser.h"
 #include <vector>
 #include <string>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 
 TEST(parseMaterialTest, modelBase) {
 
@@ -64,6 +73,58 @@ TEST(parseCellTest, modelBase) {
     ASSERT_NEAR(z1, 0, 0.009);
 }
 
+TEST(cellVertexIdTest, modelBase) {
+
+	Model mod("tests/ExampleModel.mod");
+    std::vector<Cell> cells = mod.getCells();
+    std::vector<Vector3D> vertices = mod.getVertices();
+
+    // c 0 h 0 0 1 3 2 4 5 7 6
+    int expectedIds[] = {0, 1, 3, 2, 4, 5, 7, 6};
+    std::vector<int> vertexIds = cells[0].getVertexIds();
+
+    ASSERT_EQ(cells[0].getVertexCount(), 8);
+    ASSERT_EQ(vertexIds.size(), 8);
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_EQ(vertexIds[i], expectedIds[i]);
+        ASSERT_EQ(cells[0].getVertex(i), vertices[expectedIds[i]]);
+    }
+}
+
+TEST(cellStoreTest, modelBase) {
+
+	Model mod("tests/ExampleModel.mod");
+    const CellStore &cells = mod.getCellStore();
+
+    // Every cell of the file is in the array of its type
+    int cellCount = cells.getTetrahedra().size() + cells.getPyramids().size() + cells.getHexahedra().size();
+    ASSERT_EQ(cellCount, mod.getCellCount());
+    ASSERT_EQ(cells.getHexahedra().getId(0), 0);
+    ASSERT_EQ(cells.getHexahedra().getVertexIds(0)[2], 3);
+    ASSERT_EQ(cells.getConnectivitySize(), 4 * cells.getTetrahedra().size() + 5 * cells.getPyramids().size() +
+                                               8 * cells.getHexahedra().size());
+}
+
+TEST(saveToFileTest, modelBase) {
+
+	Model original("tests/ExampleModel.mod");
+    original.saveToFile("SavedModel.mod");
+    Model saved("SavedModel.mod");
+
+    ASSERT_EQ(saved.getCellCount(), original.getCellCount());
+
+    std::vector<Cell> originalCells = original.getCells();
+    std::vector<Cell> savedCells = saved.getCells();
+    for (int i = 0; i < originalCells.size(); i++)
+    {
+        ASSERT_EQ(savedCells[i].getVertexIds(), originalCells[i].getVertexIds());
+        ASSERT_EQ(savedCells[i].getMaterial().getId(), originalCells[i].getMaterial().getId());
+    }
+
+    std::remove("SavedModel.mod");
+}
+
 TEST(materialCountTest, modelBase) {
 
     int countExpected = 1;
@@ -96,3 +157,160 @@ TEST(cellCountTest, modelBase) {
 
 	ASSERT_EQ(countObtained, countExpected);
 }
+
+TEST(lineEndingTest, modelBase) {
+
+    // Write a copy of the example model with Windows line endings
+    std::ifstream inFile("tests/ExampleModel.mod");
+    std::ofstream outFile("ExampleModelCRLF.mod", std::ios::binary);
+    std::string line;
+    while (std::getline(inFile, line))
+    {
+        outFile << line << "\r\n";
+    }
+    outFile.close();
+
+	Model mod("ExampleModelCRLF.mod");
+    std::remove("ExampleModelCRLF.mod");
+
+    ASSERT_EQ(mod.getMaterials()[0].getName(), "cu");
+    ASSERT_EQ(mod.getVertexCount(), 220);
+    ASSERT_EQ(mod.getCellCount(), 100);
+}
+
+#ifndef _WIN32
+TEST(pipeLoadTest, modelBase) {
+
+    // A named pipe cannot be mapped, so it is read into a buffer instead
+    std::remove("ExampleModelPipe.mod");
+    ASSERT_EQ(mkfifo("ExampleModelPipe.mod", 0600), 0);
+
+    std::ifstream inFile("tests/ExampleModel.mod", std::ios::binary);
+    std::stringstream contents;
+    contents << inFile.rdbuf();
+    std::thread writer([&]() {
+        std::ofstream pipe("ExampleModelPipe.mod", std::ios::binary);
+        pipe << contents.str();
+    });
+
+	Model mod("ExampleModelPipe.mod", 2);
+    writer.join();
+    std::remove("ExampleModelPipe.mod");
+
+	Model file("tests/ExampleModel.mod");
+    ASSERT_EQ(mod.getMaterialCount(), file.getMaterialCount());
+    ASSERT_EQ(mod.getVertexCount(), 220);
+    ASSERT_EQ(mod.getCellCount(), 100);
+    ASSERT_EQ(mod.getVertices(), file.getVertices());
+}
+#endif
+
+TEST(parallelLoadTest, modelBase) {
+
+	Model serial("tests/ExampleModel.mod");
+
+    // Use more threads than there are lines in some chunks
+    int threadCounts[] = {2, 3, 7, 64};
+    for (int t = 0; t < 4; t++)
+    {
+        Model parallel("tests/ExampleModel.mod", threadCounts[t]);
+
+        ASSERT_EQ(parallel.getMaterialCount(), serial.getMaterialCount());
+        ASSERT_EQ(parallel.getVertexCount(), serial.getVertexCount());
+        ASSERT_EQ(parallel.getCellCount(), serial.getCellCount());
+
+        std::vector<Material> serialMaterials = serial.getMaterials();
+        std::vector<Material> parallelMaterials = parallel.getMaterials();
+        for (int i = 0; i < serialMaterials.size(); i++)
+        {
+            ASSERT_EQ(parallelMaterials[i], serialMaterials[i]);
+        }
+
+        std::vector<Vector3D> serialVertices = serial.getVertices();
+        std::vector<Vector3D> parallelVertices = parallel.getVertices();
+        for (int i = 0; i < serialVertices.size(); i++)
+        {
+            ASSERT_EQ(parallelVertices[i], serialVertices[i]);
+        }
+
+        std::vector<Cell> serialCells = serial.getCells();
+        std::vector<Cell> parallelCells = parallel.getCells();
+        for (int i = 0; i < serialCells.size(); i++)
+        {
+            std::vector<Vector3D> serialCellVertices = serialCells[i].getVertices();
+            std::vector<Vector3D> parallelCellVertices = parallelCells[i].getVertices();
+            ASSERT_EQ(parallelCellVertices.size(), serialCellVertices.size());
+            for (int j = 0; j < serialCellVertices.size(); j++)
+            {
+                ASSERT_EQ(parallelCellVertices[j], serialCellVertices[j]);
+            }
+            ASSERT_EQ(parallelCells[i].getMaterial(), serialCells[i].getMaterial());
+        }
+    }
+}
+
+TEST(loadProgressTest, modelBase) {
+
+	LoadProgress progress;
+	ASSERT_STREQ(progress.getPhase(), "");
+	ASSERT_EQ(progress.getFraction(), 0);
+
+	Model mod("tests/ExampleModel.mod", 3, nullptr, Precision::Double, &progress);
+
+    // Same model as without progress, every phase run to its end
+    ASSERT_EQ(mod.getCellCount(), 100);
+    ASSERT_EQ(mod.getVertexCount(), 220);
+    ASSERT_STREQ(progress.getPhase(), "Resolving cells");
+    ASSERT_EQ(progress.getFraction(), 1);
+    ASSERT_FALSE(progress.isCancelled());
+}
+
+TEST(loadCancelTest, modelBase) {
+
+    // A load cancelled before it starts stops after parsing
+	LoadProgress progress;
+	progress.cancel();
+	Model mod("tests/ExampleModel.mod", 2, nullptr, Precision::Double, &progress);
+    ASSERT_TRUE(progress.isCancelled());
+    ASSERT_EQ(mod.getCellCount(), 0);
+
+    // Parsing checks for cancellation as it goes
+    std::string buffer;
+    for (int i = 0; i < 200000; i++)
+    {
+        buffer += "v " + std::to_string(i) + " 0.125 0.25 0.5\n";
+    }
+    ModParser parser;
+    parser.parse(buffer.data(), buffer.data() + buffer.size(), &progress);
+    ASSERT_GT(parser.getVertices().size(), 0);
+    ASSERT_LT(parser.getVertices().size(), 200000);
+
+    LoadProgress running;
+    running.beginPhase("Parsing", buffer.size());
+    ModParser complete;
+    complete.parse(buffer.data(), buffer.data() + buffer.size(), &running);
+    ASSERT_EQ(complete.getVertices().size(), 200000);
+    ASSERT_EQ(running.getFraction(), 1);
+}
+
+TEST(loadStepCancelTest, modelBase) {
+
+    // Binary and STL loads stop as well, leaving nothing behind
+    LoadProgress progress;
+    progress.cancel();
+    Model source("tests/ExampleModel.mod");
+    ASSERT_TRUE(source.saveBinary("ExampleCancel.modb"));
+    Model binary("ExampleCancel.modb", 2, nullptr, Precision::Double, &progress);
+    ASSERT_EQ(binary.getCellCount(), 0);
+    std::remove("ExampleCancel.modb");
+
+    Model stl("tests/ExampleSTL.stl", 2, nullptr, Precision::Double, &progress);
+    ASSERT_EQ(stl.getVertexCount(), 0);
+    ASSERT_EQ(stl.getTriangleCount(), 0);
+
+    // So do the stats computed after the load
+    ASSERT_EQ(source.getMassProperties(2).cellCount, 100);
+    ASSERT_EQ(source.getMassProperties(2, &progress).cellCount, 0);
+    ASSERT_GT(source.getBoundarySurface(2).getArea(), 0);
+    ASSERT_EQ(source.getBoundarySurface(2, &progress).getArea(), 0);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file test_modelpreview.cpp
+ * @brief Unit tests for the ModelPreview class and file sampling
+ * @author 13CAD team
+ * @version 1.0 17/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "model.h"
+#include "loadprogress.h"
+#include "modelpreview.h"
+#include "vertexstore.h"
+
+// Helper that checks every point of preview is a vertex of model
+static void expectModelVertices(const ModelPreview &preview, const Model &model)
+{
+    std::vector<Vector3D> vertices;
+    for (int i = 0; i < model.getVertexCount(); i++)
+    {
+        vertices.push_back(model.getVertexStore().get(i));
+    }
+    for (const Vector3D &point : preview.getPoints())
+    {
+        EXPECT_NE(std::find(vertices.begin(), vertices.end(), point), vertices.end());
+    }
+}
+
+TEST(boundsTest, modelPreview) {
+    ModelPreview preview;
+    ASSERT_TRUE(preview.isEmpty());
+
+    preview.add(Vector3D(1, -2, 3));
+    ASSERT_EQ(preview.getMin(), Vector3D(1, -2, 3));
+    ASSERT_EQ(preview.getMax(), Vector3D(1, -2, 3));
+
+    preview.add(Vector3D(-1, 4, 3.5));
+    preview.add(Vector3D(0, 0, 0));
+    ASSERT_EQ(preview.getPointCount(), 3);
+    ASSERT_EQ(preview.getMin(), Vector3D(-1, -2, 0));
+    ASSERT_EQ(preview.getMax(), Vector3D(1, 4, 3.5));
+}
+
+TEST(textTest, modelPreview) {
+    Model model("tests/ExampleModel.mod");
+    Vector3D min, max;
+    ASSERT_TRUE(model.getVertexStore().getBounds(min, max));
+
+    // More samples than lines take every vertex once
+    ModelPreview full = readModelPreview("tests/ExampleModel.mod", 1000);
+    ASSERT_EQ(full.getPointCount(), model.getVertexCount());
+    ASSERT_EQ(full.getMin(), min);
+    ASSERT_EQ(full.getMax(), max);
+    expectModelVertices(full, model);
+
+    // Fewer take some of them, within the model's bounds
+    ModelPreview sample = readModelPreview("tests/ExampleModel.mod", 32);
+    ASSERT_GT(sample.getPointCount(), 0);
+    ASSERT_LE(sample.getPointCount(), 32);
+    expectModelVertices(sample, model);
+    ASSERT_GE(sample.getMin().getX(), min.getX());
+    ASSERT_LE(sample.getMax().getX(), max.getX());
+}
+
+TEST(binaryTest, modelPreview) {
+    Model model("tests/ExampleModel.mod");
+    ASSERT_TRUE(model.saveBinary("ExamplePreview.modb"));
+
+    ModelPreview sample = readModelPreview("ExamplePreview.modb", 16);
+    ASSERT_EQ(sample.getPointCount(), 16);
+    ASSERT_EQ(sample.getPoints()[0], model.getVertexStore().get(0));
+    expectModelVertices(sample, model);
+
+    ModelPreview full = readModelPreview("ExamplePreview.modb", 100000);
+    ASSERT_EQ(full.getPointCount(), model.getVertexCount());
+    std::remove("ExamplePreview.modb");
+}
+
+TEST(emptyTest, modelPreview) {
+    ASSERT_TRUE(readModelPreview("tests/ExampleSTL.stl", 100).isEmpty());
+    ASSERT_TRUE(readModelPreview("tests/DoesNotExist.mod", 100).isEmpty());
+    ASSERT_TRUE(readModelPreview("tests/ExampleModel.mod", 0).isEmpty());
+}
+
+TEST(cancelTest, modelPreview) {
+    LoadProgress progress;
+    progress.cancel();
+    ASSERT_TRUE(readModelPreview("tests/ExampleModel.mod", 100, &progress).isEmpty());
+}
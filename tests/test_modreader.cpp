@@ -0,0 +1,127 @@
+/**
+ * @file test_modreader.cpp
+ * @brief Unit tests for the ModReader class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "modreader.h"
+#include "model.h"
+
+/**
+ * Visitor that counts records and remembers the first of each kind
+ */
+class CountingVisitor : public ModVisitor
+{
+  public:
+    int materialCount = 0;
+    int vertexCount = 0;
+    int cellCount = 0;
+    std::string firstMaterialName;
+    Vector3D firstVertex;
+    std::int64_t lastVertexId = -1;
+    std::int64_t lastCellId = -1;
+    std::vector<std::int64_t> firstCellVertexIds;
+
+    void visitMaterial(const Material &material)
+    {
+        if (materialCount++ == 0)
+        {
+            firstMaterialName = material.getName();
+        }
+    }
+
+    void visitVertex(std::int64_t id, const Vector3D &vertex)
+    {
+        lastVertexId = id;
+        if (vertexCount++ == 0)
+        {
+            firstVertex = vertex;
+        }
+    }
+
+    void visitCell(std::int64_t id, char type, int materialId, const std::vector<std::int64_t> &vertexIds)
+    {
+        lastCellId = id;
+        if (cellCount++ == 0)
+        {
+            firstCellVertexIds = vertexIds;
+        }
+    }
+};
+
+TEST(readFileTest, modReaderBase) {
+    ModReader reader("tests/ExampleModel.mod");
+    CountingVisitor visitor;
+
+    ASSERT_TRUE(reader.read(visitor));
+
+    ASSERT_EQ(visitor.materialCount, 1);
+    ASSERT_EQ(visitor.vertexCount, 220);
+    ASSERT_EQ(visitor.cellCount, 100);
+    ASSERT_EQ(visitor.firstMaterialName, "cu");
+    ASSERT_EQ(visitor.firstVertex, Vector3D(0, -0.3, 0));
+
+    std::int64_t expectedIds[] = {0, 1, 3, 2, 4, 5, 7, 6};
+    ASSERT_EQ(visitor.firstCellVertexIds, std::vector<std::int64_t>(expectedIds, expectedIds + 8));
+}
+
+TEST(readStreamTest, modReaderBase) {
+    std::ifstream file("tests/ExampleModel.mod");
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    // A tiny block size forces lines to straddle blocks and the buffer to grow
+    ModReader reader(contents, 7);
+    CountingVisitor visitor;
+
+    ASSERT_TRUE(reader.read(visitor));
+
+    ASSERT_EQ(visitor.materialCount, 1);
+    ASSERT_EQ(visitor.vertexCount, 220);
+    ASSERT_EQ(visitor.cellCount, 100);
+    ASSERT_EQ(visitor.firstVertex, Vector3D(0, -0.3, 0));
+}
+
+TEST(readStreamTest, modReaderNoTrailingNewline) {
+    std::istringstream contents("m 0 8940 b87333 cu\nv 0 1 2 3\nv 1 4 5 6");
+    ModReader reader(contents);
+    CountingVisitor visitor;
+
+    ASSERT_TRUE(reader.read(visitor));
+
+    ASSERT_EQ(visitor.materialCount, 1);
+    ASSERT_EQ(visitor.vertexCount, 2);
+}
+
+TEST(readStreamTest, modReaderLargeIds) {
+    // Globally numbered IDs above 2^31 reach the visitor unchanged
+    std::istringstream contents("m 0 8940 b87333 cu\n"
+                                "v 3000000000 0 0 0\nv 3000000001 1 0 0\n"
+                                "v 3000000002 0 1 0\nv 9000000000 0 0 1\n"
+                                "c 5000000000 t 0 3000000000 3000000001 3000000002 9000000000\n");
+    ModReader reader(contents);
+    CountingVisitor visitor;
+
+    ASSERT_TRUE(reader.read(visitor));
+
+    ASSERT_EQ(visitor.vertexCount, 4);
+    ASSERT_EQ(visitor.cellCount, 1);
+    ASSERT_EQ(visitor.lastVertexId, 9000000000LL);
+    ASSERT_EQ(visitor.lastCellId, 5000000000LL);
+    std::int64_t expectedIds[] = {3000000000LL, 3000000001LL, 3000000002LL, 9000000000LL};
+    ASSERT_EQ(visitor.firstCellVertexIds, std::vector<std::int64_t>(expectedIds, expectedIds + 4));
+}
+
+TEST(readFileTest, modReaderMissingFile) {
+    ModReader reader("tests/DoesNotExist.mod");
+    CountingVisitor visitor;
+
+    ASSERT_FALSE(reader.read(visitor));
+}
@@ -0,0 +1,79 @@
+/**
+ * @file test_modtokenizer.cpp
+ * @brief Unit tests for the .mod tokenizer and number conversion
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include "modtokenizer.h"
+
+// Helper that wraps a C string in a StringSpan
+static StringSpan span(const char *text)
+{
+    StringSpan s = {text, text + std::strlen(text)};
+    return s;
+}
+
+TEST(splitTokensTest, tokenizerBase) {
+    const char *line = "c  12\th 0 1 2 3 4 5 6 7 8\r";
+    StringSpan tokens[16];
+
+    int count = splitTokens(line, line + std::strlen(line), tokens, 16);
+
+    ASSERT_EQ(count, 12);
+    ASSERT_EQ(tokens[0].toString(), "c");
+    ASSERT_EQ(tokens[1].toString(), "12");
+    ASSERT_EQ(tokens[2].toString(), "h");
+    ASSERT_EQ(tokens[11].toString(), "8");
+}
+
+TEST(splitTokensTest, tokenizerLimit) {
+    const char *line = "m 0 8940 b87333 cu extra words";
+    StringSpan tokens[5];
+
+    int count = splitTokens(line, line + std::strlen(line), tokens, 5);
+
+    ASSERT_EQ(count, 5);
+    ASSERT_EQ(tokens[4].toString(), "cu");
+}
+
+TEST(parseIntegerTest, tokenizerBase) {
+    int value = 0;
+    long long wide = 0;
+
+    ASSERT_TRUE(parseInteger(span("42"), value));
+    ASSERT_EQ(value, 42);
+    ASSERT_TRUE(parseInteger(span("-7"), value));
+    ASSERT_EQ(value, -7);
+    ASSERT_TRUE(parseInteger(span("4000000000"), wide));
+    ASSERT_EQ(wide, 4000000000LL);
+
+    ASSERT_FALSE(parseInteger(span(""), value));
+    ASSERT_FALSE(parseInteger(span("12a"), value));
+    ASSERT_FALSE(parseInteger(span("4000000000"), value));
+}
+
+TEST(parseDoubleTest, tokenizerBase) {
+    const char *samples[] = {"0", "-0.3", "0.1", "-0.242705", "0.0927051", "1e-3",
+                             "2.5E+10", "123456789012345678901234", "1e-320", "3.14159265358979323846",
+                             "9007199254740993", ".5", "5.", "-1.7976931348623157e308"};
+
+    for (int i = 0; i < sizeof(samples) / sizeof(samples[0]); i++)
+    {
+        double value = 0;
+        ASSERT_TRUE(parseDouble(span(samples[i]), value)) << samples[i];
+        ASSERT_EQ(value, std::strtod(samples[i], nullptr)) << samples[i];
+    }
+}
+
+TEST(parseDoubleTest, tokenizerInvalid) {
+    double value = 0;
+
+    ASSERT_FALSE(parseDouble(span(""), value));
+    ASSERT_FALSE(parseDouble(span("-"), value));
+    ASSERT_FALSE(parseDouble(span("1.5x"), value));
+    ASSERT_FALSE(parseDouble(span("1e"), value));
+}
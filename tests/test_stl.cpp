@@ -0,0 +1,213 @@
+/**
+ * @file test_stl.cpp
+ * @brief Unit tests for loading STL files into Model
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "model.h"
+
+// Corner indices of the 12 triangles of a unit cube
+static const int CUBE_TRIANGLES[12][3] = {
+    {0, 2, 1}, {1, 2, 3}, {4, 5, 6}, {5, 7, 6}, {0, 1, 4}, {1, 5, 4},
+    {2, 6, 3}, {3, 6, 7}, {0, 4, 2}, {2, 4, 6}, {1, 3, 5}, {3, 7, 5}};
+
+// Helper returning coordinate axis of cube corner i
+static float cubeCorner(int i, int axis)
+{
+    return (float)((i >> axis) & 1);
+}
+
+// Helper that writes a unit cube as a binary STL triangle soup
+static void writeBinaryCube(const std::string &filename)
+{
+    std::ofstream out(filename, std::ios::binary);
+    char header[80] = "binary cube";
+    std::uint32_t count = 12;
+    out.write(header, sizeof(header));
+    out.write((const char *)&count, sizeof(count));
+
+    for (int t = 0; t < 12; t++)
+    {
+        float values[12] = {0};
+        for (int c = 0; c < 3; c++)
+        {
+            for (int axis = 0; axis < 3; axis++)
+            {
+                values[3 + 3 * c + axis] = cubeCorner(CUBE_TRIANGLES[t][c], axis);
+            }
+        }
+        std::uint16_t attribute = 0;
+        out.write((const char *)values, sizeof(values));
+        out.write((const char *)&attribute, sizeof(attribute));
+    }
+}
+
+// Helper that writes a unit cube as an ASCII STL, with a blank line and
+// a whitespace-only line around each facet if padded
+static void writeAsciiCube(const std::string &filename, bool padded = false)
+{
+    std::ofstream out(filename, std::ios::binary);
+    out << "solid cube\r\n";
+    for (int t = 0; t < 12; t++)
+    {
+        if (padded)
+        {
+            out << "\r\n";
+        }
+        out << "  facet normal 0 0 0\r\n    outer loop\r\n";
+        for (int c = 0; c < 3; c++)
+        {
+            int i = CUBE_TRIANGLES[t][c];
+            out << "      vertex " << cubeCorner(i, 0) << " " << cubeCorner(i, 1) << " " << cubeCorner(i, 2) << "\r\n";
+        }
+        out << "    endloop\r\n  endfacet\r\n";
+        if (padded)
+        {
+            out << "    \t \r\n";
+        }
+    }
+    out << "endsolid cube\r\n";
+}
+
+// Helper checking that a loaded model is the welded unit cube
+static void checkCube(Model &model)
+{
+    ASSERT_TRUE(model.getIsSTL());
+    ASSERT_EQ(model.getVertexCount(), 8);
+    ASSERT_EQ(model.getTriangleCount(), 12);
+    ASSERT_EQ(model.getCellCount(), 0);
+
+    std::vector<Vector3D> vertices = model.getVertices();
+    std::vector<int> triangles = model.getTriangles();
+    ArrayView<int> triangleView = model.getTriangleView();
+    ASSERT_EQ(std::vector<int>(triangleView.begin(), triangleView.end()), triangles);
+    for (int t = 0; t < 12; t++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            int corner = CUBE_TRIANGLES[t][c];
+            Vector3D &v = vertices[triangles[3 * t + c]];
+            ASSERT_EQ(v, Vector3D(cubeCorner(corner, 0), cubeCorner(corner, 1), cubeCorner(corner, 2)));
+        }
+    }
+}
+
+TEST(binaryStlTest, stlBase) {
+    writeBinaryCube("cube_binary.stl");
+
+    Model model("cube_binary.stl");
+    checkCube(model);
+
+    // Parallel decoding gives the same result
+    Model parallelModel("cube_binary.stl", 4);
+    checkCube(parallelModel);
+    ASSERT_EQ(parallelModel.getTriangles(), model.getTriangles());
+
+    std::remove("cube_binary.stl");
+}
+
+// Helper that writes an n x n grid of squares as a binary STL, two
+// triangles per square, with -0 for the zero coordinates of odd squares
+static void writeBinaryGrid(const std::string &filename, int n)
+{
+    std::ofstream out(filename, std::ios::binary);
+    char header[80] = "binary grid";
+    std::uint32_t count = 2 * n * n;
+    out.write(header, sizeof(header));
+    out.write((const char *)&count, sizeof(count));
+
+    const int split[2][3] = {{0, 1, 3}, {0, 3, 2}};
+    for (int j = 0; j < n; j++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            float zero = (i + j) % 2 == 0 ? 0.0f : -0.0f;
+            for (int t = 0; t < 2; t++)
+            {
+                float values[12] = {0};
+                for (int c = 0; c < 3; c++)
+                {
+                    int corner = split[t][c];
+                    values[3 + 3 * c] = (float)(i + (corner & 1)) * 0.5f;
+                    values[4 + 3 * c] = (float)(j + (corner >> 1)) * 0.5f;
+                    values[5 + 3 * c] = zero;
+                }
+                std::uint16_t attribute = 0;
+                out.write((const char *)values, sizeof(values));
+                out.write((const char *)&attribute, sizeof(attribute));
+            }
+        }
+    }
+}
+
+TEST(binaryStlTest, stlParallelWeld) {
+
+    // Enough corners to be welded on several threads
+    writeBinaryGrid("grid_binary.stl", 120);
+    Model model("grid_binary.stl");
+    ASSERT_EQ(model.getTriangleCount(), 2 * 120 * 120);
+    ASSERT_EQ(model.getVertexCount(), 121 * 121);
+
+    // Vertices are numbered in the order they first appear
+    std::vector<int> triangles = model.getTriangles();
+    int next = 0;
+    for (int index : triangles)
+    {
+        ASSERT_LE(index, next);
+        next += index == next;
+    }
+    ASSERT_EQ(model.getVertexStore().get(triangles[2]), Vector3D(0.5, 0.5, 0));
+
+    int threadCounts[] = {2, 3, 8};
+    for (int threadCount : threadCounts)
+    {
+        Model parallelModel("grid_binary.stl", threadCount);
+        ASSERT_EQ(parallelModel.getTriangles(), triangles);
+        ASSERT_EQ(parallelModel.getVertices(), model.getVertices());
+    }
+
+    std::remove("grid_binary.stl");
+}
+
+TEST(asciiStlTest, stlBase) {
+    writeAsciiCube("cube_ascii.stl");
+
+    Model model("cube_ascii.stl");
+    checkCube(model);
+
+    std::remove("cube_ascii.stl");
+}
+
+TEST(asciiStlTest, stlBlankLines) {
+    writeAsciiCube("cube_padded.stl", true);
+
+    Model model("cube_padded.stl");
+    checkCube(model);
+
+    std::remove("cube_padded.stl");
+}
+
+TEST(binaryStlTest, stlTruncated) {
+    writeBinaryCube("cube_truncated.stl");
+
+    // Cut the last triangle in half, the header still claims 12 triangles
+    std::ifstream in("cube_truncated.stl", std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out("cube_truncated.stl", std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), contents.size() - 25);
+    out.close();
+
+    Model model("cube_truncated.stl");
+    ASSERT_EQ(model.getTriangleCount(), 11);
+
+    std::remove("cube_truncated.stl");
+}
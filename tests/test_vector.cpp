@@ -6,6 +6,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
 #include "vector3d.h"
 
 // Test parameters
@@ -91,3 +92,24 @@ TEST(midpointTest, vectorBase) {
     ASSERT_NEAR(midpointObtained.getY(), midpointExpected.getY(), 0.009);
     ASSERT_NEAR(midpointObtained.getZ(), midpointExpected.getZ(), 0.009);
 }
+
+// Operations are usable in constant expressions
+static constexpr Vector3D c1(1, 2, 3);
+static constexpr Vector3D c2(4, 5, 6);
+static_assert(c1.dot(c2) == 32, "dot");
+static_assert(c1.cross(c2) == Vector3D(-3, 6, -3), "cross");
+static_assert((2.0 * c1 - c2).getZ() == 0, "arithmetic");
+static_assert(c1.midpoint(c2) == Vector3D(2.5, 3.5, 4.5), "midpoint");
+
+TEST(constTest, vectorBase) {
+    // Const vectors and temporaries can call every accessor
+    const Vector3D vConst(1, 2, 3);
+    ASSERT_EQ(vConst.getY() + Vector3D(4, 5, 6).getY(), 7);
+    ASSERT_EQ(vConst.distance(Vector3D(1, 2, 7)), 4);
+
+    // Arrays of vectors can be copied bytewise
+    Vector3D source[2] = {v1, v2};
+    Vector3D copy[2];
+    std::memcpy(copy, source, sizeof(source));
+    ASSERT_EQ(copy[1], v2);
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_vectorkernels.cpp
+ * @brief Unit tests for the batch kernels over coordinate columns
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "matrix.h"
+#include "simd.h"
+#include "vector3d.h"
+#include "vectorkernels.h"
+
+// Levels compared with the scalar reference
+static const SimdLevel SIMD_LEVELS[] = {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512};
+
+// Random coordinate columns, a count that leaves a tail at every level
+struct RandomColumns
+{
+    std::vector<double> x, y, z;
+
+    explicit RandomColumns(int count, unsigned seed)
+    {
+        std::srand(seed);
+        for (int i = 0; i < count; i++)
+        {
+            x.push_back(200 * (std::rand() / (double)RAND_MAX) - 100);
+            y.push_back(200 * (std::rand() / (double)RAND_MAX) - 100);
+            z.push_back(200 * (std::rand() / (double)RAND_MAX) - 100);
+        }
+    }
+
+    Vector3D get(int i) const { return Vector3D(x[i], y[i], z[i]); }
+};
+
+TEST(dotTest, vectorKernels) {
+    const int count = 1003;
+    RandomColumns a(count, 1), b(count, 2);
+
+    std::vector<double> reference(count);
+    computeDots(a.x.data(), a.y.data(), a.z.data(), b.x.data(), b.y.data(), b.z.data(), count, reference.data(),
+                SimdLevel::Scalar);
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(reference[i], a.get(i).dot(b.get(i)));
+    }
+
+    for (SimdLevel level : SIMD_LEVELS)
+    {
+        std::vector<double> dots(count);
+        computeDots(a.x.data(), a.y.data(), a.z.data(), b.x.data(), b.y.data(), b.z.data(), count, dots.data(),
+                    level);
+        ASSERT_EQ(dots, reference) << getSimdLevelName(resolveSimdLevel(level));
+    }
+}
+
+TEST(crossTest, vectorKernels) {
+    const int count = 1003;
+    RandomColumns a(count, 3), b(count, 4);
+
+    RandomColumns reference(count, 0);
+    computeCrosses(a.x.data(), a.y.data(), a.z.data(), b.x.data(), b.y.data(), b.z.data(), count,
+                   reference.x.data(), reference.y.data(), reference.z.data(), SimdLevel::Scalar);
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(reference.get(i), a.get(i).cross(b.get(i)));
+    }
+
+    for (SimdLevel level : SIMD_LEVELS)
+    {
+        RandomColumns crosses(count, 0);
+        computeCrosses(a.x.data(), a.y.data(), a.z.data(), b.x.data(), b.y.data(), b.z.data(), count,
+                       crosses.x.data(), crosses.y.data(), crosses.z.data(), level);
+        ASSERT_EQ(crosses.x, reference.x) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(crosses.y, reference.y) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(crosses.z, reference.z) << getSimdLevelName(resolveSimdLevel(level));
+    }
+}
+
+TEST(distanceTest, vectorKernels) {
+    const int count = 1003;
+    RandomColumns v(count, 5);
+    Vector3D point(1.5, -20, 7.25);
+
+    std::vector<double> reference(count);
+    std::vector<double> referenceNorms(count);
+    computeDistances(v.x.data(), v.y.data(), v.z.data(), count, point, reference.data(), SimdLevel::Scalar);
+    computeNorms(v.x.data(), v.y.data(), v.z.data(), count, referenceNorms.data(), SimdLevel::Scalar);
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(reference[i], point.distance(v.get(i)));
+        ASSERT_EQ(referenceNorms[i], std::sqrt(v.get(i).dot(v.get(i))));
+    }
+
+    for (SimdLevel level : SIMD_LEVELS)
+    {
+        std::vector<double> distances(count);
+        std::vector<double> norms(count);
+        computeDistances(v.x.data(), v.y.data(), v.z.data(), count, point, distances.data(), level);
+        computeNorms(v.x.data(), v.y.data(), v.z.data(), count, norms.data(), level);
+        ASSERT_EQ(distances, reference) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(norms, referenceNorms) << getSimdLevelName(resolveSimdLevel(level));
+    }
+}
+
+TEST(transformTest, vectorKernels) {
+    const int count = 1003;
+    RandomColumns v(count, 6);
+    double angle = 0.3;
+    Matrix3x3 rotation(std::cos(angle), -std::sin(angle), 0, std::sin(angle), std::cos(angle), 0, 0, 0, 2);
+    Vector3D offset(10, -5, 0.125);
+
+    RandomColumns reference(count, 0);
+    transformVectors(v.x.data(), v.y.data(), v.z.data(), count, rotation, offset, reference.x.data(),
+                     reference.y.data(), reference.z.data(), SimdLevel::Scalar);
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(reference.get(i), rotation * v.get(i) + offset);
+    }
+
+    for (SimdLevel level : SIMD_LEVELS)
+    {
+        // In place
+        RandomColumns transformed = v;
+        transformVectors(transformed.x.data(), transformed.y.data(), transformed.z.data(), count, rotation, offset,
+                         transformed.x.data(), transformed.y.data(), transformed.z.data(), level);
+        ASSERT_EQ(transformed.x, reference.x) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(transformed.y, reference.y) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(transformed.z, reference.z) << getSimdLevelName(resolveSimdLevel(level));
+    }
+
+    // Single columns are transformed in double, then rounded
+    std::vector<float> xf(v.x.begin(), v.x.end()), yf(v.y.begin(), v.y.end()), zf(v.z.begin(), v.z.end());
+    std::vector<float> referenceX(count), referenceY(count), referenceZ(count);
+    transformVectors(xf.data(), yf.data(), zf.data(), count, rotation, offset, referenceX.data(), referenceY.data(),
+                     referenceZ.data(), SimdLevel::Scalar);
+    Vector3D expected = rotation * Vector3D(xf[7], yf[7], zf[7]) + offset;
+    ASSERT_EQ(referenceX[7], (float)expected.getX());
+    ASSERT_EQ(referenceY[7], (float)expected.getY());
+    ASSERT_EQ(referenceZ[7], (float)expected.getZ());
+    for (SimdLevel level : SIMD_LEVELS)
+    {
+        std::vector<float> outX(count), outY(count), outZ(count);
+        transformVectors(xf.data(), yf.data(), zf.data(), count, rotation, offset, outX.data(), outY.data(),
+                         outZ.data(), level);
+        ASSERT_EQ(outX, referenceX) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(outY, referenceY) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(outZ, referenceZ) << getSimdLevelName(resolveSimdLevel(level));
+    }
+}
+
+TEST(boundsTest, vectorKernels) {
+    Vector3D min(1, 2, 3), max(4, 5, 6);
+    ASSERT_FALSE(computeBounds<double>(nullptr, nullptr, nullptr, 0, min, max));
+    ASSERT_EQ(min, Vector3D(1, 2, 3));
+
+    for (int count : {1, 2, 7, 1003})
+    {
+        RandomColumns v(count, 7 + count);
+        std::vector<float> xf(v.x.begin(), v.x.end()), yf(v.y.begin(), v.y.end()), zf(v.z.begin(), v.z.end());
+
+        Vector3D expectedMin = v.get(0), expectedMax = v.get(0);
+        for (int i = 1; i < count; i++)
+        {
+            expectedMin = Vector3D(std::fmin(expectedMin.getX(), v.x[i]), std::fmin(expectedMin.getY(), v.y[i]),
+                                   std::fmin(expectedMin.getZ(), v.z[i]));
+            expectedMax = Vector3D(std::fmax(expectedMax.getX(), v.x[i]), std::fmax(expectedMax.getY(), v.y[i]),
+                                   std::fmax(expectedMax.getZ(), v.z[i]));
+        }
+
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            ASSERT_TRUE(computeBounds(v.x.data(), v.y.data(), v.z.data(), count, min, max, level));
+            ASSERT_EQ(min, expectedMin) << getSimdLevelName(resolveSimdLevel(level));
+            ASSERT_EQ(max, expectedMax) << getSimdLevelName(resolveSimdLevel(level));
+
+            ASSERT_TRUE(computeBounds(xf.data(), yf.data(), zf.data(), count, min, max, level));
+            ASSERT_EQ(min.getX(), (float)expectedMin.getX());
+            ASSERT_EQ(max.getZ(), (float)expectedMax.getZ());
+        }
+    }
+
+    // NaN coordinates after the first vector are skipped
+    std::vector<double> x = {0, NAN, 3, 1, -2, 0, 0, 0, 0, NAN, 5};
+    std::vector<double> y(x.size(), 1), z(x.size(), 2);
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+    {
+        ASSERT_TRUE(computeBounds(x.data(), y.data(), z.data(), x.size(), min, max, level));
+        ASSERT_EQ(min, Vector3D(-2, 1, 2)) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(max, Vector3D(5, 1, 2)) << getSimdLevelName(resolveSimdLevel(level));
+    }
+}
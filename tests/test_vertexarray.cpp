@@ -0,0 +1,98 @@
+/**
+ * @file test_vertexarray.cpp
+ * @brief Unit tests for the VertexArray class
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "vertexarray.h"
+
+TEST(columnTest, vertexArrayBase) {
+    VertexArray vertices;
+    vertices.push_back(Vector3D(1, 2, 3));
+    vertices.push_back(4, 5, 6);
+    vertices.resize(3);
+
+    ASSERT_EQ(vertices.size(), 3);
+    ASSERT_EQ(vertices.getX()[1], 4);
+    ASSERT_EQ(vertices.getY()[0], 2);
+    ASSERT_EQ(vertices.getZ()[2], 0);
+    ASSERT_EQ(vertices.get(1), Vector3D(4, 5, 6));
+
+    // Columns start on a cache line
+    ASSERT_EQ((std::size_t)vertices.getX() % VertexArray::ALIGNMENT, 0);
+    ASSERT_EQ((std::size_t)vertices.getY() % VertexArray::ALIGNMENT, 0);
+    ASSERT_EQ((std::size_t)vertices.getZ() % VertexArray::ALIGNMENT, 0);
+}
+
+TEST(proxyTest, vertexArrayBase) {
+    std::vector<Vector3D> source;
+    source.push_back(Vector3D(1, 2, 3));
+    source.push_back(Vector3D(4, 5, 6));
+    VertexArray vertices(source);
+
+    // Code written for Vector3D works through the proxy
+    Vector3D v = vertices[0];
+    ASSERT_EQ(v, Vector3D(1, 2, 3));
+    ASSERT_EQ(vertices[1].getY(), 5);
+
+    vertices[0] = Vector3D(7, 8, 9);
+    vertices[1].setZ(-1);
+    ASSERT_EQ(vertices.get(0), Vector3D(7, 8, 9));
+    ASSERT_EQ(vertices.getZ()[1], -1);
+    ASSERT_EQ(vertices.toVector()[1], Vector3D(4, 5, -1));
+}
+
+TEST(boundsTest, vertexArrayBase) {
+    VertexArray vertices;
+    Vector3D min;
+    Vector3D max;
+    ASSERT_FALSE(vertices.getBounds(min, max));
+
+    // Enough vertices to exercise both the lanes and the remainder
+    for (int i = 0; i < 11; i++)
+    {
+        vertices.push_back(i, -i, (i * 7) % 11);
+    }
+    ASSERT_TRUE(vertices.getBounds(min, max));
+    ASSERT_EQ(min, Vector3D(0, -10, 0));
+    ASSERT_EQ(max, Vector3D(10, 0, 10));
+    ASSERT_EQ(vertices.getCentroid(), Vector3D(5, -5, 5));
+}
+
+TEST(transformTest, vertexArrayBase) {
+    VertexArray vertices;
+    vertices.push_back(1, 2, 3);
+    vertices.push_back(-1, 0, 2);
+
+    vertices.translate(Vector3D(1, 1, 1));
+    ASSERT_EQ(vertices.get(0), Vector3D(2, 3, 4));
+
+    vertices.scale(2);
+    ASSERT_EQ(vertices.get(1), Vector3D(0, 2, 6));
+
+    // Rotation by 90 degrees about z, then a shift along x
+    double rotation[9] = {0, -1, 0, 1, 0, 0, 0, 0, 1};
+    vertices.transform(rotation, Vector3D(10, 0, 0));
+    ASSERT_EQ(vertices.get(0), Vector3D(4, 4, 8));
+    ASSERT_EQ(vertices.get(1), Vector3D(8, 0, 6));
+}
+
+TEST(transformTest, vertexArraySingle) {
+    BasicVertexArray<float> vertices;
+    vertices.push_back(16777216, 0, 0);
+    vertices.push_back(33554430, 0, 0);
+
+    // The offset is added in double: rounded to float first, it would be 1
+    // and 2^24 + 1 would round to even, leaving 2^24 unchanged
+    vertices.translate(Vector3D(1 + std::ldexp(1.0, -25), 0, 0));
+    ASSERT_EQ(vertices.get(0).getX(), 16777218);
+
+    // So is the factor multiplied: rounded to float first, it would be 1
+    vertices.scale(1 + std::ldexp(1.0, -24) - std::ldexp(1.0, -40));
+    ASSERT_EQ(vertices.get(1).getX(), 33554432);
+}
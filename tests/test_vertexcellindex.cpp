@@ -0,0 +1,147 @@
+/**
+ * @file test_vertexcellindex.cpp
+ * @brief Unit tests for the VertexCellIndex class and the parallel prefix sum
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "cellstore.h"
+#include "model.h"
+#include "parallel.h"
+#include "vertexcellindex.h"
+
+TEST(scanTest, parallelExclusiveScan) {
+    std::vector<int> reference(1001);
+    for (int i = 0; i < reference.size(); i++)
+    {
+        reference[i] = (i * 7) % 5;
+    }
+    std::vector<int> expected(reference.size());
+    int total = 0;
+    for (int i = 0; i < reference.size(); i++)
+    {
+        expected[i] = total;
+        total += reference[i];
+    }
+
+    for (int threadCount : {1, 2, 3, 16, 2000})
+    {
+        std::vector<int> values = reference;
+        ASSERT_EQ(parallelExclusiveScan(values.data(), values.size(), threadCount), total);
+        ASSERT_EQ(values, expected) << threadCount;
+    }
+    ASSERT_EQ(parallelExclusiveScan<int>(nullptr, 0, 4), 0);
+}
+
+TEST(mixedTest, vertexCellIndex) {
+    // Hexahedron, pyramid on its top face, a tetrahedron that repeats a
+    // vertex, and an unused ID
+    CellStore cells;
+    int hexahedron[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    int pyramid[5] = {4, 5, 6, 7, 8};
+    int collapsed[4] = {8, 5, 5, 9};
+    cells.add(2, 'h', 0, hexahedron);
+    cells.add(0, 'p', 0, pyramid);
+    cells.add(3, 't', 0, collapsed);
+
+    VertexCellIndex index = buildVertexCellIndex(cells, 11, 2);
+    ASSERT_EQ(index.getVertexCount(), 11);
+    ASSERT_EQ(index.getEntryCount(), 8 + 5 + 3);
+    ASSERT_EQ(std::vector<int>(index.getCells(0).begin(), index.getCells(0).end()), std::vector<int>({2}));
+    ASSERT_EQ(std::vector<int>(index.getCells(5).begin(), index.getCells(5).end()), std::vector<int>({0, 2, 3}));
+    ASSERT_EQ(std::vector<int>(index.getCells(8).begin(), index.getCells(8).end()), std::vector<int>({0, 3}));
+    ASSERT_EQ(index.getCellCount(9), 1);
+    ASSERT_EQ(index.getCellCount(10), 0);
+    ASSERT_TRUE(index.getCells(10).empty());
+}
+
+TEST(threadTest, vertexCellIndex) {
+    // Shared vertices written by several threads at once
+    CellStore cells;
+    int n = 40;
+    for (int id = 0; id < n * n; id++)
+    {
+        int vertexIds[4] = {id % n, (id / n) % n, n + id % 7, n + 7 + id};
+        cells.add(id, 't', 0, vertexIds);
+    }
+    int vertexCount = 2 * n + 7 + n * n;
+    VertexCellIndex reference = buildVertexCellIndex(cells, vertexCount, 1);
+    ASSERT_EQ(reference.getCellCount(0), 2 * n - 1);
+    ASSERT_EQ(reference.getCellCount(n + 3), (n * n + 3) / 7);
+
+    for (int threadCount : {2, 5, 8, 0})
+    {
+        VertexCellIndex index = buildVertexCellIndex(cells, vertexCount, threadCount);
+        ASSERT_EQ(index.getOffsets(), reference.getOffsets()) << threadCount;
+        ASSERT_EQ(index.getEntries(), reference.getEntries()) << threadCount;
+    }
+}
+
+TEST(modelTest, vertexCellIndex) {
+    Model model("tests/ExampleModel.mod");
+    const VertexCellIndex &index = model.getVertexCellIndex();
+    ASSERT_EQ(index.getVertexCount(), model.getVertexCount());
+
+    // Same as a scan over every cell
+    std::vector<std::vector<int>> expected(model.getVertexCount());
+    for (CellView cell : model.getCellView())
+    {
+        for (int vertexId : cell.getVertexIds())
+        {
+            std::vector<int> &row = expected[vertexId];
+            if (row.empty() || row.back() != cell.getId())
+            {
+                row.push_back(cell.getId());
+            }
+        }
+    }
+    for (int v = 0; v < model.getVertexCount(); v++)
+    {
+        ArrayView<int> cells = model.getVertexCells(v);
+        ASSERT_EQ(std::vector<int>(cells.begin(), cells.end()), expected[v]) << v;
+    }
+
+    // Built once, whichever thread asks first
+    std::vector<const VertexCellIndex *> built(4);
+    Model other("tests/ExampleModel.mod");
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&, i]() { built[i] = &other.getVertexCellIndex(); });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(std::count(built.begin(), built.end(), built[0]), 4);
+    ASSERT_EQ(built[0]->getEntries(), index.getEntries());
+}
+
+TEST(copyTest, vertexCellIndex) {
+    static_assert(std::is_copy_constructible<Model>::value && std::is_copy_assignable<Model>::value,
+                  "Model must stay copyable");
+    static_assert(std::is_move_constructible<Model>::value && std::is_move_assignable<Model>::value,
+                  "Model must stay movable");
+
+    Model model("tests/ExampleModel.mod");
+    const VertexCellIndex &index = model.getVertexCellIndex();
+
+    // A copy builds its own index, equal to the original's
+    Model copy(model);
+    ASSERT_NE(&copy.getVertexCellIndex(), &index);
+    ASSERT_EQ(copy.getVertexCellIndex().getEntries(), index.getEntries());
+
+    // A move takes the built index along
+    Model moved(std::move(model));
+    ASSERT_EQ(&moved.getVertexCellIndex(), &index);
+
+    copy = moved;
+    ASSERT_NE(&copy.getVertexCellIndex(), &index);
+    ASSERT_EQ(copy.getVertexCellIndex().getOffsets(), index.getOffsets());
+}
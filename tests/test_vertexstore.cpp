@@ -0,0 +1,80 @@
+/**
+ * @file test_vertexstore.cpp
+ * @brief Unit tests for the VertexStore class and single-precision models
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+#include "model.h"
+#include "vertexstore.h"
+
+TEST(storeTest, vertexStoreBase) {
+    VertexStore doubles(nullptr, Precision::Double);
+    VertexStore singles(nullptr, Precision::Single);
+    for (int i = 0; i < 10; i++)
+    {
+        doubles.push_back(i, 2 * i, 0.1 * i);
+        singles.push_back(i, 2 * i, 0.1 * i);
+    }
+
+    ASSERT_EQ(singles.getPrecision(), Precision::Single);
+    ASSERT_EQ(singles.size(), 10);
+    ASSERT_TRUE(singles.getSingleArray() != nullptr);
+    ASSERT_TRUE(singles.getDoubleArray() == nullptr);
+    ASSERT_EQ(singles.get(3).getY(), 6);
+    ASSERT_FLOAT_EQ(singles.get(3).getZ(), 0.3);
+
+    // Single columns take half the memory
+    ASSERT_EQ(2 * singles.getMemorySize(), doubles.getMemorySize());
+
+    Vector3D min, max;
+    ASSERT_TRUE(singles.getBounds(min, max));
+    ASSERT_EQ(min, Vector3D(0, 0, 0));
+    ASSERT_EQ(max.getY(), 18);
+    ASSERT_NEAR(singles.getCentroid().getZ(), doubles.getCentroid().getZ(), 1e-7);
+
+    singles.translate(Vector3D(1, 0, 0));
+    ASSERT_EQ(singles.get(0).getX(), 1);
+}
+
+TEST(precisionModelTest, vertexStoreBase) {
+    Model doubles("tests/ExampleModel.mod", 1, nullptr, Precision::Double);
+    Model singles("tests/ExampleModel.mod", 1, nullptr, Precision::Single);
+    ASSERT_EQ(singles.getPrecision(), Precision::Single);
+    ASSERT_EQ(singles.getVertexCount(), doubles.getVertexCount());
+    ASSERT_EQ(2 * singles.getVertexStore().getMemorySize(), doubles.getVertexStore().getMemorySize());
+
+    // Results agree to float precision
+    std::vector<double> doubleVolumes = doubles.getCellVolumes();
+    std::vector<double> singleVolumes = singles.getCellVolumes();
+    ASSERT_EQ(singleVolumes.size(), doubleVolumes.size());
+    for (int i = 0; i < doubleVolumes.size(); i++)
+    {
+        ASSERT_NEAR(singleVolumes[i], doubleVolumes[i], 1e-5 * (1 + doubleVolumes[i]));
+    }
+
+    std::vector<Vector3D> doubleCentres = doubles.getCellCentres();
+    std::vector<Vector3D> singleCentres = singles.getCellCentres();
+    for (int i = 0; i < doubleCentres.size(); i++)
+    {
+        ASSERT_NEAR(singleCentres[i].getX(), doubleCentres[i].getX(), 1e-5);
+        ASSERT_NEAR(singleCentres[i].getY(), doubleCentres[i].getY(), 1e-5);
+        ASSERT_NEAR(singleCentres[i].getZ(), doubleCentres[i].getZ(), 1e-5);
+    }
+
+    // Binary files store doubles whatever the precision in memory
+    ASSERT_TRUE(singles.saveBinary("ExampleModelSingle.modb"));
+    Model reloaded("ExampleModelSingle.modb");
+    ASSERT_EQ(reloaded.getPrecision(), Precision::Double);
+    ASSERT_EQ(reloaded.getVertexCount(), singles.getVertexCount());
+    for (int i = 0; i < reloaded.getVertexCount(); i++)
+    {
+        ASSERT_EQ(reloaded.getVertexStore().get(i), singles.getVertexStore().get(i));
+    }
+
+    std::remove("ExampleModelSingle.modb");
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_views.cpp
+ * @brief Unit tests for the non-owning view accessors of Model and Cell
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <thread>
+#include <vector>
+#include "cellview.h"
+#include "model.h"
+
+// Count every heap allocation made by the test program
+static std::atomic<long> allocationCount(0);
+
+void *operator new(std::size_t size)
+{
+    allocationCount++;
+    void *pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// Helper that writes an n x n x n grid of hexahedra made of two materials,
+// with cell ID 1 missing
+static void writeGridModel(const char *filename, int n)
+{
+    std::ofstream out(filename);
+    out << "m 0 8940 b87333 cu\nm 1 2700 d0d5db al\n";
+
+    int side = n + 1;
+    for (int k = 0; k < side; k++)
+        for (int j = 0; j < side; j++)
+            for (int i = 0; i < side; i++)
+                out << "v " << (k * side + j) * side + i << " " << i << " " << j << " " << k << "\n";
+
+    int id = 0;
+    for (int k = 0; k < n; k++)
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i < n; i++, id++)
+            {
+                if (id == 1)
+                {
+                    continue;
+                }
+                int v0 = (k * side + j) * side + i;
+                int v3 = v0 + side;
+                int v4 = v0 + side * side;
+                int v7 = v3 + side * side;
+                out << "c " << id << " h " << id % 2 << " " << v0 << " " << v0 + 1 << " " << v3 + 1 << " " << v3
+                    << " " << v4 << " " << v4 + 1 << " " << v7 + 1 << " " << v7 << "\n";
+            }
+}
+
+// Read the whole model through views, returning a checksum
+static double readThroughViews(const Model &mod)
+{
+    double sum = 0;
+    for (CellView cell : mod.getCellView())
+    {
+        for (int vertexId : cell.getVertexIds())
+        {
+            sum += vertexId;
+        }
+        sum += cell.getVertex(0).getX() + cell.getCentre().getZ();
+        sum += cell.getMaterial().getDensity() + cell.getMass();
+    }
+    for (const Material &material : mod.getMaterialView())
+    {
+        sum += material.getId();
+    }
+    const VertexStore &vertices = mod.getVertexStore();
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        sum += vertices.get(i).getY();
+    }
+    return sum;
+}
+
+TEST(cellViewTest, viewBase) {
+    writeGridModel("GridModel.mod", 3);
+    Model mod("GridModel.mod");
+    std::vector<Cell> cells = mod.getCells();
+
+    int visited = 0;
+    for (CellView cell : mod.getCellView())
+    {
+        Cell &copy = cells[cell.getId()];
+        ASSERT_EQ(cell.getType(), copy.getType());
+        ASSERT_EQ(std::vector<int>(cell.getVertexIds().begin(), cell.getVertexIds().end()), copy.getVertexIds());
+        ASSERT_EQ(cell.getMaterial(), copy.getMaterial());
+        ASSERT_EQ(cell.getMass(), copy.getMass());
+        ASSERT_EQ(cell.getCentre(), copy.getCentre());
+        ASSERT_EQ(copy.getMaterialView(), copy.getMaterial());
+        ASSERT_EQ(copy.getVertexIdView()[7], copy.getVertexIds()[7]);
+        visited++;
+    }
+
+    // The missing cell ID takes no storage
+    ASSERT_EQ(visited, 26);
+    ASSERT_EQ(mod.getCellCount(), 26);
+    ASSERT_EQ(mod.getCellIdMap().getId(1), 2);
+    ASSERT_EQ(mod.getMaterialView().size(), 2);
+    ASSERT_EQ(mod.getMaterialView()[1].getName(), "al");
+
+    std::remove("GridModel.mod");
+}
+
+TEST(allocationTest, viewBase) {
+    writeGridModel("GridModel.mod", 10);
+    Model mod("GridModel.mod");
+
+    long before = allocationCount;
+    double sum = readThroughViews(mod);
+    long after = allocationCount;
+
+    ASSERT_GT(sum, 0);
+    ASSERT_EQ(after - before, 0);
+
+    // The copying accessors do allocate, so the counter is live
+    before = allocationCount;
+    std::vector<Cell> cells = mod.getCells();
+    ASSERT_GT(allocationCount - before, 0);
+
+    std::remove("GridModel.mod");
+}
+
+TEST(concurrentReadTest, viewBase) {
+    writeGridModel("GridModel.mod", 10);
+    const Model mod("GridModel.mod");
+    double expected = readThroughViews(mod);
+
+    std::vector<double> sums(4);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < sums.size(); i++)
+    {
+        threads.push_back(std::thread([&, i]() { sums[i] = readThroughViews(mod); }));
+    }
+    for (int i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+
+    for (int i = 0; i < sums.size(); i++)
+    {
+        ASSERT_EQ(sums[i], expected);
+    }
+
+    std::remove("GridModel.mod");
+}
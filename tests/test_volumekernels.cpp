@@ -0,0 +1,196 @@
+/**
+ * @file test_volumekernels.cpp
+ * @brief Unit tests for the hexahedron and pyramid volumes and the batch kernels
+ * @author 13CAD team
+ * @version 1.0 16/10/26
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "cell.h"
+#include "simd.h"
+#include "vector3d.h"
+#include "volumekernels.h"
+
+// Corners of the unit cube in .mod order
+static const double UNIT_CUBE[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                       {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+
+// Faces of a hexahedron, counter-clockwise seen from outside
+static const int FACES[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+                                {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+
+// Volume as the sum of 24 tetrahedra, each face split into four
+// triangles about its centroid and joined to the cell centroid
+static double decompositionVolume(const Vector3D *corners)
+{
+    Vector3D vertices[8];
+    for (int i = 0; i < 8; i++)
+    {
+        vertices[i] = corners[i];
+    }
+
+    Vector3D centre;
+    for (int i = 0; i < 8; i++)
+    {
+        centre = centre + 0.125 * vertices[i];
+    }
+
+    double volume = 0;
+    for (int face = 0; face < 6; face++)
+    {
+        const int *face4 = FACES[face];
+        Vector3D faceCentre = 0.25 * (vertices[face4[0]] + vertices[face4[1]] +
+                                      vertices[face4[2]] + vertices[face4[3]]);
+        for (int k = 0; k < 4; k++)
+        {
+            Vector3D tetrahedron[4] = {centre, vertices[face4[k]], vertices[face4[(k + 1) % 4]], faceCentre};
+            volume += Tetrahedron::computeVolume(tetrahedron);
+        }
+    }
+    return volume;
+}
+
+// Hexahedron from the unit cube through a function of each corner
+template <class Function>
+static std::vector<Vector3D> makeHexahedron(Function function)
+{
+    std::vector<Vector3D> vertices;
+    for (int i = 0; i < 8; i++)
+    {
+        vertices.push_back(function(UNIT_CUBE[i][0], UNIT_CUBE[i][1], UNIT_CUBE[i][2]));
+    }
+    return vertices;
+}
+
+TEST(boxTest, hexahedronVolume) {
+    std::vector<Vector3D> box = makeHexahedron([](double x, double y, double z) {
+        return Vector3D(2 * x, 3 * y, 0.5 * z);
+    });
+    ASSERT_NEAR(Hexahedron::computeVolume(box.data()), 3, 1e-14);
+
+    // Reversed orientation gives a negative volume
+    std::swap(box[1], box[3]);
+    std::swap(box[5], box[7]);
+    ASSERT_NEAR(Hexahedron::computeVolume(box.data()), -3, 1e-14);
+}
+
+TEST(skewTest, hexahedronVolume) {
+    // Parallelepiped: volume is the determinant of its edges
+    std::vector<Vector3D> skewed = makeHexahedron([](double x, double y, double z) {
+        return Vector3D(x + 0.7 * y + 0.2 * z, 1.5 * y - 0.4 * z, 0.3 * x + 2 * z);
+    });
+    double determinant = 1 * (1.5 * 2 - (-0.4) * 0) - 0.7 * (0 * 2 - (-0.4) * 0.3) + 0.2 * (0 * 0 - 1.5 * 0.3);
+    ASSERT_NEAR(Hexahedron::computeVolume(skewed.data()), determinant, 1e-14);
+    ASSERT_NEAR(decompositionVolume(skewed.data()), determinant, 1e-14);
+}
+
+TEST(twistTest, hexahedronVolume) {
+    // Top face rotated about the vertical axis, so the side faces are not planar
+    for (double angle = 0; angle < 1.5; angle += 0.25)
+    {
+        std::vector<Vector3D> twisted = makeHexahedron([angle](double x, double y, double z) {
+            double c = std::cos(angle * z);
+            double s = std::sin(angle * z);
+            return Vector3D(c * (x - 0.5) - s * (y - 0.5), s * (x - 0.5) + c * (y - 0.5), z);
+        });
+        double volume = Hexahedron::computeVolume(twisted.data());
+        ASSERT_NEAR(volume, decompositionVolume(twisted.data()), 1e-14);
+
+        // Straight edges between the twisted corners cut into the cube
+        ASSERT_LE(volume, 1 + 1e-14);
+    }
+}
+
+TEST(distortedTest, hexahedronVolume) {
+    std::srand(7);
+    for (int test = 0; test < 100; test++)
+    {
+        std::vector<Vector3D> distorted = makeHexahedron([](double x, double y, double z) {
+            double dx = 0.3 * (std::rand() / (double)RAND_MAX - 0.5);
+            double dy = 0.3 * (std::rand() / (double)RAND_MAX - 0.5);
+            double dz = 0.3 * (std::rand() / (double)RAND_MAX - 0.5);
+            return Vector3D(x + dx, y + dy, z + dz);
+        });
+        ASSERT_NEAR(Hexahedron::computeVolume(distorted.data()), decompositionVolume(distorted.data()), 1e-13);
+    }
+}
+
+TEST(pyramidTest, hexahedronVolume) {
+    // Parallelogram base of area 6 and height 2, apex off-centre
+    Vector3D vertices[5] = {Vector3D(0, 0, 0), Vector3D(3, 0, 0), Vector3D(4, 2, 0), Vector3D(1, 2, 0),
+                            Vector3D(5, -1, 2)};
+    ASSERT_NEAR(Pyramid::computeVolume(vertices), 4, 1e-14);
+
+    // A pyramid on a hexahedron face is a sixth of the cube when the apex is its centre
+    Vector3D cube[5] = {Vector3D(0, 0, 0), Vector3D(1, 0, 0), Vector3D(1, 1, 0), Vector3D(0, 1, 0),
+                        Vector3D(0.5, 0.5, 0.5)};
+    ASSERT_NEAR(Pyramid::computeVolume(cube), 1.0 / 6, 1e-14);
+
+    // Non-planar base: the two halves of a hexahedron split through its centroid
+    std::vector<Vector3D> hexahedron = makeHexahedron([](double x, double y, double z) {
+        return Vector3D(x, y, z + 0.3 * x * y);
+    });
+    Vector3D centre;
+    for (int i = 0; i < 8; i++)
+    {
+        centre = centre + 0.125 * hexahedron[i];
+    }
+    double sum = 0;
+    for (int face = 0; face < 6; face++)
+    {
+        Vector3D pyramid[5] = {hexahedron[FACES[face][0]], hexahedron[FACES[face][3]], hexahedron[FACES[face][2]],
+                               hexahedron[FACES[face][1]], centre};
+        sum += Pyramid::computeVolume(pyramid);
+    }
+    ASSERT_NEAR(sum, Hexahedron::computeVolume(hexahedron.data()), 1e-14);
+}
+
+TEST(levelTest, hexahedronVolume) {
+    // Random distorted hexahedra sharing vertices, a count that leaves a tail
+    const int count = 1003;
+    std::srand(11);
+    std::vector<double> x, y, z;
+    std::vector<float> xf, yf, zf;
+    for (int i = 0; i < 4 * count; i++)
+    {
+        x.push_back(std::rand() / (double)RAND_MAX);
+        y.push_back(std::rand() / (double)RAND_MAX);
+        z.push_back(std::rand() / (double)RAND_MAX);
+        xf.push_back((float)x.back());
+        yf.push_back((float)y.back());
+        zf.push_back((float)z.back());
+    }
+    std::vector<int> vertexIds;
+    for (int i = 0; i < 8 * count; i++)
+    {
+        vertexIds.push_back(std::rand() % x.size());
+    }
+
+    std::vector<double> reference(count);
+    std::vector<double> referenceFloat(count);
+    computeHexahedronVolumes(vertexIds.data(), count, x.data(), y.data(), z.data(), reference.data(), SimdLevel::Scalar);
+    computeHexahedronVolumes(vertexIds.data(), count, xf.data(), yf.data(), zf.data(), referenceFloat.data(), SimdLevel::Scalar);
+
+    // Every instruction set rounds exactly like the scalar code
+    SimdLevel levels[] = {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (SimdLevel level : levels)
+    {
+        std::vector<double> volumes(count);
+        std::vector<double> volumesFloat(count);
+        computeHexahedronVolumes(vertexIds.data(), count, x.data(), y.data(), z.data(), volumes.data(), level);
+        computeHexahedronVolumes(vertexIds.data(), count, xf.data(), yf.data(), zf.data(), volumesFloat.data(), level);
+        ASSERT_EQ(volumes, reference) << getSimdLevelName(resolveSimdLevel(level));
+        ASSERT_EQ(volumesFloat, referenceFloat) << getSimdLevelName(resolveSimdLevel(level));
+    }
+
+    Vector3D vertices[8];
+    for (int j = 0; j < 8; j++)
+    {
+        int id = vertexIds[8 * 5 + j];
+        vertices[j] = Vector3D(x[id], y[id], z[id]);
+    }
+    ASSERT_EQ(reference[5], Hexahedron::computeVolume(vertices));
+}